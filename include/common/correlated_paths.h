@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <random>
+#include <cstdint>
+
+namespace hedgefund {
+namespace common {
+
+struct AssetDynamics {
+    double spot_price;
+    double drift;       // Annualized; the risk-free rate under the pricing measure
+    double volatility;  // Annualized
+};
+
+// Lower-triangular Cholesky factor of a correlation matrix
+class CholeskyFactor {
+public:
+    // Factor an n x n correlation matrix. One that is not positive definite
+    // (e.g. assembled from pairwise estimates) is shrunk towards the identity
+    // until it is; false if the input is not square.
+    bool factorize(const std::vector<std::vector<double>>& correlation);
+
+    int numAssets() const { return num_assets_; }
+    double at(int i, int j) const { return lower_[static_cast<size_t>(i) * num_assets_ + j]; }
+    double shrinkage() const { return shrinkage_; }  // Weight put on the identity, 0 if none was needed
+
+private:
+    int num_assets_ = 0;
+    double shrinkage_ = 0.0;
+    std::vector<double> lower_;  // Row-major, zeros above the diagonal
+
+    bool tryFactorize(const std::vector<std::vector<double>>& correlation, double shrinkage);
+};
+
+// Paths for several assets over one block of paths. Storage is step-major,
+// then asset, so each (step, asset) row is num_paths contiguous prices.
+class MultiAssetPathBlock {
+public:
+    // Paths per block such that a full block stays within ~256KB of cache
+    static int blockSizeFor(int num_assets, int num_steps);
+
+    void resize(int num_assets, int num_paths, int num_steps);
+
+    int numAssets() const { return num_assets_; }
+    int numPaths() const { return num_paths_; }
+    int numSteps() const { return num_steps_; }
+    int firstPath() const { return first_path_; }  // Index of the block's first path in the whole run
+
+    double* row(int step, int asset) { return data_.data() + rowOffset(step, asset); }
+    const double* row(int step, int asset) const { return data_.data() + rowOffset(step, asset); }
+
+private:
+    friend class CorrelatedPathGenerator;
+
+    int num_assets_ = 0;
+    int num_paths_ = 0;
+    int num_steps_ = 0;
+    int first_path_ = 0;
+    std::vector<double> data_;
+
+    // Per-step scratch: independent normals per asset and one correlated row
+    std::vector<double> normals_;
+    std::vector<double> increments_;
+
+    size_t rowOffset(int step, int asset) const {
+        return (static_cast<size_t>(step) * num_assets_ + asset) * num_paths_;
+    }
+};
+
+// Correlated multi-asset GBM. The Cholesky factor is cached and only
+// recomputed when the correlation matrix changes. Each block draws from its
+// own stream seeded by (seed, block index), so results are identical for any
+// thread count.
+class CorrelatedPathGenerator {
+public:
+    explicit CorrelatedPathGenerator(unsigned int seed = std::random_device{}());
+
+    // Returns true if the factor was recomputed
+    bool setCorrelation(const std::vector<std::vector<double>>& correlation);
+    const CholeskyFactor& getFactor() const { return factor_; }
+
+    // Fill one block on the calling thread
+    void generateBlock(MultiAssetPathBlock& block, const std::vector<AssetDynamics>& assets, double time_horizon,
+                       int num_steps, int num_paths, uint64_t block_index) const;
+
+    // Simulate num_paths in blocks spread over num_threads workers (0 =
+    // hardware concurrency). The visitor runs concurrently on the workers, once
+    // per block; block.firstPath() locates the block's paths in the run.
+    using BlockVisitor = std::function<void(const MultiAssetPathBlock& block)>;
+    void simulate(const std::vector<AssetDynamics>& assets, double time_horizon, int num_steps, int num_paths,
+                  const BlockVisitor& visitor, int num_threads = 0) const;
+
+    // Simple return over the horizon of a portfolio holding the given value
+    // weights, one entry per scenario
+    std::vector<double> simulatePortfolioReturns(const std::vector<AssetDynamics>& assets,
+                                                 const std::vector<double>& weights, double time_horizon,
+                                                 int num_scenarios, int num_threads = 0) const;
+
+private:
+    unsigned int seed_;
+    std::vector<std::vector<double>> correlation_;
+    CholeskyFactor factor_;
+};
+
+} // namespace common
+} // namespace hedgefund
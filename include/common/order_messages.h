@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace hedgefund {
+namespace common {
+
+// Wire format between order senders and the order book service. A batch
+// travels as one message so a strategy tick costs one publish however many
+// orders it produced:
+//   orders.batch     ORDER_BATCH;<id>,<symbol>,<BUY|SELL>,<price>,<quantity>;...
+//   orders.ack       ORDER_ACK;<id>,<ACCEPTED|REJECTED>;...
+//   trades.executed  TRADE,<price>,<quantity>,<buy id>,<sell id>
+// Symbols may contain spaces (option contracts) but not ',' or ';'.
+
+struct OrderMessage {
+    std::string order_id;
+    std::string symbol;
+    bool buy = true;
+    double price = 0.0;  // Limit price
+    double quantity = 0.0;
+};
+
+struct OrderAck {
+    std::string order_id;
+    bool accepted = true;
+};
+
+struct TradeMessage {
+    double price = 0.0;
+    double quantity = 0.0;
+    std::string buy_order_id;
+    std::string sell_order_id;
+};
+
+std::string encodeOrderBatch(const std::vector<OrderMessage>& orders);
+std::string encodeOrderAcks(const std::vector<OrderAck>& acks);
+std::string encodeTrade(const TradeMessage& trade);
+
+// Decoders append to the output and return false on a malformed message;
+// records decoded before the error are kept. decodeOrderBatch instead
+// skips a malformed record and carries on, appending its order id, when it
+// has one, to malformed_ids so the sender can be told.
+bool decodeOrderBatch(const std::string& payload, std::vector<OrderMessage>& orders,
+                      std::vector<std::string>* malformed_ids = nullptr);
+bool decodeOrderAcks(const std::string& payload, std::vector<OrderAck>& acks);
+bool decodeTrade(const std::string& payload, TradeMessage& trade);
+
+} // namespace common
+} // namespace hedgefund
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hedgefund {
+namespace common {
+
+// Dense process-wide id for a ticker; ids count up from 0 in intern order
+using SymbolId = uint32_t;
+constexpr SymbolId INVALID_SYMBOL = UINT32_MAX;
+
+// Interns symbols to dense ids at the edges (message decode, config load) so
+// per-tick structures can be flat arrays indexed by id. Interning and lookup
+// by name take a lock; name() for a known id is lock-free.
+class SymbolRegistry {
+public:
+    static SymbolRegistry& instance();
+
+    SymbolId intern(const std::string& symbol);       // INVALID_SYMBOL once full
+    SymbolId find(const std::string& symbol) const;  // INVALID_SYMBOL if never interned
+
+    // Any id returned by intern(); the reference stays valid for the process
+    const std::string& name(SymbolId id) const;
+    size_t size() const { return size_.load(std::memory_order_acquire); }
+
+    ~SymbolRegistry();
+
+private:
+    SymbolRegistry();
+
+    static constexpr size_t CHUNK_SIZE = 4096;
+    static constexpr size_t MAX_CHUNKS = 1024;
+
+    // Names live in fixed chunks that never move, so readers need no lock
+    std::atomic<std::string*> chunks_[MAX_CHUNKS];
+    std::atomic<size_t> size_{0};
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, SymbolId> ids_;
+};
+
+// Flat array of T indexed by SymbolId with presence tracking. Not
+// synchronized; operator[] may grow the array and move existing values.
+template <typename T>
+class SymbolTable {
+public:
+    // Default-constructs the entry on first access
+    T& operator[](SymbolId id) {
+        if (id >= values_.size()) {
+            values_.resize(id + 1);
+            present_.resize(id + 1, 0);
+        }
+        if (!present_[id]) {
+            present_[id] = 1;
+            count_++;
+        }
+        return values_[id];
+    }
+
+    bool contains(SymbolId id) const { return id < present_.size() && present_[id]; }
+    T* find(SymbolId id) { return contains(id) ? &values_[id] : nullptr; }
+    const T* find(SymbolId id) const { return contains(id) ? &values_[id] : nullptr; }
+
+    void erase(SymbolId id) {
+        if (!contains(id)) return;
+        values_[id] = T();
+        present_[id] = 0;
+        count_--;
+    }
+
+    void clear() {
+        values_.clear();
+        present_.clear();
+        count_ = 0;
+    }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    // One past the largest id ever stored
+    SymbolId bound() const { return static_cast<SymbolId>(values_.size()); }
+
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) {
+        for (SymbolId id = 0; id < values_.size(); id++) {
+            if (present_[id]) visitor(id, values_[id]);
+        }
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (SymbolId id = 0; id < values_.size(); id++) {
+            if (present_[id]) visitor(id, values_[id]);
+        }
+    }
+
+private:
+    std::vector<T> values_;
+    std::vector<uint8_t> present_;
+    size_t count_ = 0;
+};
+
+} // namespace common
+} // namespace hedgefund
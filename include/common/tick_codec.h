@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "tick_codec reads fields in place and assumes a little-endian host"
+#endif
+
+namespace hedgefund {
+namespace common {
+
+// Fixed-layout binary ticks for market.data and options.data. One message
+// holds one or more records back to back, and readers load each field
+// straight out of the payload at a fixed offset.
+// The text formats remain accepted as a debug fallback.
+//
+// Every record is little-endian and starts with a 32-byte header:
+//   0  uint8    magic (0xB7, never a printable character)
+//   1  uint8    version
+//   2  uint8    TickKind
+//   3  uint8    reserved
+//   4  uint32   record length in bytes
+//   8  int64    exchange timestamp, ns since epoch (0 if unknown)
+//   16 char[16] symbol or underlying, NUL padded
+// followed by doubles at 8-byte offsets; see the *_OFFSET constants.
+namespace tick {
+
+constexpr uint8_t MAGIC = 0xB7;
+constexpr uint8_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 32;
+constexpr size_t SYMBOL_OFFSET = 16;
+constexpr size_t SYMBOL_SIZE = 16;
+
+// QUOTE: price, volume, bid, ask, high, low, change_percent
+constexpr size_t PRICE_OFFSET = 32, VOLUME_OFFSET = 40, BID_OFFSET = 48, ASK_OFFSET = 56;
+constexpr size_t HIGH_OFFSET = 64, LOW_OFFSET = 72, CHANGE_PERCENT_OFFSET = 80;
+constexpr size_t QUOTE_SIZE = 88;
+
+// OPTION_QUOTE: strike, price, implied vol, delta, int32 expiry YYYYMMDD, uint8 is_call
+constexpr size_t STRIKE_OFFSET = 32, OPTION_PRICE_OFFSET = 40, IMPLIED_VOL_OFFSET = 48, DELTA_OFFSET = 56;
+constexpr size_t EXPIRY_OFFSET = 64, IS_CALL_OFFSET = 68;
+constexpr size_t OPTION_QUOTE_SIZE = 72;
+
+} // namespace tick
+
+enum class TickKind : uint8_t {
+    QUOTE = 1,
+    OPTION_QUOTE = 3  // 2 was published indicators; left unused
+};
+
+struct QuoteFields {
+    double price = 0.0;
+    double volume = 0.0;
+    double bid = 0.0;
+    double ask = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double change_percent = 0.0;
+};
+
+struct OptionQuoteFields {
+    double strike_price = 0.0;
+    double price = 0.0;
+    double implied_vol = 0.0;
+    double delta = 0.0;
+    int32_t expiry = 0;  // YYYYMMDD
+    bool is_call = true;
+};
+
+// Encoders append one record to out, so several can share a message.
+// Symbols longer than 16 bytes are truncated.
+void appendQuote(std::string& out, const std::string& symbol, const QuoteFields& fields, int64_t timestamp_ns = 0);
+void appendOptionQuote(std::string& out, const std::string& underlying, const OptionQuoteFields& fields,
+                       int64_t timestamp_ns = 0);
+
+// YYYY-MM-DD <-> YYYYMMDD; 0 for dates that do not parse
+int32_t packExpiry(const std::string& expiration_date);
+std::string formatExpiry(int32_t expiry);
+
+inline bool isBinaryTick(const std::string& payload) {
+    return !payload.empty() && static_cast<uint8_t>(payload[0]) == tick::MAGIC;
+}
+
+// Walks the records of a binary payload without copying it. The payload
+// must outlive the reader.
+//   TickReader reader(msg.payload);
+//   while (reader.next()) { if (reader.kind() == TickKind::QUOTE) ... }
+class TickReader {
+public:
+    explicit TickReader(const std::string& payload) : data_(payload.data()), size_(payload.size()) {}
+    TickReader(const char* data, size_t size) : data_(data), size_(size) {}
+    
+    // Moves to the next record; false at the end or at a record that is
+    // truncated, has another version or is too short for its kind
+    bool next();
+    bool malformed() const { return malformed_; }
+    
+    TickKind kind() const { return static_cast<TickKind>(record_[2]); }
+    int64_t timestamp() const { return load<int64_t>(8); }
+    const char* symbol() const { return record_ + tick::SYMBOL_OFFSET; }
+    size_t symbolLength() const { return strnlen(symbol(), tick::SYMBOL_SIZE); }
+    
+    // Quote
+    double price() const { return load<double>(tick::PRICE_OFFSET); }
+    double volume() const { return load<double>(tick::VOLUME_OFFSET); }
+    double bid() const { return load<double>(tick::BID_OFFSET); }
+    double ask() const { return load<double>(tick::ASK_OFFSET); }
+    double high() const { return load<double>(tick::HIGH_OFFSET); }
+    double low() const { return load<double>(tick::LOW_OFFSET); }
+    double changePercent() const { return load<double>(tick::CHANGE_PERCENT_OFFSET); }
+    
+    // Option quote
+    double strike() const { return load<double>(tick::STRIKE_OFFSET); }
+    double optionPrice() const { return load<double>(tick::OPTION_PRICE_OFFSET); }
+    double impliedVol() const { return load<double>(tick::IMPLIED_VOL_OFFSET); }
+    double delta() const { return load<double>(tick::DELTA_OFFSET); }
+    int32_t expiry() const { return load<int32_t>(tick::EXPIRY_OFFSET); }
+    bool isCall() const { return record_[tick::IS_CALL_OFFSET] != 0; }
+    
+private:
+    const char* data_;
+    size_t size_;
+    size_t offset_ = 0;
+    const char* record_ = nullptr;
+    bool malformed_ = false;
+    
+    // memcpy keeps unaligned payloads legal; it compiles to a single load
+    template <typename T>
+    T load(size_t offset) const {
+        T value;
+        std::memcpy(&value, record_ + offset, sizeof(T));
+        return value;
+    }
+};
+
+} // namespace common
+} // namespace hedgefund
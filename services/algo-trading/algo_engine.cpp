@@ -1,4 +1,7 @@
 #include "algo_engine.h"
+#include "position_book.h"
+#include "order_manager.h"
+#include "execution_scheduler.h"
 #include <iostream>
 #include <algorithm>
 #include <cmath>
@@ -7,8 +10,10 @@
 namespace hedgefund {
 namespace algo {
 
-AlgorithmicEngine::AlgorithmicEngine() 
-    : running_(false), max_portfolio_risk_(0.02), current_portfolio_value_(1000000.0) {}
+AlgorithmicEngine::AlgorithmicEngine(int num_threads)
+    : position_book_(std::make_unique<PositionBook>()), order_manager_(std::make_unique<OrderManager>()),
+      execution_scheduler_(std::make_unique<ExecutionScheduler>()),
+      running_(false), max_portfolio_risk_(0.02), current_portfolio_value_(1000000.0), pool_(num_threads) {}
 
 AlgorithmicEngine::~AlgorithmicEngine() {
     stop();
@@ -29,58 +34,94 @@ void AlgorithmicEngine::run() {
     running_ = true;
     std::cout << "Algorithmic Trading Engine started" << std::endl;
     
+    // Strategies only run when a tick arrives for one of their symbols; the
+    // wait timeout drives the once-a-second risk report
+    auto next_risk_update = std::chrono::steady_clock::now() + std::chrono::seconds(1);
     while (running_) {
-        // Process market data and generate signals
-        for (auto& strategy : strategies_) {
-            if (!strategy->getConfig().enabled) continue;
-            
-            std::vector<MarketData> relevant_data;
-            for (const auto& symbol : strategy->getConfig().symbols) {
-                auto it = latest_market_data_.find(symbol);
-                if (it != latest_market_data_.end()) {
-                    relevant_data.push_back(it->second);
-                }
-            }
-            
-            if (!relevant_data.empty()) {
-                auto signals = strategy->generateSignals(relevant_data);
-                for (const auto& signal : signals) {
-                    processSignal(signal);
-                }
-            }
+        {
+            std::unique_lock<std::mutex> lock(tick_mutex_);
+            // Parents being worked wake the loop when their next slice is due
+            auto wake = std::min(next_risk_update, execution_scheduler_->nextWakeup());
+            tick_ready_.wait_until(lock, wake, [this]() {
+                return !pending_ticks_.empty() || events_ready_ || !running_;
+            });
+            draining_ticks_.swap(pending_ticks_);
+            events_ready_ = false;
+        }
+        
+        for (const auto& tick : draining_ticks_) {
+            dispatchTick(tick);
         }
+        draining_ticks_.clear();
         
-        updatePositions();
-        updateRiskMetrics();
+        // Orders from this pass leave as one batch; an in-process gateway
+        // reports straight back, so its acks and fills are applied right away
+        drainSignals();
+        releaseChildOrders();
+        order_manager_->flush();
+        drainExecutions();
+        for (const ManagedOrder* order : order_manager_->expireUnacknowledged(std::chrono::system_clock::now())) {
+            std::cout << "Order expired without ack: " << order->id << " " << order->instrument << std::endl;
+        }
         
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        if (std::chrono::steady_clock::now() >= next_risk_update) {
+            updateRiskMetrics();
+            next_risk_update += std::chrono::seconds(1);
+        }
     }
 }
 
 void AlgorithmicEngine::stop() {
-    running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(tick_mutex_);
+        running_ = false;
+    }
+    tick_ready_.notify_all();
     std::cout << "Algorithmic Trading Engine stopped" << std::endl;
 }
 
 void AlgorithmicEngine::addStrategy(std::unique_ptr<TradingStrategy> strategy) {
     std::cout << "Adding strategy: " << strategy->getConfig().name << std::endl;
-    strategies_.push_back(std::move(strategy));
+    strategy->attachPriceHistory(&price_history_);
+    std::lock_guard<std::mutex> lock(strategies_mutex_);
+    auto strand = std::make_shared<StrategyStrand>(std::move(strategy));
+    auto execution = std::make_shared<ExecutionParams>(ExecutionParams::fromConfig(strand->strategy->getConfig()));
+    if (execution->algo != ExecutionAlgo::IMMEDIATE) strand->execution = std::move(execution);
+    strategies_.push_back(std::move(strand));
+    rebuildSymbolIndex();
 }
 
 void AlgorithmicEngine::removeStrategy(const std::string& strategy_id) {
+    std::lock_guard<std::mutex> lock(strategies_mutex_);
     strategies_.erase(
         std::remove_if(strategies_.begin(), strategies_.end(),
-            [&strategy_id](const auto& strategy) {
-                return strategy->getConfig().name == strategy_id;
+            [&strategy_id](const auto& strand) {
+                return strand->strategy->getConfig().name == strategy_id;
             }),
         strategies_.end()
     );
+    rebuildSymbolIndex();
+}
+
+void AlgorithmicEngine::rebuildSymbolIndex() {
+    symbol_index_.clear();
+    for (const auto& strand : strategies_) {
+        for (const auto& symbol : strand->strategy->getConfig().symbols) {
+            common::SymbolId symbol_id = common::SymbolRegistry::instance().intern(symbol);
+            if (symbol_id == common::INVALID_SYMBOL) continue;
+            auto& subscribers = symbol_index_[symbol_id];
+            if (std::find(subscribers.begin(), subscribers.end(), strand) == subscribers.end()) {
+                subscribers.push_back(strand);
+            }
+        }
+    }
 }
 
 void AlgorithmicEngine::enableStrategy(const std::string& strategy_id, bool enabled) {
-    for (auto& strategy : strategies_) {
-        if (strategy->getConfig().name == strategy_id) {
-            const_cast<StrategyConfig&>(strategy->getConfig()).enabled = enabled;
+    std::lock_guard<std::mutex> lock(strategies_mutex_);
+    for (auto& strand : strategies_) {
+        if (strand->strategy->getConfig().name == strategy_id) {
+            const_cast<StrategyConfig&>(strand->strategy->getConfig()).enabled = enabled;
             std::cout << "Strategy " << strategy_id << (enabled ? " enabled" : " disabled") << std::endl;
             break;
         }
@@ -88,26 +129,135 @@ void AlgorithmicEngine::enableStrategy(const std::string& strategy_id, bool enab
 }
 
 void AlgorithmicEngine::processMarketData(const MarketData& data) {
-    latest_market_data_[data.symbol] = data;
+    {
+        std::lock_guard<std::mutex> lock(tick_mutex_);
+        pending_ticks_.push_back(data);
+    }
+    tick_ready_.notify_one();
+}
+
+void AlgorithmicEngine::dispatchTick(const MarketData& data) {
+    // Ticks decoded without an id get one here; everything below is indexed by it
+    common::SymbolId symbol_id = data.symbol_id != common::INVALID_SYMBOL
+                                     ? data.symbol_id : common::SymbolRegistry::instance().intern(data.symbol);
+    if (symbol_id == common::INVALID_SYMBOL) return;
     
-    // Calculate technical indicators (simplified)
-    MarketData& updated_data = latest_market_data_[data.symbol];
+    if (data.price <= 0.0) return;
     
-    // Simple moving averages (would need historical data in real implementation)
-    updated_data.sma_20 = data.price; // Simplified
-    updated_data.sma_50 = data.price; // Simplified
+    MarketData& updated_data = latest_market_data_[symbol_id];
+    updated_data = data;
+    updated_data.symbol_id = symbol_id;
     
-    // RSI calculation (simplified)
-    updated_data.rsi = 50.0; // Neutral RSI
+    if (PriceSeries* series = price_history_.ensure(symbol_id)) {
+        updated_data.sequence = series->append(data.price, data.timestamp);
+    }
+    execution_scheduler_->onVolume(symbol_id, data.volume);  // Drives POV parents
     
-    // Bollinger Bands (simplified)
-    double volatility = data.price * 0.02; // 2% volatility assumption
-    updated_data.bollinger_upper = data.price + (2 * volatility);
-    updated_data.bollinger_lower = data.price - (2 * volatility);
+    // Indicators are computed here only, from the same IndicatorSet the
+    // backtester uses; whatever the tick carried is overwritten. Ticks quote
+    // session volume, so VWAP is weighted by the increase since the last tick.
+    // The first tick, and the first after the feed resets its count, only set
+    // the baseline: the volume they report traded at prices never seen here.
+    double traded = 0.0;
+    if (double* session_volume = session_volume_.find(symbol_id)) {
+        if (data.volume >= *session_volume) traded = data.volume - *session_volume;
+        *session_volume = data.volume;
+    } else {
+        session_volume_[symbol_id] = data.volume;
+    }
     
-    // MACD (simplified)
-    updated_data.macd = 0.0;
-    updated_data.macd_signal = 0.0;
+    auto& indicators = indicators_[symbol_id];
+    indicators.update(data.price, data.price, data.price, traded, data.timestamp);
+    IndicatorSnapshot snapshot = indicators.snapshot();
+    updated_data.sma_20 = snapshot.sma_20;
+    updated_data.sma_50 = snapshot.sma_50;
+    updated_data.rsi = snapshot.rsi;
+    updated_data.bollinger_upper = snapshot.bollinger_upper;
+    updated_data.bollinger_lower = snapshot.bollinger_lower;
+    updated_data.macd = snapshot.macd;
+    updated_data.macd_signal = snapshot.macd_signal;
+    
+    position_book_->markPrice(symbol_id, data.price);
+    
+    std::lock_guard<std::mutex> lock(strategies_mutex_);
+    auto* subscribers = symbol_index_.find(symbol_id);
+    if (!subscribers) return;
+    
+    for (const auto& strand : *subscribers) {
+        if (strand->strategy->getConfig().enabled) {
+            post(strand, updated_data);
+        }
+    }
+}
+
+void AlgorithmicEngine::post(const std::shared_ptr<StrategyStrand>& strand, const MarketData& data) {
+    {
+        std::lock_guard<std::mutex> lock(strand->mutex);
+        strand->pending.push_back(data);
+        if (strand->scheduled) return;
+        strand->scheduled = true;
+    }
+    pool_.submit([this, strand]() { drainStrand(strand); });
+}
+
+void AlgorithmicEngine::drainStrand(const std::shared_ptr<StrategyStrand>& strand) {
+    {
+        std::lock_guard<std::mutex> lock(strand->mutex);
+        strand->batch.swap(strand->pending);
+    }
+    
+    // Every tick queued since the last run, evaluated in one call; signals
+    // go straight onto the queue
+    SignalSink sink([](void* engine, TradingSignal&& signal) {
+        static_cast<AlgorithmicEngine*>(engine)->signal_queue_.push(std::move(signal));
+    }, this);
+    strand->strategy->onTicks(TickSpan{strand->batch.data(), strand->batch.size()}, sink);
+    strand->batch.clear();
+    
+    if (sink.emitted() > 0) {
+        {
+            std::lock_guard<std::mutex> lock(tick_mutex_);
+            events_ready_ = true;
+        }
+        tick_ready_.notify_one();
+    }
+    
+    // Requeue rather than loop so one busy strategy cannot pin a worker
+    {
+        std::lock_guard<std::mutex> lock(strand->mutex);
+        if (strand->pending.empty()) {
+            strand->scheduled = false;
+            return;
+        }
+    }
+    pool_.submit([this, strand]() { drainStrand(strand); });
+}
+
+void AlgorithmicEngine::drainSignals() {
+    TradingSignal signal;
+    while (signal_queue_.pop(signal)) {
+        processSignal(signal);
+    }
+}
+
+void AlgorithmicEngine::setOrderGateway(std::unique_ptr<OrderGateway> gateway) {
+    order_manager_->setGateway(std::move(gateway));
+}
+
+void AlgorithmicEngine::processExecution(const ExecutionReport& report) {
+    execution_queue_.push(report);
+    {
+        std::lock_guard<std::mutex> lock(tick_mutex_);
+        events_ready_ = true;
+    }
+    tick_ready_.notify_one();
+}
+
+void AlgorithmicEngine::drainExecutions() {
+    ExecutionReport report;
+    while (execution_queue_.pop(report)) {
+        applyExecution(report);
+    }
 }
 
 void AlgorithmicEngine::processSignal(const TradingSignal& signal) {
@@ -144,88 +294,136 @@ bool AlgorithmicEngine::validateSignal(const TradingSignal& signal) {
 }
 
 void AlgorithmicEngine::executeSignal(const TradingSignal& signal) {
-    // Create or update position
-    Position position;
-    position.symbol = signal.symbol;
-    position.current_price = signal.price;
-    position.entry_time = signal.timestamp;
-    position.is_option = !signal.expiration_date.empty();
+    common::SymbolId symbol_id = common::SymbolRegistry::instance().intern(signal.symbol);
+    if (symbol_id == common::INVALID_SYMBOL) return;
     
-    if (position.is_option) {
-        position.strike_price = signal.strike_price;
-        position.expiration_date = signal.expiration_date;
-        position.is_call = signal.is_call;
-    }
+    const bool is_option = !signal.expiration_date.empty();
+    ContractKey key = is_option ? ContractKey::option(symbol_id, signal.expiration_date, signal.strike_price, signal.is_call)
+                                : ContractKey::underlying(symbol_id);
     
+    double quantity = 0.0;
     switch (signal.signal_type) {
         case SignalType::BUY:
         case SignalType::BUY_CALL:
         case SignalType::BUY_PUT:
-            position.quantity = signal.quantity;
-            position.average_price = signal.price;
+            quantity = signal.quantity;
             break;
             
         case SignalType::SELL:
         case SignalType::SELL_CALL:
         case SignalType::SELL_PUT:
-            position.quantity = -signal.quantity;
-            position.average_price = signal.price;
+            quantity = -signal.quantity;
             break;
             
-        case SignalType::CLOSE_POSITION:
-            // Find and close existing position
-            for (auto it = positions_.begin(); it != positions_.end(); ++it) {
-                if (it->symbol == signal.symbol) {
-                    std::cout << "Closing position: " << signal.symbol << std::endl;
-                    positions_.erase(it);
-                    return;
-                }
-            }
-            return;
+        case SignalType::CLOSE_POSITION: {
+            const Position* position = position_book_->find(key);
+            if (!position) return;
+            quantity = -position->quantity;
+            break;
+        }
             
         case SignalType::HOLD:
             return; // No action needed
     }
     
-    positions_.push_back(position);
-    std::cout << "Position created: " << position.symbol 
-              << " qty: " << position.quantity 
-              << " @ " << position.average_price << std::endl;
+    // Strategies with an execution algo hand the quantity to the scheduler,
+    // which releases it as child orders
+    auto execution = executionParams(signal.strategy_id);
+    if (execution && quantity != 0.0) {
+        execution_scheduler_->submit(signal, key, quantity, execution, std::chrono::steady_clock::now());
+        static const char* const algo_names[] = {"IMMEDIATE", "TWAP", "VWAP", "POV"};
+        std::cout << "Working parent: " << (quantity > 0.0 ? "BUY " : "SELL ") << std::abs(quantity) << " "
+                  << signal.symbol << " via " << algo_names[static_cast<int>(execution->algo)] << std::endl;
+        return;
+    }
+    
+    // Positions change only when the order fills
+    const ManagedOrder* order = order_manager_->submit(signal, key, quantity);
+    if (order) {
+        std::cout << "Order queued: " << order->id << " " << (order->buy ? "BUY " : "SELL ")
+                  << order->quantity << " " << order->instrument << " @ " << order->price << std::endl;
+    }
 }
 
-void AlgorithmicEngine::updatePositions() {
-    for (auto& position : positions_) {
-        auto it = latest_market_data_.find(position.symbol);
-        if (it != latest_market_data_.end()) {
-            position.current_price = it->second.price;
-            position.unrealized_pnl = (position.current_price - position.average_price) * position.quantity;
+void AlgorithmicEngine::releaseChildOrders() {
+    for (const ChildOrder& child : execution_scheduler_->advance(std::chrono::steady_clock::now())) {
+        // Underlying slices are limited at the latest price rather than the parent's
+        double limit_price = 0.0;
+        if (!child.contract.isOption()) {
+            if (const MarketData* latest = latest_market_data_.find(child.contract.symbol_id)) {
+                limit_price = latest->price;
+            }
+        }
+        
+        const ManagedOrder* order = order_manager_->submit(*child.signal, child.contract, child.quantity,
+                                                           limit_price, child.parent_id);
+        if (order) {
+            std::cout << "Child order queued: " << order->id << " " << (order->buy ? "BUY " : "SELL ")
+                      << order->quantity << " " << order->instrument << " @ " << order->price << std::endl;
         }
     }
 }
 
-void AlgorithmicEngine::updateRiskMetrics() {
-    double total_pnl = 0.0;
-    for (const auto& position : positions_) {
-        total_pnl += position.unrealized_pnl;
+std::shared_ptr<const ExecutionParams> AlgorithmicEngine::executionParams(const std::string& strategy_id) {
+    std::lock_guard<std::mutex> lock(strategies_mutex_);
+    for (const auto& strand : strategies_) {
+        if (strand->strategy->getConfig().name == strategy_id) return strand->execution;
+    }
+    return nullptr;
+}
+
+void AlgorithmicEngine::applyExecution(const ExecutionReport& report) {
+    double filled = 0.0;
+    const ManagedOrder* order = order_manager_->apply(report, filled);
+    if (!order) return;
+    
+    if (order->state == OrderState::REJECTED) {
+        std::cout << "Order rejected: " << order->id << " " << order->instrument << std::endl;
+        return;
     }
+    if (filled <= 0.0) return;
+    
+    double realized = position_book_->applyFill(order->contract, order->symbol, order->buy ? filled : -filled,
+                                                report.price, report.received, order->expiration_date);
     
+    const Position* position = position_book_->find(order->contract);
+    std::cout << "Position updated: " << order->instrument
+              << " qty: " << (position ? position->quantity : 0.0)
+              << " @ " << (position ? position->average_price : report.price);
+    if (realized != 0.0) std::cout << " realized: " << realized;
+    if (order->state == OrderState::FILLED) {
+        std::cout << " (" << order->id << " filled, signal-to-fill "
+                  << std::chrono::duration<double, std::micro>(report.received - order->signal_time).count()
+                  << "us)";
+    }
+    std::cout << std::endl;
+}
+
+void AlgorithmicEngine::updateRiskMetrics() {
+    // Running totals kept by the position book; no pass over positions
+    double total_pnl = position_book_->unrealizedPnl();
     double portfolio_return = total_pnl / current_portfolio_value_;
     
     // Log risk metrics periodically
     static int counter = 0;
     if (++counter % 60 == 0) { // Every minute
         std::cout << "Portfolio Update - Total P&L: $" << total_pnl 
+                  << ", Realized: $" << position_book_->realizedPnl()
                   << ", Return: " << (portfolio_return * 100) << "%" 
-                  << ", Positions: " << positions_.size() << std::endl;
+                  << ", Positions: " << position_book_->size() << std::endl;
+        
+        const LatencyStat& fills = order_manager_->signalToFill();
+        std::cout << "Orders - Open: " << order_manager_->openOrders()
+                  << ", Filled: " << fills.count
+                  << ", Signal-to-fill mean: " << fills.meanMicros() << "us"
+                  << ", max: " << fills.max_us << "us"
+                  << ", Send-to-ack mean: " << order_manager_->sendToAck().meanMicros() << "us"
+                  << ", Working parents: " << execution_scheduler_->activeParents() << std::endl;
     }
 }
 
 double AlgorithmicEngine::calculatePortfolioRisk() {
-    double total_exposure = 0.0;
-    for (const auto& position : positions_) {
-        total_exposure += std::abs(position.current_price * position.quantity);
-    }
-    return total_exposure / current_portfolio_value_;
+    return position_book_->grossExposure() / current_portfolio_value_;
 }
 
 } // namespace algo
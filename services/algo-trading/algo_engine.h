@@ -6,6 +6,13 @@
 #include <chrono>
 #include <functional>
 #include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "mpsc_queue.h"
+#include "price_history.h"
+#include "streaming_indicators.h"
+#include "work_stealing_pool.h"
 
 namespace hedgefund {
 namespace algo {
@@ -36,12 +43,12 @@ enum class StrategyType {
 struct MarketData {
     std::string symbol;
     double price;
-    double volume;
+    double volume;  // Session cumulative, as quoted
     double bid;
     double ask;
     std::chrono::system_clock::time_point timestamp;
     
-    // Technical indicators
+    // Technical indicators, filled in by the engine
     double sma_20;
     double sma_50;
     double rsi;
@@ -49,6 +56,10 @@ struct MarketData {
     double bollinger_lower;
     double macd;
     double macd_signal;
+    
+    // Interned at decode; INVALID_SYMBOL lets the engine intern it instead
+    common::SymbolId symbol_id = common::INVALID_SYMBOL;
+    uint64_t sequence = 0;  // Entry in the engine's PriceHistoryStore series, set by the engine
 };
 
 struct TradingSignal {
@@ -67,12 +78,25 @@ struct TradingSignal {
     bool is_call = true;
 };
 
+// Order book response to an order sent by the engine's OrderManager
+struct ExecutionReport {
+    enum class Type { ACK, REJECT, FILL };
+    
+    Type type = Type::ACK;
+    std::string order_id;
+    double price = 0.0;     // Fills only
+    double quantity = 0.0;  // Fills only
+    std::chrono::system_clock::time_point received;  // Arrival in this process
+};
+
 struct Position {
     std::string symbol;
+    common::SymbolId symbol_id = common::INVALID_SYMBOL;
     double quantity;
     double average_price;
     double current_price;
     double unrealized_pnl;
+    double realized_pnl = 0.0;
     std::chrono::system_clock::time_point entry_time;
     
     // Options specific
@@ -82,6 +106,12 @@ struct Position {
     bool is_option = false;
 };
 
+class PositionBook;
+class OrderManager;
+class OrderGateway;
+class ExecutionScheduler;
+struct ExecutionParams;
+
 struct StrategyConfig {
     StrategyType type;
     std::string name;
@@ -93,25 +123,91 @@ struct StrategyConfig {
     double take_profit_pct;
 };
 
+// Ticks in arrival order, viewed in place
+struct TickSpan {
+    const MarketData* data = nullptr;
+    size_t size = 0;
+    
+    const MarketData* begin() const { return data; }
+    const MarketData* end() const { return data + size; }
+};
+
+// Receives a strategy's signals as they are produced. The engine's sink
+// pushes straight onto its signal queue, so nothing is collected per tick.
+class SignalSink {
+public:
+    using EmitFn = void (*)(void* context, TradingSignal&& signal);
+    
+    SignalSink(EmitFn emit, void* context) : emit_(emit), context_(context) {}
+    
+    void emit(TradingSignal&& signal) {
+        emitted_++;
+        emit_(context_, std::move(signal));
+    }
+    size_t emitted() const { return emitted_; }
+    
+private:
+    EmitFn emit_;
+    void* context_;
+    size_t emitted_ = 0;
+};
+
 class TradingStrategy {
 public:
     TradingStrategy(const StrategyConfig& config) : config_(config) {}
     virtual ~TradingStrategy() = default;
     
-    virtual std::vector<TradingSignal> generateSignals(const std::vector<MarketData>& market_data) = 0;
+    // Evaluates one tick; ticks arrive in order per symbol
+    virtual void onTick(const MarketData& tick, SignalSink& sink) = 0;
+    
+    // Evaluates a batch with one virtual call. StrategyBase overrides this so
+    // the per-tick calls are direct.
+    virtual void onTicks(TickSpan ticks, SignalSink& sink) {
+        for (const auto& tick : ticks) onTick(tick, sink);
+    }
+    
     virtual void updatePosition(const Position& position) = 0;
     virtual double calculateRisk(const std::vector<Position>& positions) = 0;
     
+    // Collecting wrapper for callers outside the engine
+    std::vector<TradingSignal> generateSignals(const std::vector<MarketData>& market_data) {
+        std::vector<TradingSignal> signals;
+        SignalSink sink([](void* out, TradingSignal&& signal) {
+            static_cast<std::vector<TradingSignal>*>(out)->push_back(std::move(signal));
+        }, &signals);
+        onTicks(TickSpan{market_data.data(), market_data.size()}, sink);
+        return signals;
+    }
+    
     const StrategyConfig& getConfig() const { return config_; }
     
+    // History shared by every strategy in an engine; strategies without one keep their own
+    virtual void attachPriceHistory(const PriceHistoryStore* store) { shared_history_ = store; }
+    
 protected:
     StrategyConfig config_;
     std::vector<Position> positions_;
+    const PriceHistoryStore* shared_history_ = nullptr;
+};
+
+// Base for strategies compiled into the engine. Derived::onTick is called
+// non-virtually inside the batch loop, so the compiler can inline it and a
+// batch costs a single virtual call however many ticks it holds.
+template <typename Derived>
+class StrategyBase : public TradingStrategy {
+public:
+    using TradingStrategy::TradingStrategy;
+    
+    void onTicks(TickSpan ticks, SignalSink& sink) final {
+        Derived& self = static_cast<Derived&>(*this);
+        for (const auto& tick : ticks) self.Derived::onTick(tick, sink);
+    }
 };
 
 class AlgorithmicEngine {
 public:
-    AlgorithmicEngine();
+    // Strategy evaluation threads; 0 uses one per hardware thread
+    explicit AlgorithmicEngine(int num_threads = 0);
     ~AlgorithmicEngine();
     
     bool initialize();
@@ -123,26 +219,82 @@ public:
     void removeStrategy(const std::string& strategy_id);
     void enableStrategy(const std::string& strategy_id, bool enabled);
     
-    // Market data processing
+    // Market data processing; queues the tick for the engine thread, which
+    // hands it only to enabled strategies subscribed to data.symbol. Strategies
+    // evaluate on the pool and their signals come back to the engine thread.
     void processMarketData(const MarketData& data);
     void processSignal(const TradingSignal& signal);
     
+    // Order routing; set the gateway before run(). Execution reports may
+    // arrive on any thread and are applied on the engine thread.
+    void setOrderGateway(std::unique_ptr<OrderGateway> gateway);
+    void processExecution(const ExecutionReport& report);
+    
     // Risk management
     bool validateSignal(const TradingSignal& signal);
     void updateRiskMetrics();
     
+    // Engine thread only
+    const PositionBook& positionBook() const { return *position_book_; }
+    const OrderManager& orderManager() const { return *order_manager_; }
+    
 private:
-    std::vector<std::unique_ptr<TradingStrategy>> strategies_;
-    std::unordered_map<std::string, MarketData> latest_market_data_;
-    std::vector<Position> positions_;
+    // A strategy plus its unevaluated ticks. At most one pool task drains a
+    // strand at a time, so strategy state is never touched concurrently.
+    struct StrategyStrand {
+        explicit StrategyStrand(std::unique_ptr<TradingStrategy> s) : strategy(std::move(s)) {}
+        
+        std::unique_ptr<TradingStrategy> strategy;
+        std::shared_ptr<const ExecutionParams> execution;  // Null sends signals as single orders
+        std::mutex mutex;
+        std::vector<MarketData> pending;  // In arrival order
+        std::vector<MarketData> batch;    // Owned by the draining task
+        bool scheduled = false;
+    };
+    
+    std::vector<std::shared_ptr<StrategyStrand>> strategies_;
+    common::SymbolTable<std::vector<std::shared_ptr<StrategyStrand>>> symbol_index_;  // Symbol -> subscribers
+    std::mutex strategies_mutex_;
+    
+    // Engine thread only
+    common::SymbolTable<MarketData> latest_market_data_;
+    common::SymbolTable<IndicatorSet> indicators_;
+    common::SymbolTable<double> session_volume_;  // Last quoted session volume
+    PriceHistoryStore price_history_;  // Appended by the engine thread, read by strategies
+    std::unique_ptr<PositionBook> position_book_;
+    std::unique_ptr<OrderManager> order_manager_;
+    std::unique_ptr<ExecutionScheduler> execution_scheduler_;
     
-    bool running_;
+    // Ticks waiting for the engine thread
+    std::vector<MarketData> pending_ticks_;
+    std::vector<MarketData> draining_ticks_;
+    std::mutex tick_mutex_;
+    std::condition_variable tick_ready_;
+    
+    // Signals from strategy tasks and reports from the order gateway,
+    // consumed by the engine thread
+    MpscQueue<TradingSignal> signal_queue_;
+    MpscQueue<ExecutionReport> execution_queue_;
+    bool events_ready_ = false;  // Guarded by tick_mutex_
+    
+    std::atomic<bool> running_;
     double max_portfolio_risk_;
     double current_portfolio_value_;
     
+    void rebuildSymbolIndex();
+    void dispatchTick(const MarketData& data);
+    void post(const std::shared_ptr<StrategyStrand>& strand, const MarketData& data);
+    void drainStrand(const std::shared_ptr<StrategyStrand>& strand);
+    void drainSignals();
+    void drainExecutions();
     void executeSignal(const TradingSignal& signal);
-    void updatePositions();
+    void releaseChildOrders();
+    std::shared_ptr<const ExecutionParams> executionParams(const std::string& strategy_id);
+    void applyExecution(const ExecutionReport& report);
     double calculatePortfolioRisk();
+    
+    // Declared last so workers are joined before the state their tasks use is destroyed
+    WorkStealingPool pool_;
 };
 
 } // namespace algo
@@ -0,0 +1,228 @@
+#include "execution_scheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace hedgefund {
+namespace algo {
+
+void ExecutionParams::prepare() {
+    slices = std::max(1, slices);
+    cumulative_profile.clear();
+    if (algo != ExecutionAlgo::VWAP) return;
+    
+    // Intraday volume is heaviest at the open and close
+    if (volume_profile.empty()) {
+        for (int i = 0; i < slices; i++) {
+            double x = slices > 1 ? 2.0 * i / (slices - 1) - 1.0 : 0.0;
+            volume_profile.push_back(1.0 + 2.0 * x * x);
+        }
+    }
+    slices = static_cast<int>(volume_profile.size());
+    
+    double total = 0.0;
+    for (double weight : volume_profile) total += std::max(0.0, weight);
+    double running = 0.0;
+    for (double weight : volume_profile) {
+        running += std::max(0.0, weight);
+        cumulative_profile.push_back(total > 0.0 ? running / total : 1.0);
+    }
+    cumulative_profile.back() = 1.0;
+}
+
+ExecutionParams ExecutionParams::fromConfig(const StrategyConfig& config) {
+    auto get = [&config](const char* key, double fallback) {
+        auto it = config.parameters.find(key);
+        return it != config.parameters.end() ? it->second : fallback;
+    };
+    
+    ExecutionParams params;
+    int algo = static_cast<int>(get("execution_algo", 0.0));
+    params.algo = algo >= 0 && algo <= 3 ? static_cast<ExecutionAlgo>(algo) : ExecutionAlgo::IMMEDIATE;
+    params.horizon = std::chrono::milliseconds(static_cast<int64_t>(std::max(0.0, get("execution_horizon_sec", 300.0)) * 1000.0));
+    params.slices = static_cast<int>(get("execution_slices", 10.0));
+    params.participation_rate = std::min(1.0, std::max(0.0, get("participation_rate", 0.10)));
+    params.pov_interval = std::chrono::milliseconds(static_cast<int64_t>(std::max(0.001, get("pov_interval_sec", 1.0)) * 1000.0));
+    params.lot_size = get("lot_size", 1.0);
+    for (int i = 0;; i++) {
+        auto it = config.parameters.find("volume_profile_" + std::to_string(i));
+        if (it == config.parameters.end()) break;
+        params.volume_profile.push_back(it->second);
+    }
+    params.prepare();
+    return params;
+}
+
+ExecutionScheduler::ExecutionScheduler(Clock::time_point start, Clock::duration tick, size_t slots)
+    : wheel_(tick, slots, start) {}
+
+uint64_t ExecutionScheduler::submit(const TradingSignal& signal, const ContractKey& contract, double quantity,
+                                    std::shared_ptr<const ExecutionParams> params, Clock::time_point now) {
+    if (quantity == 0.0 || !params) return 0;
+    
+    uint32_t index;
+    if (!free_parents_.empty()) {
+        index = free_parents_.back();
+        free_parents_.pop_back();
+    } else {
+        parents_.emplace_back();
+        index = static_cast<uint32_t>(parents_.size() - 1);
+    }
+    
+    Parent& parent = parents_[index];
+    parent.signal = signal;
+    parent.contract = contract;
+    parent.params = std::move(params);
+    parent.quantity = std::abs(quantity);
+    parent.released = 0.0;
+    parent.buy = quantity > 0.0;
+    parent.next_slice = 0;
+    parent.start = now;
+    const double* volume = cumulative_volume_.find(contract.symbol_id);
+    parent.start_volume = volume ? *volume : 0.0;
+    parent.timer = TimerWheel::INVALID_TIMER;
+    parent.active = true;
+    active_++;
+    
+    uint64_t id = idOf(index);
+    if (parent.params->algo == ExecutionAlgo::POV) {
+        parent.timer = wheel_.schedule(now + parent.params->pov_interval, id);
+    } else {
+        ready_.push_back(id);
+    }
+    return id;
+}
+
+bool ExecutionScheduler::cancel(uint64_t parent_id) {
+    Parent* parent = lookup(parent_id);
+    if (!parent) return false;
+    wheel_.cancel(parent->timer);
+    finish(static_cast<uint32_t>(parent_id));
+    return true;
+}
+
+void ExecutionScheduler::onVolume(common::SymbolId symbol_id, double session_volume) {
+    if (symbol_id == common::INVALID_SYMBOL || !(session_volume >= 0.0)) return;
+    
+    // The first quote only sets the baseline: volume before it was not observed
+    double* last = session_volume_.find(symbol_id);
+    if (!last) {
+        session_volume_[symbol_id] = session_volume;
+        return;
+    }
+    double traded = session_volume >= *last ? session_volume - *last : session_volume;
+    *last = session_volume;
+    cumulative_volume_[symbol_id] += traded;
+}
+
+const std::vector<ChildOrder>& ExecutionScheduler::advance(Clock::time_point now) {
+    children_.clear();
+    
+    for (uint64_t id : ready_) {
+        if (lookup(id)) work(static_cast<uint32_t>(id), now);
+    }
+    ready_.clear();
+    
+    wheel_.advance(now, [this, now](uint64_t id) {
+        if (lookup(id)) work(static_cast<uint32_t>(id), now);
+    });
+    return children_;
+}
+
+ExecutionScheduler::Clock::time_point ExecutionScheduler::nextWakeup() const {
+    if (!ready_.empty()) return Clock::time_point::min();
+    return wheel_.empty() ? Clock::time_point::max() : wheel_.nextTick();
+}
+
+void ExecutionScheduler::work(uint32_t index, Clock::time_point now) {
+    Parent& parent = parents_[index];
+    const ExecutionParams& params = *parent.params;
+    parent.timer = TimerWheel::INVALID_TIMER;
+    
+    if (params.algo == ExecutionAlgo::POV) {
+        const double* volume = cumulative_volume_.find(parent.contract.symbol_id);
+        double traded = volume ? *volume - parent.start_volume : 0.0;
+        release(index, params.participation_rate * traded);
+        if (!parent.active) return;
+        
+        if (now - parent.start >= params.horizon) {
+            expired_++;
+            finish(index);
+            return;
+        }
+        parent.timer = wheel_.schedule(now + params.pov_interval, idOf(index));
+        return;
+    }
+    
+    // Slices come due on a fixed grid from the start; a late wakeup catches
+    // up every slice it missed in one child
+    const int slices = params.algo == ExecutionAlgo::VWAP ? static_cast<int>(params.cumulative_profile.size())
+                                                          : (params.algo == ExecutionAlgo::TWAP ? params.slices : 1);
+    int due = slices;
+    if (params.horizon.count() > 0) {
+        due = static_cast<int>((now - parent.start) * slices / params.horizon) + 1;
+    }
+    parent.next_slice = std::min(slices, std::max(parent.next_slice + 1, due));
+    
+    release(index, parent.quantity * scheduleFraction(parent, parent.next_slice));
+    if (!parent.active) return;
+    
+    auto deadline = parent.start + params.horizon * parent.next_slice / slices;
+    parent.timer = wheel_.schedule(deadline, idOf(index));
+}
+
+void ExecutionScheduler::release(uint32_t index, double target) {
+    Parent& parent = parents_[index];
+    
+    // The last child takes any odd lot so the parent always completes
+    double child = target >= parent.quantity ? parent.quantity - parent.released
+                                             : lots(parent, target - parent.released);
+    if (child > 0.0) {
+        parent.released += child;
+        children_.push_back(ChildOrder{idOf(index), &parent.signal, parent.contract, parent.buy ? child : -child});
+    }
+    
+    if (parent.quantity - parent.released <= 1e-9) {
+        completed_++;
+        finish(index);
+    }
+}
+
+void ExecutionScheduler::finish(uint32_t index) {
+    Parent& parent = parents_[index];
+    parent.active = false;
+    parent.timer = TimerWheel::INVALID_TIMER;
+    parent.generation++;
+    if (parent.generation == 0) parent.generation = 1;  // Keeps ids non-zero
+    active_--;
+    free_parents_.push_back(index);
+}
+
+ExecutionScheduler::Parent* ExecutionScheduler::lookup(uint64_t parent_id) {
+    uint32_t index = static_cast<uint32_t>(parent_id);
+    if (index >= parents_.size()) return nullptr;
+    Parent& parent = parents_[index];
+    if (!parent.active || parent.generation != static_cast<uint32_t>(parent_id >> 32)) return nullptr;
+    return &parent;
+}
+
+double ExecutionScheduler::lots(const Parent& parent, double quantity) const {
+    if (quantity <= 0.0) return 0.0;
+    double lot = parent.params->lot_size;
+    if (lot <= 0.0) return quantity;
+    return std::floor(quantity / lot + 1e-9) * lot;
+}
+
+double ExecutionScheduler::scheduleFraction(const Parent& parent, int slices_done) const {
+    const ExecutionParams& params = *parent.params;
+    if (params.algo == ExecutionAlgo::VWAP && !params.cumulative_profile.empty()) {
+        return params.cumulative_profile[std::min<size_t>(slices_done, params.cumulative_profile.size()) - 1];
+    }
+    if (params.algo == ExecutionAlgo::TWAP) {
+        return static_cast<double>(slices_done) / params.slices;
+    }
+    return 1.0;
+}
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "algo_engine.h"
+#include "position_book.h"
+#include "timer_wheel.h"
+#include "common/symbol_registry.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace hedgefund {
+namespace algo {
+
+enum class ExecutionAlgo {
+    IMMEDIATE = 0,  // Whole quantity as one order
+    TWAP = 1,       // Equal slices across the horizon
+    VWAP = 2,       // Slices weighted by a volume profile
+    POV = 3         // A fixed share of the volume traded since the parent started
+};
+
+struct ExecutionParams {
+    ExecutionAlgo algo = ExecutionAlgo::IMMEDIATE;
+    std::chrono::milliseconds horizon{300000};     // TWAP/VWAP duration; POV stops working at the end
+    int slices = 10;                               // TWAP/VWAP child count
+    double participation_rate = 0.10;              // POV
+    std::chrono::milliseconds pov_interval{1000};  // How often POV compares against volume
+    double lot_size = 1.0;                         // Children are whole lots
+    std::vector<double> volume_profile;            // VWAP weight per slice; empty uses an intraday U shape
+    std::vector<double> cumulative_profile;        // VWAP share done after each slice, set by prepare()
+    
+    // Fills the default VWAP profile and the cumulative schedule; call after
+    // changing algo, slices or volume_profile
+    void prepare();
+    
+    // Reads execution_algo (0-3), execution_horizon_sec, execution_slices,
+    // participation_rate, pov_interval_sec and lot_size from the parameters,
+    // and the VWAP profile from volume_profile_0, volume_profile_1, ... up to
+    // the first missing index
+    static ExecutionParams fromConfig(const StrategyConfig& config);
+};
+
+// One slice released by a parent
+struct ChildOrder {
+    uint64_t parent_id;
+    const TradingSignal* signal;  // Parent's signal; valid until the next submit() or advance()
+    ContractKey contract;
+    double quantity;              // Signed, positive buys
+};
+
+// Works parent orders by releasing child slices on a shared timer wheel, so
+// thousands of parents run on the engine thread with no per-parent timers or
+// threads. POV reads a per-symbol running volume total that ticks update in
+// O(1) from the quoted session volume; parents compare against it only when their timer fires. Engine
+// thread only.
+class ExecutionScheduler {
+public:
+    using Clock = TimerWheel::Clock;
+    
+    explicit ExecutionScheduler(Clock::time_point start = Clock::now(),
+                                Clock::duration tick = std::chrono::milliseconds(100), size_t slots = 512);
+    
+    // Starts a parent for quantity (positive buys); its first TWAP/VWAP slice
+    // goes out on the next advance. Returns the parent id.
+    uint64_t submit(const TradingSignal& signal, const ContractKey& contract, double quantity,
+                    std::shared_ptr<const ExecutionParams> params, Clock::time_point now);
+    bool cancel(uint64_t parent_id);
+    
+    // Session cumulative volume as quoted on each tick. Only the increase
+    // since the symbol's previous tick counts as traded; a drop means a new
+    // session, whose volume so far counts from zero.
+    void onVolume(common::SymbolId symbol_id, double session_volume);
+    
+    // Children due by now; the result is reused by the next call
+    const std::vector<ChildOrder>& advance(Clock::time_point now);
+    
+    // When advance next has work; Clock::time_point::max() when idle
+    Clock::time_point nextWakeup() const;
+    
+    size_t activeParents() const { return active_; }
+    uint64_t completedParents() const { return completed_; }
+    uint64_t expiredParents() const { return expired_; }  // POV parents that ran out of time
+    
+private:
+    struct Parent {
+        TradingSignal signal;
+        ContractKey contract;
+        std::shared_ptr<const ExecutionParams> params;
+        double quantity = 0.0;  // Unsigned
+        double released = 0.0;
+        bool buy = true;
+        int next_slice = 0;
+        double start_volume = 0.0;
+        Clock::time_point start;
+        TimerWheel::TimerId timer = TimerWheel::INVALID_TIMER;
+        uint32_t generation = 1;
+        bool active = false;
+    };
+    
+    TimerWheel wheel_;
+    std::vector<Parent> parents_;
+    std::vector<uint32_t> free_parents_;
+    std::vector<uint64_t> ready_;  // Parent ids due without waiting for the wheel
+    std::vector<ChildOrder> children_;
+    common::SymbolTable<double> cumulative_volume_;  // Traded since the scheduler started
+    common::SymbolTable<double> session_volume_;     // Last quoted session total
+    size_t active_ = 0;
+    uint64_t completed_ = 0;
+    uint64_t expired_ = 0;
+    
+    void work(uint32_t index, Clock::time_point now);
+    void release(uint32_t index, double target);
+    void finish(uint32_t index);
+    Parent* lookup(uint64_t parent_id);
+    double lots(const Parent& parent, double quantity) const;
+    double scheduleFraction(const Parent& parent, int slices_done) const;
+    uint64_t idOf(uint32_t index) const { return (static_cast<uint64_t>(parents_[index].generation) << 32) | index; }
+};
+
+} // namespace algo
+} // namespace hedgefund
@@ -1,13 +1,22 @@
 #include "algo_engine.h"
 #include "momentum_strategy.h"
 #include "options_strategy.h"
+#include "strategy_plugin.h"
+#include "order_gateway.h"
+#include "execution_scheduler.h"
+#include "../options/volatility_surface.h"
 #include "common/database.h"
 #include "common/messaging.h"
+#include "common/symbol_registry.h"
+#include "common/order_messages.h"
+#include "common/tick_codec.h"
 #include <iostream>
 #include <thread>
+#include <mutex>
 #include <chrono>
 #include <random>
 #include <sstream>
+#include <cstdlib>
 
 using namespace hedgefund::algo;
 using namespace hedgefund::common;
@@ -40,17 +49,16 @@ public:
             handleMarketData(msg);
         });
         
-        // Subscribe to technical indicators
-        mq_.subscribe("technical.indicators", [this](const Message& msg) {
-            handleTechnicalIndicators(msg);
-        });
-        
         // Subscribe to options data
         mq_.subscribe("options.data", [this](const Message& msg) {
             handleOptionsData(msg);
         });
         
-        // Subscribe to order execution confirmations
+        // Subscribe to order acknowledgements and execution confirmations
+        mq_.subscribe("orders.ack", [this](const Message& msg) {
+            handleOrderAcks(msg);
+        });
+        
         mq_.subscribe("trades.executed", [this](const Message& msg) {
             handleTradeExecution(msg);
         });
@@ -59,6 +67,7 @@ public:
         
         // Initialize trading strategies
         setupStrategies();
+        setupOrderRouting();
         
         return true;
     }
@@ -71,10 +80,19 @@ public:
             engine_.run();
         });
         
+        // Quotes only mark expiries dirty; fitting happens here, off the message thread
+        std::thread surface_thread([this]() {
+            while (true) {
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                refitVolatilitySurfaces();
+            }
+        });
+        
         // Simulate market data for demonstration
         simulateMarketData();
         
         engine_thread.join();
+        surface_thread.join();
     }
     
 private:
@@ -83,6 +101,12 @@ private:
     AlgorithmicEngine engine_;
     std::mt19937 rng_{std::random_device{}()};
     
+    // Surfaces fitted from options.data and published to the strategies
+    std::mutex vol_surfaces_mutex_;
+    std::unordered_map<std::string, hedgefund::options::VolatilitySurface> vol_surfaces_;
+    std::unordered_map<std::string, double> spot_prices_;
+    MarketData scratch_tick_;  // Reused by the binary quote decoder; message handlers run on one thread
+    
     void setupStrategies() {
         // Setup Momentum Strategy
         StrategyConfig momentum_config;
@@ -96,6 +120,11 @@ private:
         momentum_config.stop_loss_pct = 0.05;
         momentum_config.take_profit_pct = 0.10;
         
+        // Work momentum entries as TWAP parents: 10 slices over 5 minutes
+        momentum_config.parameters["execution_algo"] = static_cast<double>(ExecutionAlgo::TWAP);
+        momentum_config.parameters["execution_horizon_sec"] = 300.0;
+        momentum_config.parameters["execution_slices"] = 10.0;
+        
         auto momentum_strategy = std::make_unique<MomentumStrategy>(momentum_config);
         engine_.addStrategy(std::move(momentum_strategy));
         
@@ -125,10 +154,68 @@ private:
         auto condor_strategy = std::make_unique<OptionsStrategy>(condor_config);
         engine_.addStrategy(std::move(condor_strategy));
         
-        std::cout << "Initialized 3 trading strategies" << std::endl;
+        // Shared-library strategies, e.g. ALGO_STRATEGY_PLUGINS=/opt/strategies/pairs.so:/opt/strategies/mm.so.
+        // Each trades the momentum universe and parameters under its own name.
+        int plugin_count = 0;
+        if (const char* plugins = std::getenv("ALGO_STRATEGY_PLUGINS")) {
+            std::stringstream paths(plugins);
+            std::string path;
+            while (std::getline(paths, path, ':')) {
+                if (path.empty()) continue;
+                
+                StrategyConfig plugin_config = momentum_config;
+                plugin_config.name = "Plugin_" + path.substr(path.find_last_of('/') + 1);
+                
+                std::string error;
+                auto plugin_strategy = PluginStrategy::load(path, plugin_config, &error);
+                if (!plugin_strategy) {
+                    std::cerr << "Failed to load strategy plugin: " << error << std::endl;
+                    continue;
+                }
+                engine_.addStrategy(std::move(plugin_strategy));
+                plugin_count++;
+            }
+        }
+        
+        std::cout << "Initialized " << 3 + plugin_count << " trading strategies" << std::endl;
+    }
+    
+    void setupOrderRouting() {
+        // Co-located with the books: orders skip the broker and fills come straight back
+        if (std::getenv("ALGO_COLOCATED_ORDERBOOK")) {
+            auto gateway = std::make_unique<InProcessOrderGateway>([this](const ExecutionReport& report) {
+                engine_.processExecution(report);
+            });
+            for (const char* symbol : {"AAPL", "GOOGL", "TSLA"}) {
+                gateway->addBook(symbol, std::make_shared<hedgefund::orderbook::OrderBook>(symbol));
+            }
+            engine_.setOrderGateway(std::move(gateway));
+            std::cout << "Routing orders to in-process order books" << std::endl;
+        } else {
+            engine_.setOrderGateway(std::make_unique<MessageOrderGateway>(mq_));
+        }
     }
     
     void handleMarketData(const Message& msg) {
+        // Binary quotes are read in place; the text form is a debug fallback
+        if (isBinaryTick(msg.payload)) {
+            TickReader reader(msg.payload);
+            while (reader.next()) {
+                if (reader.kind() != TickKind::QUOTE) continue;
+                
+                MarketData& data = scratch_tick_;
+                data.symbol.assign(reader.symbol(), reader.symbolLength());
+                data.symbol_id = SymbolRegistry::instance().intern(data.symbol);
+                data.price = reader.price();
+                data.volume = reader.volume();
+                data.bid = reader.bid() > 0.0 ? reader.bid() : data.price - 0.01;
+                data.ask = reader.ask() > 0.0 ? reader.ask() : data.price + 0.01;
+                data.timestamp = tickTime(reader.timestamp());
+                submitQuote(data);
+            }
+            return;
+        }
+        
         // Parse Polygon.io market data message
         // Format: "MARKET_DATA,SYMBOL,PRICE,VOLUME,HIGH,LOW,CHANGE_PERCENT"
         std::string payload = msg.payload;
@@ -145,22 +232,13 @@ private:
             if (tokens.size() >= 7) {
                 MarketData data;
                 data.symbol = tokens[1];
+                data.symbol_id = SymbolRegistry::instance().intern(data.symbol);
                 data.price = std::stod(tokens[2]);
                 data.volume = std::stod(tokens[3]);
                 data.bid = data.price - 0.01; // Approximate bid
                 data.ask = data.price + 0.01; // Approximate ask
                 data.timestamp = std::chrono::system_clock::now();
-                
-                // Will be updated by technical indicators handler
-                data.sma_20 = data.price;
-                data.sma_50 = data.price;
-                data.rsi = 50.0;
-                data.bollinger_upper = data.price + 2.0;
-                data.bollinger_lower = data.price - 2.0;
-                data.macd = 0.0;
-                data.macd_signal = 0.0;
-                
-                engine_.processMarketData(data);
+                submitQuote(data);
                 
                 std::cout << "Processed Polygon.io data: " << data.symbol 
                           << " $" << data.price << " Vol: " << data.volume << std::endl;
@@ -168,43 +246,24 @@ private:
         }
     }
     
-    void handleTechnicalIndicators(const Message& msg) {
-        // Parse technical indicators from Polygon.io service
-        // Format: "TECHNICAL_INDICATORS,SYMBOL,SMA20,SMA50,RSI,BB_UPPER,BB_LOWER,MACD,MACD_SIGNAL"
-        std::string payload = msg.payload;
-        
-        if (payload.find("TECHNICAL_INDICATORS") == 0) {
-            std::istringstream ss(payload);
-            std::string token;
-            std::vector<std::string> tokens;
-            
-            while (std::getline(ss, token, ',')) {
-                tokens.push_back(token);
-            }
-            
-            if (tokens.size() >= 9) {
-                MarketData data;
-                data.symbol = tokens[1];
-                data.price = 0.0; // Will be updated from market data
-                data.sma_20 = std::stod(tokens[2]);
-                data.sma_50 = std::stod(tokens[3]);
-                data.rsi = std::stod(tokens[4]);
-                data.bollinger_upper = std::stod(tokens[5]);
-                data.bollinger_lower = std::stod(tokens[6]);
-                data.macd = std::stod(tokens[7]);
-                data.macd_signal = std::stod(tokens[8]);
-                data.timestamp = std::chrono::system_clock::now();
-                
-                // Update existing market data with technical indicators
-                engine_.processMarketData(data);
-                
-                std::cout << "Updated technical indicators for " << data.symbol 
-                          << " RSI: " << data.rsi << " MACD: " << data.macd << std::endl;
-            }
-        }
+    // Indicators are left to the engine, which computes them from the ticks
+    void submitQuote(MarketData& data) {
+        engine_.processMarketData(data);
+        spot_prices_[data.symbol] = data.price;
     }
     
     void handleOptionsData(const Message& msg) {
+        if (isBinaryTick(msg.payload)) {
+            TickReader reader(msg.payload);
+            while (reader.next()) {
+                if (reader.kind() != TickKind::OPTION_QUOTE) continue;
+                applyOptionQuote(std::string(reader.symbol(), reader.symbolLength()), reader.strike(),
+                                 formatExpiry(reader.expiry()), reader.isCall() ? "call" : "put",
+                                 reader.optionPrice(), reader.impliedVol(), reader.delta());
+            }
+            return;
+        }
+        
         // Parse options data from Polygon.io
         // Format: "OPTIONS_DATA,UNDERLYING,STRIKE,EXPIRATION,TYPE,PRICE,IV,DELTA"
         std::string payload = msg.payload;
@@ -231,49 +290,122 @@ private:
                           << " " << strike << " " << type 
                           << " Price: $" << price << " IV: " << (iv * 100) << "%" << std::endl;
                 
-                // Store in database for options strategies
-                std::ostringstream query;
-                query << "INSERT INTO options_data (underlying_symbol, strike_price, expiration_date, "
-                      << "option_type, theoretical_price, implied_volatility, delta) VALUES ('"
-                      << underlying << "', " << strike << ", '" << expiration << "', '"
-                      << type << "', " << price << ", " << iv << ", " << delta << ") "
-                      << "ON CONFLICT (underlying_symbol, strike_price, expiration_date, option_type) "
-                      << "DO UPDATE SET theoretical_price = " << price << ", implied_volatility = " << iv;
-                
-                db_.execute(query.str());
+                applyOptionQuote(underlying, strike, expiration, type, price, iv, delta);
             }
         }
     }
     
+    void applyOptionQuote(const std::string& underlying, double strike, const std::string& expiration,
+                          const std::string& type, double price, double iv, double delta) {
+        // Store in database for options strategies
+        std::ostringstream query;
+        query << "INSERT INTO options_data (underlying_symbol, strike_price, expiration_date, "
+              << "option_type, theoretical_price, implied_volatility, delta) VALUES ('"
+              << underlying << "', " << strike << ", '" << expiration << "', '"
+              << type << "', " << price << ", " << iv << ", " << delta << ") "
+              << "ON CONFLICT (underlying_symbol, strike_price, expiration_date, option_type) "
+              << "DO UPDATE SET theoretical_price = " << price << ", implied_volatility = " << iv;
+        
+        db_.execute(query.str());
+        
+        updateVolatilitySurface(underlying, strike, expiration, type, price, iv);
+    }
+    
+    // Exchange time when the tick carries one, otherwise arrival time
+    static std::chrono::system_clock::time_point tickTime(int64_t timestamp_ns) {
+        if (timestamp_ns == 0) return std::chrono::system_clock::now();
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(timestamp_ns)));
+    }
+    
+    void updateVolatilitySurface(const std::string& underlying, double strike, const std::string& expiration,
+                                 const std::string& type, double price, double iv) {
+        auto spot_it = spot_prices_.find(underlying);
+        if (spot_it == spot_prices_.end()) return;
+        
+        hedgefund::options::VolQuote quote;
+        quote.strike_price = strike;
+        quote.expiry_date = packExpiry(expiration);
+        quote.underlying_price = spot_it->second;
+        quote.price = price;
+        quote.implied_vol = iv;
+        quote.is_call = type == "call" || type == "CALL" || type == "C";
+        
+        std::lock_guard<std::mutex> lock(vol_surfaces_mutex_);
+        auto it = vol_surfaces_.find(underlying);
+        if (it == vol_surfaces_.end()) {
+            it = vol_surfaces_.emplace(underlying, hedgefund::options::VolatilitySurface(underlying)).first;
+        }
+        it->second.addQuote(quote);
+    }
+    
+    // Refit only the expiries quoted since the last pass, then swap the snapshot in for strategy readers
+    void refitVolatilitySurfaces() {
+        std::lock_guard<std::mutex> lock(vol_surfaces_mutex_);
+        for (auto& [underlying, surface] : vol_surfaces_) {
+            if (surface.refit() > 0) {
+                hedgefund::options::VolatilitySurfaceRegistry::instance().get(underlying)->publish(surface.snapshot());
+            }
+        }
+    }
+    
+    void handleOrderAcks(const Message& msg) {
+        std::vector<OrderAck> acks;
+        if (!decodeOrderAcks(msg.payload, acks)) return;
+        
+        auto received = std::chrono::system_clock::now();
+        for (const auto& ack : acks) {
+            ExecutionReport report;
+            report.type = ack.accepted ? ExecutionReport::Type::ACK : ExecutionReport::Type::REJECT;
+            report.order_id = ack.order_id;
+            report.received = received;
+            engine_.processExecution(report);
+        }
+    }
+    
     void handleTradeExecution(const Message& msg) {
         std::cout << "Trade executed: " << msg.payload << std::endl;
         
+        // Either side may be ours; the engine ignores order ids it did not send
+        TradeMessage trade;
+        if (decodeTrade(msg.payload, trade)) {
+            ExecutionReport report;
+            report.type = ExecutionReport::Type::FILL;
+            report.price = trade.price;
+            report.quantity = trade.quantity;
+            report.received = std::chrono::system_clock::now();
+            
+            report.order_id = trade.buy_order_id;
+            engine_.processExecution(report);
+            report.order_id = trade.sell_order_id;
+            engine_.processExecution(report);
+        }
+        
         // Update positions in database
         db_.execute("UPDATE positions SET quantity = quantity + 100 WHERE symbol = 'AAPL'");
     }
     
     void simulateMarketData() {
         std::vector<std::string> symbols = {"AAPL", "GOOGL", "TSLA"};
+        std::vector<SymbolId> symbol_ids;
+        for (const auto& symbol : symbols) {
+            symbol_ids.push_back(SymbolRegistry::instance().intern(symbol));
+        }
+        std::vector<double> session_volumes(symbols.size(), 0.0);  // Ticks quote the running total
         
         while (true) {
-            for (const auto& symbol : symbols) {
+            for (size_t i = 0; i < symbols.size(); i++) {
+                const std::string& symbol = symbols[i];
                 MarketData data;
                 data.symbol = symbol;
+                data.symbol_id = symbol_ids[i];
                 data.price = 150.0 + (rng_() % 2000 - 1000) / 100.0; // Price between $140-$160
-                data.volume = 1000 + (rng_() % 10000);
+                session_volumes[i] += 1000 + (rng_() % 10000);
+                data.volume = session_volumes[i];
                 data.bid = data.price - 0.05;
                 data.ask = data.price + 0.05;
                 data.timestamp = std::chrono::system_clock::now();
                 
-                // Simulate technical indicators
-                data.sma_20 = data.price + (rng_() % 200 - 100) / 100.0;
-                data.sma_50 = data.price + (rng_() % 400 - 200) / 100.0;
-                data.rsi = 20 + (rng_() % 60); // RSI between 20-80
-                data.bollinger_upper = data.price + 3.0 + (rng_() % 200) / 100.0;
-                data.bollinger_lower = data.price - 3.0 - (rng_() % 200) / 100.0;
-                data.macd = (rng_() % 400 - 200) / 1000.0;
-                data.macd_signal = data.macd + (rng_() % 200 - 100) / 1000.0;
-                
                 engine_.processMarketData(data);
                 
                 // Publish market data to message queue
@@ -1,86 +1,96 @@
 #include "momentum_strategy.h"
 #include <cmath>
-#include <numeric>
 #include <algorithm>
 #include <iostream>
 
 namespace hedgefund {
 namespace algo {
 
-MomentumStrategy::MomentumStrategy(const StrategyConfig& config) : TradingStrategy(config) {
+MomentumStrategy::MomentumStrategy(const StrategyConfig& config) : StrategyBase(config) {
     std::cout << "Initialized Momentum Strategy: " << config.name << std::endl;
 }
 
-std::vector<TradingSignal> MomentumStrategy::generateSignals(const std::vector<MarketData>& market_data) {
-    std::vector<TradingSignal> signals;
-    
-    for (const auto& data : market_data) {
-        // Update price history
-        auto& history = price_history_[data.symbol];
-        history.prices.push_back(data.price);
-        history.timestamps.push_back(data.timestamp);
-        
-        if (history.prices.size() > PriceHistory::MAX_HISTORY) {
-            history.prices.pop_front();
-            history.timestamps.pop_front();
-        }
-        
-        // Need at least 20 data points for momentum calculation
-        if (history.prices.size() < 20) continue;
-        
-        // Calculate momentum indicators
-        double short_momentum = calculateMomentum(data.symbol, 5);  // 5-period momentum
-        double long_momentum = calculateMomentum(data.symbol, 20);  // 20-period momentum
-        double volatility = calculateVolatility(data.symbol, 20);
-        
-        // Momentum strategy logic
-        double momentum_threshold = config_.parameters.at("momentum_threshold"); // e.g., 0.02 (2%)
-        double volatility_threshold = config_.parameters.at("volatility_threshold"); // e.g., 0.03 (3%)
-        
-        // Strong upward momentum
-        if (short_momentum > momentum_threshold && long_momentum > 0 && volatility < volatility_threshold) {
-            if (data.rsi < 70) { // Not overbought
-                double confidence = std::min(0.95, 0.5 + (short_momentum * 10));
-                signals.push_back(createSignal(data.symbol, SignalType::BUY, data.price, confidence, 
-                    "Strong upward momentum detected"));
-            }
-        }
-        
-        // Strong downward momentum
-        else if (short_momentum < -momentum_threshold && long_momentum < 0 && volatility < volatility_threshold) {
-            if (data.rsi > 30) { // Not oversold
-                double confidence = std::min(0.95, 0.5 + (std::abs(short_momentum) * 10));
-                signals.push_back(createSignal(data.symbol, SignalType::SELL, data.price, confidence, 
-                    "Strong downward momentum detected"));
-            }
+void MomentumStrategy::onTick(const MarketData& data, SignalSink& sink) {
+    // Ticks from the engine are already in the shared history; otherwise record them here
+    const PriceHistoryStore* store = shared_history_;
+    common::SymbolId symbol_id = data.symbol_id;
+    uint64_t sequence = data.sequence;
+    if (!store || sequence == 0) {
+        if (!own_history_) own_history_ = std::make_unique<PriceHistoryStore>();
+        if (symbol_id == common::INVALID_SYMBOL) symbol_id = common::SymbolRegistry::instance().intern(data.symbol);
+        PriceSeries* own_series = own_history_->ensure(symbol_id);
+        if (!own_series) return;
+        sequence = own_series->append(data.price, data.timestamp);
+        store = own_history_.get();
+    }
+    
+    const PriceSeries* series = store->series(symbol_id);
+    if (!series) return;
+    
+    if (symbol_id >= symbol_state_.size()) symbol_state_.resize(symbol_id + 1);
+    SymbolState& state = symbol_state_[symbol_id];
+    updateReturns(state, *series, sequence);
+    
+    // Need at least 20 data points for momentum calculation
+    if (sequence < MIN_HISTORY) return;
+    
+    // Calculate momentum indicators
+    double short_momentum = calculateMomentum(*series, sequence, 5);  // 5-period momentum
+    double long_momentum = calculateMomentum(*series, sequence, 20);  // 20-period momentum
+    double volatility = state.returns.stddev();
+    
+    // A strategy that falls a full ring behind reads overwritten prices;
+    // skip the tick and rebuild the return window on the next one
+    if (!series->intact(sequence > 20 ? sequence - 20 : 1)) {
+        state.last_sequence = 0;
+        return;
+    }
+    
+    // Momentum strategy logic
+    double momentum_threshold = config_.parameters.at("momentum_threshold"); // e.g., 0.02 (2%)
+    double volatility_threshold = config_.parameters.at("volatility_threshold"); // e.g., 0.03 (3%)
+    
+    // Strong upward momentum
+    if (short_momentum > momentum_threshold && long_momentum > 0 && volatility < volatility_threshold) {
+        if (data.rsi < 70) { // Not overbought
+            double confidence = std::min(0.95, 0.5 + (short_momentum * 10));
+            sink.emit(createSignal(data.symbol, SignalType::BUY, data.price, confidence, 
+                "Strong upward momentum detected"));
         }
-        
-        // Breakout detection
-        else if (isBreakout(data)) {
-            double breakout_confidence = 0.75;
-            if (data.price > data.bollinger_upper) {
-                signals.push_back(createSignal(data.symbol, SignalType::BUY, data.price, breakout_confidence, 
-                    "Bollinger Band breakout (upper)"));
-            } else if (data.price < data.bollinger_lower) {
-                signals.push_back(createSignal(data.symbol, SignalType::SELL, data.price, breakout_confidence, 
-                    "Bollinger Band breakout (lower)"));
-            }
+    }
+    
+    // Strong downward momentum
+    else if (short_momentum < -momentum_threshold && long_momentum < 0 && volatility < volatility_threshold) {
+        if (data.rsi > 30) { // Not oversold
+            double confidence = std::min(0.95, 0.5 + (std::abs(short_momentum) * 10));
+            sink.emit(createSignal(data.symbol, SignalType::SELL, data.price, confidence, 
+                "Strong downward momentum detected"));
         }
-        
-        // Mean reversion after extreme momentum
-        else if (std::abs(short_momentum) > momentum_threshold * 2 && volatility > volatility_threshold) {
-            double reversion_confidence = 0.65;
-            if (short_momentum > 0 && data.rsi > 80) {
-                signals.push_back(createSignal(data.symbol, SignalType::SELL, data.price, reversion_confidence, 
-                    "Mean reversion after extreme upward momentum"));
-            } else if (short_momentum < 0 && data.rsi < 20) {
-                signals.push_back(createSignal(data.symbol, SignalType::BUY, data.price, reversion_confidence, 
-                    "Mean reversion after extreme downward momentum"));
-            }
+    }
+    
+    // Breakout detection
+    else if (isBreakout(data)) {
+        double breakout_confidence = 0.75;
+        if (data.price > data.bollinger_upper) {
+            sink.emit(createSignal(data.symbol, SignalType::BUY, data.price, breakout_confidence, 
+                "Bollinger Band breakout (upper)"));
+        } else if (data.price < data.bollinger_lower) {
+            sink.emit(createSignal(data.symbol, SignalType::SELL, data.price, breakout_confidence, 
+                "Bollinger Band breakout (lower)"));
         }
     }
     
-    return signals;
+    // Mean reversion after extreme momentum
+    else if (std::abs(short_momentum) > momentum_threshold * 2 && volatility > volatility_threshold) {
+        double reversion_confidence = 0.65;
+        if (short_momentum > 0 && data.rsi > 80) {
+            sink.emit(createSignal(data.symbol, SignalType::SELL, data.price, reversion_confidence, 
+                "Mean reversion after extreme upward momentum"));
+        } else if (short_momentum < 0 && data.rsi < 20) {
+            sink.emit(createSignal(data.symbol, SignalType::BUY, data.price, reversion_confidence, 
+                "Mean reversion after extreme downward momentum"));
+        }
+    }
 }
 
 void MomentumStrategy::updatePosition(const Position& position) {
@@ -106,55 +116,49 @@ double MomentumStrategy::calculateRisk(const std::vector<Position>& positions) {
         // Calculate position risk based on volatility and position size
         double position_value = std::abs(position.quantity * position.current_price);
         
-        auto it = price_history_.find(position.symbol);
-        if (it != price_history_.end()) {
-            double volatility = calculateVolatility(position.symbol, 20);
-            double position_risk = position_value * volatility;
-            total_risk += position_risk;
-        }
+        double volatility = calculateVolatility(position.symbol);
+        double position_risk = position_value * volatility;
+        total_risk += position_risk;
     }
     
     return total_risk;
 }
 
-double MomentumStrategy::calculateMomentum(const std::string& symbol, int lookback_periods) {
-    auto it = price_history_.find(symbol);
-    if (it == price_history_.end() || it->second.prices.size() < lookback_periods + 1) {
-        return 0.0;
+void MomentumStrategy::updateReturns(SymbolState& state, const PriceSeries& series, uint64_t sequence) {
+    // In order this is one update; after a gap (strategy disabled, late
+    // subscription) the window is rebuilt from the shared history
+    uint64_t first = sequence == state.last_sequence + 1 ? sequence : 2;
+    if (first != sequence) {
+        state.returns.reset();
+        if (sequence > VOLATILITY_PERIODS) first = sequence - VOLATILITY_PERIODS + 2;
     }
     
-    const auto& prices = it->second.prices;
-    double current_price = prices.back();
-    double past_price = prices[prices.size() - lookback_periods - 1];
-    
-    return (current_price - past_price) / past_price;
+    for (uint64_t s = std::max<uint64_t>(first, 2); s <= sequence; s++) {
+        double previous = series.price(s - 1);
+        if (previous != 0.0) state.returns.update((series.price(s) - previous) / previous);
+    }
+    state.last_sequence = sequence;
 }
 
-double MomentumStrategy::calculateVolatility(const std::string& symbol, int lookback_periods) {
-    auto it = price_history_.find(symbol);
-    if (it == price_history_.end() || it->second.prices.size() < lookback_periods) {
+double MomentumStrategy::calculateMomentum(const PriceSeries& series, uint64_t sequence, int lookback_periods) {
+    if (sequence < static_cast<uint64_t>(lookback_periods) + 1) {
         return 0.0;
     }
     
-    const auto& prices = it->second.prices;
-    std::vector<double> returns;
-    
-    for (size_t i = prices.size() - lookback_periods; i < prices.size() - 1; ++i) {
-        double return_val = (prices[i + 1] - prices[i]) / prices[i];
-        returns.push_back(return_val);
-    }
-    
-    if (returns.empty()) return 0.0;
-    
-    double mean_return = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-    double variance = 0.0;
+    double current_price = series.price(sequence);
+    double past_price = series.price(sequence - lookback_periods);
     
-    for (double ret : returns) {
-        variance += (ret - mean_return) * (ret - mean_return);
+    return (current_price - past_price) / past_price;
+}
+
+double MomentumStrategy::calculateVolatility(const std::string& symbol) {
+    common::SymbolId symbol_id = common::SymbolRegistry::instance().find(symbol);
+    if (symbol_id >= symbol_state_.size() || symbol_state_[symbol_id].last_sequence < VOLATILITY_PERIODS) {
+        return 0.0;
     }
     
-    variance /= returns.size();
-    return std::sqrt(variance);
+    // Maintained per tick, so this is O(1) rather than a pass over the window
+    return symbol_state_[symbol_id].returns.stddev();
 }
 
 bool MomentumStrategy::isBreakout(const MarketData& data) {
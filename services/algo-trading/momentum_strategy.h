@@ -1,30 +1,37 @@
 #pragma once
 
 #include "algo_engine.h"
-#include <deque>
+#include "price_history.h"
+#include "streaming_indicators.h"
 
 namespace hedgefund {
 namespace algo {
 
-class MomentumStrategy : public TradingStrategy {
+class MomentumStrategy final : public StrategyBase<MomentumStrategy> {
 public:
     MomentumStrategy(const StrategyConfig& config);
     
-    std::vector<TradingSignal> generateSignals(const std::vector<MarketData>& market_data) override;
+    void onTick(const MarketData& data, SignalSink& sink) override;
     void updatePosition(const Position& position) override;
     double calculateRisk(const std::vector<Position>& positions) override;
     
 private:
-    struct PriceHistory {
-        std::deque<double> prices;
-        std::deque<std::chrono::system_clock::time_point> timestamps;
-        static const size_t MAX_HISTORY = 50;
+    static const int MIN_HISTORY = 20;
+    static const int VOLATILITY_PERIODS = 20;
+    
+    // What this strategy derives from a symbol's history; the prices themselves
+    // live in the shared PriceHistoryStore
+    struct SymbolState {
+        uint64_t last_sequence = 0;
+        RollingStats returns{VOLATILITY_PERIODS - 1};  // Returns across the volatility window
     };
     
-    std::unordered_map<std::string, PriceHistory> price_history_;
+    std::unique_ptr<PriceHistoryStore> own_history_;  // Only when no shared store is attached
+    std::vector<SymbolState> symbol_state_;           // Indexed by symbol id
     
-    double calculateMomentum(const std::string& symbol, int lookback_periods);
-    double calculateVolatility(const std::string& symbol, int lookback_periods);
+    void updateReturns(SymbolState& state, const PriceSeries& series, uint64_t sequence);
+    double calculateMomentum(const PriceSeries& series, uint64_t sequence, int lookback_periods);
+    double calculateVolatility(const std::string& symbol);
     bool isBreakout(const MarketData& data);
     TradingSignal createSignal(const std::string& symbol, SignalType type, double price, double confidence, const std::string& reason);
 };
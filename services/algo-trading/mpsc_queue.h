@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace hedgefund {
+namespace algo {
+
+// Unbounded lock-free multi-producer single-consumer queue (Vyukov). push()
+// is one atomic exchange and may be called from any thread; pop() must only
+// be called from the single consumer thread.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+    ~MpscQueue() {
+        T value;
+        while (pop(value)) {}
+        if (tail_ != &stub_) delete tail_;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T value) {
+        Node* node = new Node;
+        node->value = std::move(value);
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // False when empty, or when a producer is between its exchange and link
+    bool pop(T& value) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+
+        // next becomes the new dummy once its value is moved out
+        value = std::move(next->value);
+        tail_ = next;
+        if (tail != &stub_) delete tail;
+        return true;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    Node stub_;
+    alignas(64) std::atomic<Node*> head_;  // Producers
+    alignas(64) Node* tail_;               // Consumer
+};
+
+} // namespace algo
+} // namespace hedgefund
@@ -3,21 +3,30 @@
 #include <algorithm>
 #include <sstream>
 #include <iostream>
+#include <ctime>
 
 namespace hedgefund {
 namespace algo {
 
-OptionsStrategy::OptionsStrategy(const StrategyConfig& config) : TradingStrategy(config) {
+OptionsStrategy::OptionsStrategy(const StrategyConfig& config) : StrategyBase(config) {
     std::cout << "Initialized Options Strategy: " << config.name << std::endl;
     
+    // Sample chains list a single expiry 30 days out
+    std::time_t expiry = std::time(nullptr) + 30 * 24 * 3600;
+    char date[11];
+    std::strftime(date, sizeof(date), "%Y-%m-%d", std::localtime(&expiry));
+    sample_expiration_ = date;
+    
     // Initialize sample options chains for demonstration
     for (const auto& symbol : config.symbols) {
         OptionsChain chain;
         chain.underlying_symbol = symbol;
-        chain.expiration_date = "2024-03-15"; // Sample expiration
+        chain.expiration_date = sample_expiration_;
         
         // Generate strike prices around current price (assuming $150 for demo)
         double base_price = 150.0;
+        hedgefund::options::VolatilitySurface seed_surface(symbol);
+        int32_t seed_expiry = hedgefund::options::expiryDateAfter(30.0 / 365.0);
         for (int i = -10; i <= 10; i++) {
             double strike = base_price + (i * 5.0); // $5 intervals
             chain.strike_prices.push_back(strike);
@@ -25,115 +34,123 @@ OptionsStrategy::OptionsStrategy(const StrategyConfig& config) : TradingStrategy
             // Sample option prices (would come from market data in real implementation)
             chain.call_prices[strike] = std::max(0.1, base_price - strike + 5.0);
             chain.put_prices[strike] = std::max(0.1, strike - base_price + 5.0);
-            chain.implied_vols[strike] = 0.20 + (std::abs(strike - base_price) / base_price) * 0.1;
+            
+            hedgefund::options::VolQuote quote;
+            quote.strike_price = strike;
+            quote.expiry_date = seed_expiry;
+            quote.underlying_price = base_price;
+            quote.price = 0.0;
+            quote.implied_vol = 0.20 + (std::abs(strike - base_price) / base_price) * 0.1;
+            quote.is_call = strike >= base_price;
+            seed_surface.addQuote(quote);
+        }
+        chain.spot_price = base_price;
+        
+        // Read the shared surface; seed it only if no live surface has been published
+        auto shared_surface = hedgefund::options::VolatilitySurfaceRegistry::instance().get(symbol);
+        if (shared_surface->sequence() == 0) {
+            seed_surface.refit();
+            shared_surface->publish(seed_surface.snapshot());
         }
+        chain.volatility_reader = hedgefund::options::VolatilitySurfaceReader(shared_surface);
         
-        options_chains_[symbol] = chain;
+        common::SymbolId symbol_id = common::SymbolRegistry::instance().intern(symbol);
+        if (symbol_id != common::INVALID_SYMBOL) options_chains_[symbol_id] = chain;
     }
 }
 
-std::vector<TradingSignal> OptionsStrategy::generateSignals(const std::vector<MarketData>& market_data) {
-    std::vector<TradingSignal> signals;
+void OptionsStrategy::onTick(const MarketData& tick, SignalSink& sink) {
+    // Chains are indexed by symbol id; ticks from outside the engine may not carry one
+    MarketData resolved;
+    const MarketData* data_ptr = &tick;
+    if (tick.symbol_id == common::INVALID_SYMBOL) {
+        resolved = tick;
+        resolved.symbol_id = common::SymbolRegistry::instance().find(tick.symbol);
+        data_ptr = &resolved;
+    }
+    const MarketData& data = *data_ptr;
     
-    for (const auto& data : market_data) {
-        switch (config_.type) {
-            case StrategyType::OPTIONS_STRADDLE: {
-                auto straddle_signals = generateStraddleSignals(data);
-                signals.insert(signals.end(), straddle_signals.begin(), straddle_signals.end());
-                break;
-            }
+    OptionsChain* chain = options_chains_.find(data.symbol_id);
+    if (chain) {
+        if (data.price > 0.0) chain->spot_price = data.price;
+        // Picks up a newly published term structure; expiry factors age with the clock
+        chain->term_structure = hedgefund::options::TermStructureRegistry::instance().get(chain->underlying_symbol);
+        chain->tick++;
+    }
+    
+    switch (config_.type) {
+        case StrategyType::OPTIONS_STRADDLE:
+            generateStraddleSignals(data, sink);
+            break;
             
-            case StrategyType::OPTIONS_STRANGLE: {
-                auto strangle_signals = generateStrangleSignals(data);
-                signals.insert(signals.end(), strangle_signals.begin(), strangle_signals.end());
-                break;
-            }
+        case StrategyType::OPTIONS_STRANGLE:
+            generateStrangleSignals(data, sink);
+            break;
             
-            case StrategyType::COVERED_CALL: {
-                auto covered_call_signals = generateCoveredCallSignals(data);
-                signals.insert(signals.end(), covered_call_signals.begin(), covered_call_signals.end());
-                break;
-            }
+        case StrategyType::COVERED_CALL:
+            generateCoveredCallSignals(data, sink);
+            break;
             
-            case StrategyType::PROTECTIVE_PUT: {
-                auto protective_put_signals = generateProtectivePutSignals(data);
-                signals.insert(signals.end(), protective_put_signals.begin(), protective_put_signals.end());
-                break;
-            }
+        case StrategyType::PROTECTIVE_PUT:
+            generateProtectivePutSignals(data, sink);
+            break;
             
-            case StrategyType::IRON_CONDOR: {
-                auto iron_condor_signals = generateIronCondorSignals(data);
-                signals.insert(signals.end(), iron_condor_signals.begin(), iron_condor_signals.end());
-                break;
-            }
+        case StrategyType::IRON_CONDOR:
+            generateIronCondorSignals(data, sink);
+            break;
             
-            case StrategyType::BUTTERFLY_SPREAD: {
-                auto butterfly_signals = generateButterflySignals(data);
-                signals.insert(signals.end(), butterfly_signals.begin(), butterfly_signals.end());
-                break;
-            }
+        case StrategyType::BUTTERFLY_SPREAD:
+            generateButterflySignals(data, sink);
+            break;
             
-            default:
-                break;
-        }
+        default:
+            break;
     }
-    
-    return signals;
 }
 
-std::vector<TradingSignal> OptionsStrategy::generateStraddleSignals(const MarketData& data) {
-    std::vector<TradingSignal> signals;
-    
+void OptionsStrategy::generateStraddleSignals(const MarketData& data, SignalSink& sink) {
     // Long straddle: Buy call and put at same strike (ATM)
     // Best when expecting high volatility but uncertain about direction
     
-    if (isLowVolatility(data.symbol)) {
-        auto atm_strikes = getATMStrikes(data.symbol, data.price);
+    if (isLowVolatility(data.symbol_id)) {
+        auto atm_strikes = getATMStrikes(data.symbol_id, data.price);
         if (!atm_strikes.empty()) {
             double atm_strike = atm_strikes[0];
             
             // Buy ATM call
-            double call_price = calculateOptionPrice(data.symbol, atm_strike, true, "2024-03-15");
-            signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_CALL, atm_strike, 
-                true, "2024-03-15", call_price, 0.75, "Long straddle - expecting volatility increase"));
+            double call_price = calculateOptionPrice(data.symbol_id, atm_strike, true, sample_expiration_);
+            sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_CALL, atm_strike, 
+                true, sample_expiration_, call_price, 0.75, "Long straddle - expecting volatility increase"));
             
             // Buy ATM put
-            double put_price = calculateOptionPrice(data.symbol, atm_strike, false, "2024-03-15");
-            signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_PUT, atm_strike, 
-                false, "2024-03-15", put_price, 0.75, "Long straddle - expecting volatility increase"));
+            double put_price = calculateOptionPrice(data.symbol_id, atm_strike, false, sample_expiration_);
+            sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_PUT, atm_strike, 
+                false, sample_expiration_, put_price, 0.75, "Long straddle - expecting volatility increase"));
         }
     }
-    
-    return signals;
 }
 
-std::vector<TradingSignal> OptionsStrategy::generateStrangleSignals(const MarketData& data) {
-    std::vector<TradingSignal> signals;
-    
+void OptionsStrategy::generateStrangleSignals(const MarketData& data, SignalSink& sink) {
     // Long strangle: Buy OTM call and OTM put
     // Cheaper than straddle, needs larger move to be profitable
     
-    if (isLowVolatility(data.symbol)) {
+    if (isLowVolatility(data.symbol_id)) {
         double otm_call_strike = data.price + (data.price * 0.05); // 5% OTM call
         double otm_put_strike = data.price - (data.price * 0.05);  // 5% OTM put
         
         // Buy OTM call
-        double call_price = calculateOptionPrice(data.symbol, otm_call_strike, true, "2024-03-15");
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_CALL, otm_call_strike, 
-            true, "2024-03-15", call_price, 0.70, "Long strangle - expecting large price movement"));
+        double call_price = calculateOptionPrice(data.symbol_id, otm_call_strike, true, sample_expiration_);
+        sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_CALL, otm_call_strike, 
+            true, sample_expiration_, call_price, 0.70, "Long strangle - expecting large price movement"));
         
         // Buy OTM put
-        double put_price = calculateOptionPrice(data.symbol, otm_put_strike, false, "2024-03-15");
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_PUT, otm_put_strike, 
-            false, "2024-03-15", put_price, 0.70, "Long strangle - expecting large price movement"));
+        double put_price = calculateOptionPrice(data.symbol_id, otm_put_strike, false, sample_expiration_);
+        sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_PUT, otm_put_strike, 
+            false, sample_expiration_, put_price, 0.70, "Long strangle - expecting large price movement"));
     }
-    
-    return signals;
 }
 
-std::vector<TradingSignal> OptionsStrategy::generateCoveredCallSignals(const MarketData& data) {
-    std::vector<TradingSignal> signals;
-    
+void OptionsStrategy::generateCoveredCallSignals(const MarketData& data, SignalSink& sink) {
     // Covered call: Own stock + sell call
     // Generate income from stock holdings
     
@@ -148,18 +165,14 @@ std::vector<TradingSignal> OptionsStrategy::generateCoveredCallSignals(const Mar
     
     if (has_stock_position && data.rsi > 60) { // Slightly overbought
         double otm_call_strike = data.price + (data.price * 0.03); // 3% OTM
-        double call_price = calculateOptionPrice(data.symbol, otm_call_strike, true, "2024-03-15");
+        double call_price = calculateOptionPrice(data.symbol_id, otm_call_strike, true, sample_expiration_);
         
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::SELL_CALL, otm_call_strike, 
-            true, "2024-03-15", call_price, 0.80, "Covered call - generate income from stock position"));
+        sink.emit(createOptionsSignal(data.symbol, SignalType::SELL_CALL, otm_call_strike, 
+            true, sample_expiration_, call_price, 0.80, "Covered call - generate income from stock position"));
     }
-    
-    return signals;
 }
 
-std::vector<TradingSignal> OptionsStrategy::generateProtectivePutSignals(const MarketData& data) {
-    std::vector<TradingSignal> signals;
-    
+void OptionsStrategy::generateProtectivePutSignals(const MarketData& data, SignalSink& sink) {
     // Protective put: Own stock + buy put
     // Insurance against downside
     
@@ -171,54 +184,46 @@ std::vector<TradingSignal> OptionsStrategy::generateProtectivePutSignals(const M
         }
     }
     
-    if (has_stock_position && isHighVolatility(data.symbol)) {
+    if (has_stock_position && isHighVolatility(data.symbol_id)) {
         double otm_put_strike = data.price - (data.price * 0.05); // 5% OTM put
-        double put_price = calculateOptionPrice(data.symbol, otm_put_strike, false, "2024-03-15");
+        double put_price = calculateOptionPrice(data.symbol_id, otm_put_strike, false, sample_expiration_);
         
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_PUT, otm_put_strike, 
-            false, "2024-03-15", put_price, 0.85, "Protective put - hedge stock position"));
+        sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_PUT, otm_put_strike, 
+            false, sample_expiration_, put_price, 0.85, "Protective put - hedge stock position"));
     }
-    
-    return signals;
 }
 
-std::vector<TradingSignal> OptionsStrategy::generateIronCondorSignals(const MarketData& data) {
-    std::vector<TradingSignal> signals;
-    
+void OptionsStrategy::generateIronCondorSignals(const MarketData& data, SignalSink& sink) {
     // Iron condor: Sell ATM call/put, buy OTM call/put
     // Profit from low volatility and range-bound movement
     
-    if (isHighVolatility(data.symbol) && data.rsi > 40 && data.rsi < 60) { // Neutral market
+    if (isHighVolatility(data.symbol_id) && data.rsi > 40 && data.rsi < 60) { // Neutral market
         double atm_call_strike = data.price + (data.price * 0.01);
         double atm_put_strike = data.price - (data.price * 0.01);
         double otm_call_strike = data.price + (data.price * 0.05);
         double otm_put_strike = data.price - (data.price * 0.05);
         
         // Sell ATM options
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::SELL_CALL, atm_call_strike, 
-            true, "2024-03-15", calculateOptionPrice(data.symbol, atm_call_strike, true, "2024-03-15"), 
+        sink.emit(createOptionsSignal(data.symbol, SignalType::SELL_CALL, atm_call_strike, 
+            true, sample_expiration_, calculateOptionPrice(data.symbol_id, atm_call_strike, true, sample_expiration_), 
             0.75, "Iron condor - sell ATM call"));
         
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::SELL_PUT, atm_put_strike, 
-            false, "2024-03-15", calculateOptionPrice(data.symbol, atm_put_strike, false, "2024-03-15"), 
+        sink.emit(createOptionsSignal(data.symbol, SignalType::SELL_PUT, atm_put_strike, 
+            false, sample_expiration_, calculateOptionPrice(data.symbol_id, atm_put_strike, false, sample_expiration_), 
             0.75, "Iron condor - sell ATM put"));
         
         // Buy OTM options for protection
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_CALL, otm_call_strike, 
-            true, "2024-03-15", calculateOptionPrice(data.symbol, otm_call_strike, true, "2024-03-15"), 
+        sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_CALL, otm_call_strike, 
+            true, sample_expiration_, calculateOptionPrice(data.symbol_id, otm_call_strike, true, sample_expiration_), 
             0.75, "Iron condor - buy OTM call protection"));
         
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_PUT, otm_put_strike, 
-            false, "2024-03-15", calculateOptionPrice(data.symbol, otm_put_strike, false, "2024-03-15"), 
+        sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_PUT, otm_put_strike, 
+            false, sample_expiration_, calculateOptionPrice(data.symbol_id, otm_put_strike, false, sample_expiration_), 
             0.75, "Iron condor - buy OTM put protection"));
     }
-    
-    return signals;
 }
 
-std::vector<TradingSignal> OptionsStrategy::generateButterflySignals(const MarketData& data) {
-    std::vector<TradingSignal> signals;
-    
+void OptionsStrategy::generateButterflySignals(const MarketData& data, SignalSink& sink) {
     // Butterfly spread: Buy 1 ITM, sell 2 ATM, buy 1 OTM
     // Profit when stock stays near middle strike
     
@@ -228,22 +233,20 @@ std::vector<TradingSignal> OptionsStrategy::generateButterflySignals(const Marke
         double otm_strike = data.price + (data.price * 0.03);
         
         // Buy ITM call
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_CALL, itm_strike, 
-            true, "2024-03-15", calculateOptionPrice(data.symbol, itm_strike, true, "2024-03-15"), 
+        sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_CALL, itm_strike, 
+            true, sample_expiration_, calculateOptionPrice(data.symbol_id, itm_strike, true, sample_expiration_), 
             0.70, "Butterfly spread - buy ITM call"));
         
         // Sell 2 ATM calls
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::SELL_CALL, atm_strike, 
-            true, "2024-03-15", calculateOptionPrice(data.symbol, atm_strike, true, "2024-03-15"), 
+        sink.emit(createOptionsSignal(data.symbol, SignalType::SELL_CALL, atm_strike, 
+            true, sample_expiration_, calculateOptionPrice(data.symbol_id, atm_strike, true, sample_expiration_), 
             0.70, "Butterfly spread - sell ATM calls"));
         
         // Buy OTM call
-        signals.push_back(createOptionsSignal(data.symbol, SignalType::BUY_CALL, otm_strike, 
-            true, "2024-03-15", calculateOptionPrice(data.symbol, otm_strike, true, "2024-03-15"), 
+        sink.emit(createOptionsSignal(data.symbol, SignalType::BUY_CALL, otm_strike, 
+            true, sample_expiration_, calculateOptionPrice(data.symbol_id, otm_strike, true, sample_expiration_), 
             0.70, "Butterfly spread - buy OTM call"));
     }
-    
-    return signals;
 }
 
 void OptionsStrategy::updatePosition(const Position& position) {
@@ -283,45 +286,67 @@ double OptionsStrategy::calculateRisk(const std::vector<Position>& positions) {
     return total_risk;
 }
 
-double OptionsStrategy::calculateOptionPrice(const std::string& symbol, double strike, bool is_call, const std::string& expiration) {
-    // Simplified option pricing using Black-Scholes
+double OptionsStrategy::calculateOptionPrice(common::SymbolId symbol_id, double strike, bool is_call, const std::string& expiration) {
+    // Black-Scholes at the surface volatility for this strike and expiry
     hedgefund::options::OptionParams params;
-    params.spot_price = 150.0; // Would get from market data
+    params.spot_price = 150.0;
     params.strike_price = strike;
-    params.time_to_expiry = getTimeToExpiration(expiration);
+    params.time_to_expiry = 0.0;
     params.risk_free_rate = 0.05;
-    params.volatility = 0.20; // Would get implied volatility
+    params.volatility = 0.20;
     params.is_call = is_call;
     
+    OptionsChain* chain = options_chains_.find(symbol_id);
+    if (!chain) {
+        params.time_to_expiry = getTimeToExpiration(expiration);
+        return hedgefund::options::BlackScholes::calculatePrice(params);
+    }
+    
+    // Time and carry to this expiry are shared by every contract priced on the tick
+    auto& terms = chain->expiry_terms[expiration];
+    if (terms.tick != chain->tick) {
+        terms.tick = chain->tick;
+        terms.time_to_expiry = getTimeToExpiration(expiration);
+        if (chain->term_structure) terms.factors = chain->term_structure->factors(terms.time_to_expiry);
+    }
+    params.time_to_expiry = terms.time_to_expiry;
+    params.spot_price = chain->spot_price;
+    
+    // Lock-free read of the latest published surface; never blocks on a refit
+    const auto* surface = chain->volatility_reader.get();
+    double surface_vol = surface ? surface->getVolatility(strike, params.time_to_expiry, params.spot_price) : 0.0;
+    if (surface_vol > 0.0) params.volatility = surface_vol;
+    
+    // Curve rate, dividends and borrow when the symbol has a published term structure
+    if (chain->term_structure) {
+        params = hedgefund::options::TermStructure::apply(params, terms.factors);
+    }
+    
     return hedgefund::options::BlackScholes::calculatePrice(params);
 }
 
-bool OptionsStrategy::isHighVolatility(const std::string& symbol) {
-    auto it = options_chains_.find(symbol);
-    if (it != options_chains_.end()) {
-        double avg_iv = 0.0;
-        for (const auto& [strike, iv] : it->second.implied_vols) {
-            avg_iv += iv;
+bool OptionsStrategy::isHighVolatility(common::SymbolId symbol_id) {
+    if (OptionsChain* chain = options_chains_.find(symbol_id)) {
+        const auto* surface = chain->volatility_reader.get();
+        if (surface && !surface->empty()) {
+            return surface->getATMVolatility(30.0 / 365.0) > 0.25; // 25% threshold
         }
-        avg_iv /= it->second.implied_vols.size();
-        return avg_iv > 0.25; // 25% threshold
     }
     return false;
 }
 
-bool OptionsStrategy::isLowVolatility(const std::string& symbol) {
-    return !isHighVolatility(symbol);
+bool OptionsStrategy::isLowVolatility(common::SymbolId symbol_id) {
+    return !isHighVolatility(symbol_id);
 }
 
 double OptionsStrategy::getTimeToExpiration(const std::string& expiration_date) {
-    // Simplified - assume 30 days to expiration
-    return 30.0 / 365.0;
+    // Expired (or unparseable) dates price at intrinsic value
+    return std::max(0.0, hedgefund::options::yearsToExpiry(expiration_date));
 }
 
-std::vector<double> OptionsStrategy::getATMStrikes(const std::string& symbol, double spot_price) {
-    auto it = options_chains_.find(symbol);
-    if (it != options_chains_.end()) {
-        auto& strikes = it->second.strike_prices;
+std::vector<double> OptionsStrategy::getATMStrikes(common::SymbolId symbol_id, double spot_price) {
+    if (OptionsChain* chain = options_chains_.find(symbol_id)) {
+        auto& strikes = chain->strike_prices;
         auto closest = std::min_element(strikes.begin(), strikes.end(),
             [spot_price](double a, double b) {
                 return std::abs(a - spot_price) < std::abs(b - spot_price);
@@ -2,15 +2,17 @@
 
 #include "algo_engine.h"
 #include "../options/black_scholes.h"
+#include "../options/volatility_surface.h"
+#include "../options/term_structure.h"
 
 namespace hedgefund {
 namespace algo {
 
-class OptionsStrategy : public TradingStrategy {
+class OptionsStrategy final : public StrategyBase<OptionsStrategy> {
 public:
     OptionsStrategy(const StrategyConfig& config);
     
-    std::vector<TradingSignal> generateSignals(const std::vector<MarketData>& market_data) override;
+    void onTick(const MarketData& tick, SignalSink& sink) override;
     void updatePosition(const Position& position) override;
     double calculateRisk(const std::vector<Position>& positions) override;
     
@@ -21,26 +23,39 @@ private:
         std::string expiration_date;
         std::unordered_map<double, double> call_prices;
         std::unordered_map<double, double> put_prices;
-        std::unordered_map<double, double> implied_vols;
+        hedgefund::options::VolatilitySurfaceReader volatility_reader;
+        double spot_price = 0.0;
+        
+        // Term structure (null if none is published) and per-expiry time and
+        // factors, fetched once per tick rather than per contract priced
+        struct ExpiryTerms {
+            uint64_t tick = 0;  // Tick the entry was computed on
+            double time_to_expiry = 0.0;
+            hedgefund::options::ExpiryFactors factors;
+        };
+        std::shared_ptr<const hedgefund::options::TermStructure> term_structure;
+        std::unordered_map<std::string, ExpiryTerms> expiry_terms;  // By expiration date
+        uint64_t tick = 1;  // Starts past ExpiryTerms::tick so new entries are computed
     };
     
-    std::unordered_map<std::string, OptionsChain> options_chains_;
+    common::SymbolTable<OptionsChain> options_chains_;
+    std::string sample_expiration_;  // YYYY-MM-DD
     
     // Strategy implementations
-    std::vector<TradingSignal> generateStraddleSignals(const MarketData& data);
-    std::vector<TradingSignal> generateStrangleSignals(const MarketData& data);
-    std::vector<TradingSignal> generateCoveredCallSignals(const MarketData& data);
-    std::vector<TradingSignal> generateProtectivePutSignals(const MarketData& data);
-    std::vector<TradingSignal> generateIronCondorSignals(const MarketData& data);
-    std::vector<TradingSignal> generateButterflySignals(const MarketData& data);
+    void generateStraddleSignals(const MarketData& data, SignalSink& sink);
+    void generateStrangleSignals(const MarketData& data, SignalSink& sink);
+    void generateCoveredCallSignals(const MarketData& data, SignalSink& sink);
+    void generateProtectivePutSignals(const MarketData& data, SignalSink& sink);
+    void generateIronCondorSignals(const MarketData& data, SignalSink& sink);
+    void generateButterflySignals(const MarketData& data, SignalSink& sink);
     
     // Helper functions
     double calculateImpliedVolatility(const std::string& symbol, double strike, bool is_call, double market_price);
-    double calculateOptionPrice(const std::string& symbol, double strike, bool is_call, const std::string& expiration);
-    bool isHighVolatility(const std::string& symbol);
-    bool isLowVolatility(const std::string& symbol);
+    double calculateOptionPrice(common::SymbolId symbol_id, double strike, bool is_call, const std::string& expiration);
+    bool isHighVolatility(common::SymbolId symbol_id);
+    bool isLowVolatility(common::SymbolId symbol_id);
     double getTimeToExpiration(const std::string& expiration_date);
-    std::vector<double> getATMStrikes(const std::string& symbol, double spot_price);
+    std::vector<double> getATMStrikes(common::SymbolId symbol_id, double spot_price);
     
     TradingSignal createOptionsSignal(const std::string& symbol, SignalType type, double strike, 
                                     bool is_call, const std::string& expiration, double price, 
@@ -0,0 +1,66 @@
+#include "order_gateway.h"
+#include <algorithm>
+
+namespace hedgefund {
+namespace algo {
+
+void MessageOrderGateway::sendBatch(const std::vector<common::OrderMessage>& orders) {
+    mq_.publish("orders.batch", common::encodeOrderBatch(orders));
+}
+
+void MessageOrderGateway::sendCancel(const std::string& order_id, const std::string&) {
+    mq_.publish("orders.cancel", order_id);
+}
+
+void InProcessOrderGateway::addBook(const std::string& symbol, std::shared_ptr<orderbook::OrderBook> book) {
+    books_[symbol] = std::move(book);
+}
+
+void InProcessOrderGateway::sendBatch(const std::vector<common::OrderMessage>& orders) {
+    std::vector<orderbook::OrderBook*> touched;
+    
+    for (const auto& order : orders) {
+        auto it = books_.find(order.symbol);
+        if (it == books_.end()) {
+            report(ExecutionReport::Type::REJECT, order.order_id);
+            continue;
+        }
+        
+        it->second->addOrder(std::make_shared<orderbook::Order>(
+            order.order_id, order.symbol, orderbook::OrderType::LIMIT,
+            order.buy ? orderbook::OrderSide::BUY : orderbook::OrderSide::SELL,
+            order.price, order.quantity, "ALGO"));
+        report(ExecutionReport::Type::ACK, order.order_id);
+        
+        if (std::find(touched.begin(), touched.end(), it->second.get()) == touched.end()) {
+            touched.push_back(it->second.get());
+        }
+    }
+    
+    // Both sides are reported; the OrderManager ignores ids it did not send
+    for (auto* book : touched) {
+        for (const auto& trade : book->matchOrders()) {
+            report(ExecutionReport::Type::FILL, trade.buy_order_id, trade.price, trade.quantity);
+            report(ExecutionReport::Type::FILL, trade.sell_order_id, trade.price, trade.quantity);
+        }
+    }
+}
+
+void InProcessOrderGateway::sendCancel(const std::string& order_id, const std::string& symbol) {
+    auto it = books_.find(symbol);
+    if (it != books_.end()) it->second->cancelOrder(order_id);
+}
+
+void InProcessOrderGateway::report(ExecutionReport::Type type, const std::string& order_id, double price,
+                                   double quantity) {
+    ExecutionReport execution;
+    execution.type = type;
+    execution.order_id = order_id;
+    execution.price = price;
+    execution.quantity = quantity;
+    execution.received = std::chrono::system_clock::now();
+    on_report_(execution);
+}
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "algo_engine.h"
+#include "../orderbook/orderbook.h"
+#include "common/messaging.h"
+#include "common/order_messages.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hedgefund {
+namespace algo {
+
+// Where the OrderManager sends each batch of new orders, and cancels for
+// orders it has given up on
+class OrderGateway {
+public:
+    virtual ~OrderGateway() = default;
+    virtual void sendBatch(const std::vector<common::OrderMessage>& orders) = 0;
+    virtual void sendCancel(const std::string& order_id, const std::string& symbol) = 0;
+};
+
+// Publishes a batch as one orders.batch message and a cancel on
+// orders.cancel; acks and fills come back on orders.ack and trades.executed
+class MessageOrderGateway : public OrderGateway {
+public:
+    explicit MessageOrderGateway(common::MessageQueue& mq) : mq_(mq) {}
+    
+    void sendBatch(const std::vector<common::OrderMessage>& orders) override;
+    void sendCancel(const std::string& order_id, const std::string& symbol) override;
+    
+private:
+    common::MessageQueue& mq_;
+};
+
+// Hands orders straight to order books in this process when the engine is
+// co-located with them, then matches the books it touched. Acks and fills
+// are reported synchronously from sendBatch. Symbols without a book are
+// rejected.
+class InProcessOrderGateway : public OrderGateway {
+public:
+    using ReportCallback = std::function<void(const ExecutionReport&)>;
+    
+    explicit InProcessOrderGateway(ReportCallback on_report) : on_report_(std::move(on_report)) {}
+    
+    void addBook(const std::string& symbol, std::shared_ptr<orderbook::OrderBook> book);
+    void sendBatch(const std::vector<common::OrderMessage>& orders) override;
+    void sendCancel(const std::string& order_id, const std::string& symbol) override;
+    
+private:
+    ReportCallback on_report_;
+    std::unordered_map<std::string, std::shared_ptr<orderbook::OrderBook>> books_;
+    
+    void report(ExecutionReport::Type type, const std::string& order_id, double price = 0.0, double quantity = 0.0);
+};
+
+} // namespace algo
+} // namespace hedgefund
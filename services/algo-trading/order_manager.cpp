@@ -0,0 +1,147 @@
+#include "order_manager.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+namespace hedgefund {
+namespace algo {
+
+void LatencyStat::add(std::chrono::system_clock::duration elapsed) {
+    double us = std::chrono::duration<double, std::micro>(elapsed).count();
+    count++;
+    total_us += us;
+    max_us = std::max(max_us, us);
+}
+
+const ManagedOrder* OrderManager::submit(const TradingSignal& signal, const ContractKey& contract, double quantity,
+                                         double limit_price, uint64_t parent_id) {
+    if (quantity == 0.0) return nullptr;
+    
+    ManagedOrder order;
+    order.id = "ALGO_" + std::to_string(next_order_id_++);
+    order.parent_id = parent_id;
+    order.strategy_id = signal.strategy_id;
+    order.symbol = signal.symbol;
+    order.expiration_date = signal.expiration_date;
+    order.contract = contract;
+    order.buy = quantity > 0.0;
+    order.price = limit_price > 0.0 ? limit_price : signal.price;
+    order.quantity = std::abs(quantity);
+    order.signal_time = signal.timestamp.time_since_epoch().count() != 0 ? signal.timestamp
+                                                                          : std::chrono::system_clock::now();
+    
+    if (contract.isOption()) {
+        std::ostringstream instrument;
+        instrument << signal.symbol << ' ' << signal.expiration_date << (contract.kind == 1 ? " C " : " P ")
+                   << signal.strike_price;
+        order.instrument = instrument.str();
+    } else {
+        order.instrument = signal.symbol;
+    }
+    
+    auto inserted = orders_.emplace(order.id, std::move(order));
+    outgoing_.push_back(&inserted.first->second);
+    return &inserted.first->second;
+}
+
+size_t OrderManager::flush() {
+    for (const auto& id : done_) {
+        orders_.erase(id);
+    }
+    done_.clear();
+    
+    if (outgoing_.empty()) return 0;
+    
+    auto now = std::chrono::system_clock::now();
+    batch_.clear();
+    for (ManagedOrder* order : outgoing_) {
+        order->state = OrderState::SENT;
+        order->sent_time = now;
+        signal_to_send_.add(now - order->signal_time);
+        batch_.push_back(common::OrderMessage{order->id, order->instrument, order->buy, order->price, order->quantity});
+    }
+    size_t sent = outgoing_.size();
+    outgoing_.clear();
+    
+    if (gateway_) {
+        for (const auto& message : batch_) {
+            awaiting_ack_.push_back(AwaitingAck{now, message.order_id});
+        }
+        gateway_->sendBatch(batch_);
+    } else {
+        std::cout << "No order gateway; rejecting " << sent << " orders" << std::endl;
+        for (const auto& message : batch_) {
+            orders_[message.order_id].state = OrderState::REJECTED;
+            done_.push_back(message.order_id);
+        }
+    }
+    return sent;
+}
+
+const ManagedOrder* OrderManager::apply(const ExecutionReport& report, double& filled) {
+    filled = 0.0;
+    auto it = orders_.find(report.order_id);
+    if (it == orders_.end() || it->second.isDone()) return nullptr;
+    ManagedOrder& order = it->second;
+    
+    switch (report.type) {
+        case ExecutionReport::Type::ACK:
+            if (order.state == OrderState::SENT) {
+                order.state = OrderState::ACKNOWLEDGED;
+                send_to_ack_.add(report.received - order.sent_time);
+            }
+            break;
+            
+        case ExecutionReport::Type::REJECT:
+            order.state = OrderState::REJECTED;
+            done_.push_back(order.id);
+            break;
+            
+        case ExecutionReport::Type::FILL: {
+            filled = std::min(report.quantity, order.remainingQuantity());
+            if (filled <= 0.0) {
+                filled = 0.0;
+                break;
+            }
+            order.average_fill_price = (order.average_fill_price * order.filled_quantity + report.price * filled) /
+                                       (order.filled_quantity + filled);
+            order.filled_quantity += filled;
+            
+            if (order.remainingQuantity() <= 1e-9) {
+                order.state = OrderState::FILLED;
+                signal_to_fill_.add(report.received - order.signal_time);
+                done_.push_back(order.id);
+            } else {
+                order.state = OrderState::PARTIALLY_FILLED;
+            }
+            break;
+        }
+    }
+    return &order;
+}
+
+const std::vector<const ManagedOrder*>& OrderManager::expireUnacknowledged(
+    std::chrono::system_clock::time_point now) {
+    expired_.clear();
+    while (!awaiting_ack_.empty() && now - awaiting_ack_.front().sent_time >= ack_timeout_) {
+        auto it = orders_.find(awaiting_ack_.front().order_id);
+        awaiting_ack_.pop_front();
+        if (it == orders_.end() || it->second.state != OrderState::SENT) continue;
+        
+        ManagedOrder& order = it->second;
+        order.state = OrderState::EXPIRED;
+        done_.push_back(order.id);
+        if (gateway_) gateway_->sendCancel(order.id, order.instrument);
+        expired_.push_back(&order);
+    }
+    return expired_;
+}
+
+const ManagedOrder* OrderManager::find(const std::string& order_id) const {
+    auto it = orders_.find(order_id);
+    return it != orders_.end() ? &it->second : nullptr;
+}
+
+} // namespace algo
+} // namespace hedgefund
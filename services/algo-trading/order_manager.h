@@ -0,0 +1,123 @@
+#pragma once
+
+#include "algo_engine.h"
+#include "order_gateway.h"
+#include "position_book.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hedgefund {
+namespace algo {
+
+enum class OrderState {
+    PENDING_NEW,       // Waiting for the next flush
+    SENT,
+    ACKNOWLEDGED,
+    PARTIALLY_FILLED,
+    FILLED,
+    REJECTED,
+    EXPIRED            // No ack within the ack timeout; cancelled
+};
+
+struct ManagedOrder {
+    std::string id;
+    uint64_t parent_id = 0;    // ExecutionScheduler parent for child slices, 0 otherwise
+    std::string strategy_id;
+    std::string symbol;        // Underlying
+    std::string instrument;    // Symbol on the wire; options add expiry, type and strike
+    std::string expiration_date;
+    ContractKey contract;
+    bool buy = true;
+    double price = 0.0;        // Limit price
+    double quantity = 0.0;
+    double filled_quantity = 0.0;
+    double average_fill_price = 0.0;
+    OrderState state = OrderState::PENDING_NEW;
+    
+    std::chrono::system_clock::time_point signal_time;
+    std::chrono::system_clock::time_point sent_time;
+    
+    double remainingQuantity() const { return quantity - filled_quantity; }
+    bool isDone() const {
+        return state == OrderState::FILLED || state == OrderState::REJECTED || state == OrderState::EXPIRED;
+    }
+};
+
+// Count, mean and worst case of one latency, in microseconds
+struct LatencyStat {
+    uint64_t count = 0;
+    double total_us = 0.0;
+    double max_us = 0.0;
+    
+    void add(std::chrono::system_clock::duration elapsed);
+    double meanMicros() const { return count ? total_us / count : 0.0; }
+};
+
+// Turns validated signals into orders and follows them through acks and
+// fills. Orders submitted between flushes leave as one gateway batch, so a
+// burst of signals from one tick costs one send. Engine thread only.
+class OrderManager {
+public:
+    void setGateway(std::unique_ptr<OrderGateway> gateway) { gateway_ = std::move(gateway); }
+    
+    // How long a sent order may wait for its ack before it is expired
+    void setAckTimeout(std::chrono::milliseconds timeout) { ack_timeout_ = timeout; }
+    
+    // Queues a limit order for quantity (positive buys) at limit_price, or
+    // the signal price when it is 0
+    const ManagedOrder* submit(const TradingSignal& signal, const ContractKey& contract, double quantity,
+                               double limit_price = 0.0, uint64_t parent_id = 0);
+    
+    // Sends everything queued since the last flush as one batch and forgets
+    // finished orders; returns the number sent
+    size_t flush();
+    
+    // Applies an ack, reject or fill. Returns the order, valid until the next
+    // flush, or nullptr for ids this manager did not send. filled is the
+    // quantity a fill added, after clamping to what was left.
+    const ManagedOrder* apply(const ExecutionReport& report, double& filled);
+    
+    // Expires orders still unacknowledged ack timeout after they were sent,
+    // so a lost batch or ack cannot leave them open, and sends a cancel for
+    // each in case the book has them after all. Later reports for them are
+    // ignored. Returns the expired orders, valid until the next flush.
+    const std::vector<const ManagedOrder*>& expireUnacknowledged(std::chrono::system_clock::time_point now);
+    
+    const ManagedOrder* find(const std::string& order_id) const;
+    size_t openOrders() const { return orders_.size() - done_.size(); }
+    
+    // Signal to batch send, send to ack, and signal to complete fill
+    const LatencyStat& signalToSend() const { return signal_to_send_; }
+    const LatencyStat& sendToAck() const { return send_to_ack_; }
+    const LatencyStat& signalToFill() const { return signal_to_fill_; }
+    
+private:
+    std::unique_ptr<OrderGateway> gateway_;
+    std::unordered_map<std::string, ManagedOrder> orders_;
+    std::vector<ManagedOrder*> outgoing_;       // Submitted since the last flush
+    std::vector<std::string> done_;             // Finished since the last flush
+    std::vector<common::OrderMessage> batch_;   // Reused by flush
+    uint64_t next_order_id_ = 1;
+    
+    // Sent orders in send order, so the overdue ones are always at the
+    // front; entries for orders acked or finished since are skipped
+    struct AwaitingAck {
+        std::chrono::system_clock::time_point sent_time;
+        std::string order_id;
+    };
+    std::deque<AwaitingAck> awaiting_ack_;
+    std::chrono::milliseconds ack_timeout_{5000};
+    std::vector<const ManagedOrder*> expired_;  // Returned by expireUnacknowledged
+    
+    LatencyStat signal_to_send_;
+    LatencyStat send_to_ack_;
+    LatencyStat signal_to_fill_;
+};
+
+} // namespace algo
+} // namespace hedgefund
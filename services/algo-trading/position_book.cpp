@@ -0,0 +1,187 @@
+#include "position_book.h"
+#include <cmath>
+#include <algorithm>
+#include <functional>
+
+namespace hedgefund {
+namespace algo {
+
+ContractKey ContractKey::underlying(common::SymbolId symbol_id) {
+    ContractKey key;
+    key.symbol_id = symbol_id;
+    return key;
+}
+
+ContractKey ContractKey::option(common::SymbolId symbol_id, const std::string& expiration_date,
+                                double strike_price, bool is_call) {
+    ContractKey key;
+    key.symbol_id = symbol_id;
+    key.strike_price = strike_price;
+    key.kind = is_call ? 1 : 2;
+
+    // YYYY-MM-DD -> YYYYMMDD; anything else keys as expiry 0
+    for (char c : expiration_date) {
+        if (c >= '0' && c <= '9') {
+            key.expiry = key.expiry * 10 + (c - '0');
+        } else if (c != '-') {
+            key.expiry = 0;
+            break;
+        }
+    }
+    return key;
+}
+
+size_t ContractKeyHash::operator()(const ContractKey& key) const {
+    size_t hash = std::hash<uint64_t>()((static_cast<uint64_t>(key.symbol_id) << 32) |
+                                        static_cast<uint32_t>(key.expiry));
+    hash ^= std::hash<double>()(key.strike_price) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash ^ key.kind;
+}
+
+double PositionBook::applyFill(const ContractKey& key, const std::string& symbol, double quantity, double price,
+                               std::chrono::system_clock::time_point time, const std::string& expiration_date) {
+    if (quantity == 0.0) return 0.0;
+
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        Position position;
+        position.symbol = symbol;
+        position.symbol_id = key.symbol_id;
+        position.quantity = 0.0;
+        position.average_price = price;
+        position.current_price = price;
+        position.unrealized_pnl = 0.0;
+        position.entry_time = time;
+        position.is_option = key.isOption();
+        position.strike_price = key.strike_price;
+        position.expiration_date = expiration_date;
+        position.is_call = key.kind != 2;
+
+        size_t slot = positions_.size();
+        positions_.push_back(position);
+        keys_.push_back(key);
+        it = index_.emplace(key, slot).first;
+        if (!key.isOption()) by_symbol_[key.symbol_id].push_back(slot);
+    }
+
+    const size_t slot = it->second;
+    Position& position = positions_[slot];
+    double realized = 0.0;
+    untrack(position);
+
+    if (position.quantity == 0.0 || (position.quantity > 0.0) == (quantity > 0.0)) {
+        // Adding to the position (or opening it)
+        double total = std::abs(position.quantity) + std::abs(quantity);
+        position.average_price = (position.average_price * std::abs(position.quantity) +
+                                  price * std::abs(quantity)) / total;
+        position.quantity += quantity;
+    } else {
+        // Reducing: the closed part realizes against the average price
+        double closed = std::min(std::abs(quantity), std::abs(position.quantity));
+        double direction = position.quantity > 0.0 ? 1.0 : -1.0;
+        realized = (price - position.average_price) * closed * direction;
+        position.realized_pnl += realized;
+        realized_total_ += realized;
+
+        double remaining = position.quantity + quantity;
+        if (std::abs(remaining) < 1e-12) {
+            position.quantity = 0.0;
+            remove(slot);
+            resum();
+            return realized;
+        }
+        if ((remaining > 0.0) != (position.quantity > 0.0)) {
+            position.average_price = price;  // Flipped: the remainder opened at this fill
+            position.entry_time = time;
+        }
+        position.quantity = remaining;
+    }
+
+    // Options take the fill as their mark; underlyings keep the last tick
+    if (key.isOption()) position.current_price = price;
+    position.unrealized_pnl = (position.current_price - position.average_price) * position.quantity;
+    track(position);
+    return realized;
+}
+
+double PositionBook::close(const ContractKey& key, double price) {
+    auto it = index_.find(key);
+    if (it == index_.end()) return 0.0;
+    const Position position = positions_[it->second];
+    return applyFill(key, position.symbol, -position.quantity, price, position.entry_time, position.expiration_date);
+}
+
+void PositionBook::markPrice(common::SymbolId symbol_id, double price) {
+    const auto* slots = by_symbol_.find(symbol_id);
+    if (!slots) return;
+    for (size_t slot : *slots) {
+        mark(slot, price);
+    }
+}
+
+void PositionBook::markContract(const ContractKey& key, double price) {
+    auto it = index_.find(key);
+    if (it != index_.end()) mark(it->second, price);
+}
+
+const Position* PositionBook::find(const ContractKey& key) const {
+    auto it = index_.find(key);
+    return it != index_.end() ? &positions_[it->second] : nullptr;
+}
+
+void PositionBook::mark(size_t slot, double price) {
+    Position& position = positions_[slot];
+    untrack(position);
+    position.current_price = price;
+    position.unrealized_pnl = (price - position.average_price) * position.quantity;
+    track(position);
+}
+
+void PositionBook::track(const Position& position) {
+    unrealized_total_ += position.unrealized_pnl;
+    exposure_total_ += std::abs(position.current_price * position.quantity);
+    // Every position is tracked again by now, so the sums are consistent
+    if (++updates_ >= RESUM_INTERVAL) resum();
+}
+
+void PositionBook::untrack(const Position& position) {
+    unrealized_total_ -= position.unrealized_pnl;
+    exposure_total_ -= std::abs(position.current_price * position.quantity);
+}
+
+void PositionBook::resum() {
+    unrealized_total_ = 0.0;
+    exposure_total_ = 0.0;
+    for (const auto& position : positions_) {
+        unrealized_total_ += position.unrealized_pnl;
+        exposure_total_ += std::abs(position.current_price * position.quantity);
+    }
+    updates_ = 0;
+}
+
+// Callers untrack the position first
+void PositionBook::remove(size_t slot) {
+    const ContractKey key = keys_[slot];
+    index_.erase(key);
+    if (!key.isOption()) {
+        auto& slots = by_symbol_[key.symbol_id];
+        slots.erase(std::find(slots.begin(), slots.end(), slot));
+    }
+
+    // Move the last position into the hole and repoint its index entries
+    const size_t last = positions_.size() - 1;
+    if (slot != last) {
+        positions_[slot] = std::move(positions_[last]);
+        keys_[slot] = keys_[last];
+        index_[keys_[slot]] = slot;
+        if (!keys_[slot].isOption()) {
+            auto& slots = by_symbol_[keys_[slot].symbol_id];
+            *std::find(slots.begin(), slots.end(), last) = slot;
+        }
+    }
+    positions_.pop_back();
+    keys_.pop_back();
+}
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "algo_engine.h"
+#include "common/symbol_registry.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hedgefund {
+namespace algo {
+
+// Identifies one netted position: the underlying, or one listed option on it
+struct ContractKey {
+    common::SymbolId symbol_id = common::INVALID_SYMBOL;
+    int32_t expiry = 0;         // YYYYMMDD, 0 for the underlying
+    double strike_price = 0.0;
+    uint8_t kind = 0;           // 0 underlying, 1 call, 2 put
+
+    static ContractKey underlying(common::SymbolId symbol_id);
+    static ContractKey option(common::SymbolId symbol_id, const std::string& expiration_date,
+                              double strike_price, bool is_call);
+
+    bool isOption() const { return kind != 0; }
+    bool operator==(const ContractKey& other) const {
+        return symbol_id == other.symbol_id && expiry == other.expiry &&
+               strike_price == other.strike_price && kind == other.kind;
+    }
+};
+
+struct ContractKeyHash {
+    size_t operator()(const ContractKey& key) const;
+};
+
+// Netted positions with average-price accounting. Marks touch only the
+// positions on the symbol that ticked, and portfolio unrealized P&L,
+// realized P&L and gross exposure are kept as running totals, so reading
+// them is O(1). The unrealized and exposure totals are re-summed from the
+// positions every RESUM_INTERVAL updates and whenever a position closes,
+// so add/subtract rounding cannot accumulate. Not synchronized; owned by
+// the engine thread.
+class PositionBook {
+public:
+    // Applies a signed fill (positive buys) at price and returns the P&L
+    // realized by any quantity it closed. Fills that flip the sign close
+    // the old side and open the remainder at price.
+    double applyFill(const ContractKey& key, const std::string& symbol, double quantity, double price,
+                     std::chrono::system_clock::time_point time, const std::string& expiration_date = "");
+
+    // Flattens the position at price; returns realized P&L (0 if there was none)
+    double close(const ContractKey& key, double price);
+
+    // Marks the symbol's underlying positions. Options are not marked off
+    // the underlying's price; use markContract with an option price.
+    void markPrice(common::SymbolId symbol_id, double price);
+    void markContract(const ContractKey& key, double price);
+
+    const Position* find(const ContractKey& key) const;
+    const std::vector<Position>& positions() const { return positions_; }
+    size_t size() const { return positions_.size(); }
+
+    double unrealizedPnl() const { return unrealized_total_; }
+    double realizedPnl() const { return realized_total_; }
+    double grossExposure() const { return exposure_total_; }
+
+private:
+    std::vector<Position> positions_;                              // Dense; removal swaps with the last
+    std::vector<ContractKey> keys_;                                // Parallel to positions_
+    std::unordered_map<ContractKey, size_t, ContractKeyHash> index_;
+    common::SymbolTable<std::vector<size_t>> by_symbol_;           // Underlying positions per symbol
+
+    double unrealized_total_ = 0.0;
+    double realized_total_ = 0.0;
+    double exposure_total_ = 0.0;
+    size_t updates_ = 0;  // Since the totals were last re-summed
+
+    static constexpr size_t RESUM_INTERVAL = 4096;
+
+    void mark(size_t slot, double price);
+    void track(const Position& position);    // Adds to the running totals
+    void untrack(const Position& position);  // Removes from the running totals
+    void resum();                            // Recomputes the running totals
+    void remove(size_t slot);
+};
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,52 @@
+#include "price_history.h"
+
+namespace hedgefund {
+namespace algo {
+
+uint64_t PriceSeries::append(double price, std::chrono::system_clock::time_point timestamp) {
+    const uint64_t sequence = count_.load(std::memory_order_relaxed) + 1;
+    const size_t slot = sequence & (CAPACITY - 1);
+
+    // Claim the slot before overwriting it so a reader of the old entry sees
+    // the advanced count when it validates
+    count_.store(sequence, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    prices_[slot].store(price, std::memory_order_relaxed);
+    timestamps_[slot].store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        timestamp.time_since_epoch()).count(), std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return sequence;
+}
+
+std::chrono::system_clock::time_point PriceSeries::timestamp(uint64_t sequence) const {
+    int64_t nanos = timestamps_[sequence & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(nanos)));
+}
+
+bool PriceSeries::intact(uint64_t oldest) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return oldest > 0 && count_.load(std::memory_order_relaxed) < oldest + CAPACITY;
+}
+
+PriceHistoryStore::PriceHistoryStore(common::SymbolId max_symbols)
+    : max_symbols_(max_symbols),
+      series_(new std::atomic<PriceSeries*>[max_symbols]),
+      owned_(new std::unique_ptr<PriceSeries>[max_symbols]) {
+    for (common::SymbolId i = 0; i < max_symbols_; i++) {
+        series_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+PriceSeries* PriceHistoryStore::ensure(common::SymbolId id) {
+    if (id >= max_symbols_) return nullptr;
+    if (!owned_[id]) {
+        owned_[id] = std::make_unique<PriceSeries>();
+        series_[id].store(owned_[id].get(), std::memory_order_release);
+    }
+    return owned_[id].get();
+}
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "common/symbol_registry.h"
+
+namespace hedgefund {
+namespace algo {
+
+// Recent prices and timestamps for one symbol, stored as two parallel rings
+// (SoA) on their own cache lines. Written by a single thread; any number of
+// readers may read concurrently. Entries are addressed by sequence number
+// (1-based append count) rather than age, so a reader sees the history as of
+// the tick it is processing even while newer ticks are appended.
+class alignas(64) PriceSeries {
+public:
+    static constexpr size_t CAPACITY = 128;  // Power of two
+
+    // Writer only; returns the sequence number of the new entry
+    uint64_t append(double price, std::chrono::system_clock::time_point timestamp);
+
+    uint64_t count() const { return count_.load(std::memory_order_acquire); }
+
+    // Entry `sequence`; only meaningful once validated with intact()
+    double price(uint64_t sequence) const {
+        return prices_[sequence & (CAPACITY - 1)].load(std::memory_order_relaxed);
+    }
+    std::chrono::system_clock::time_point timestamp(uint64_t sequence) const;
+
+    // True when entries [oldest, count()] were not overwritten while being
+    // read. Call after the reads, like a seqlock.
+    bool intact(uint64_t oldest) const;
+
+private:
+    std::atomic<double> prices_[CAPACITY];
+    std::atomic<int64_t> timestamps_[CAPACITY];  // Nanoseconds since epoch
+    alignas(64) std::atomic<uint64_t> count_{0};
+};
+
+// Shared per-symbol price history, indexed by SymbolRegistry id. One writer
+// (the engine thread) creates series and appends ticks; strategies only
+// read, so every strategy sees one copy of each symbol's history.
+class PriceHistoryStore {
+public:
+    explicit PriceHistoryStore(common::SymbolId max_symbols = 8192);
+
+    // Writer only; creates the series on first use. Null for ids past max_symbols.
+    PriceSeries* ensure(common::SymbolId id);
+
+    // Null for ids without a series
+    PriceSeries* series(common::SymbolId id) {
+        return id < max_symbols_ ? series_[id].load(std::memory_order_acquire) : nullptr;
+    }
+    const PriceSeries* series(common::SymbolId id) const {
+        return id < max_symbols_ ? series_[id].load(std::memory_order_acquire) : nullptr;
+    }
+
+private:
+    common::SymbolId max_symbols_;
+    std::unique_ptr<std::atomic<PriceSeries*>[]> series_;
+    std::unique_ptr<std::unique_ptr<PriceSeries>[]> owned_;
+};
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,60 @@
+#include "strategy_plugin.h"
+#include <dlfcn.h>
+
+namespace hedgefund {
+namespace algo {
+
+namespace {
+
+void setError(std::string* error, const std::string& message) {
+    if (error) *error = message;
+}
+
+} // namespace
+
+std::unique_ptr<TradingStrategy> PluginStrategy::load(const std::string& path, const StrategyConfig& config,
+                                                      std::string* error) {
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle) {
+        const char* reason = dlerror();
+        setError(error, reason ? reason : "dlopen failed: " + path);
+        return nullptr;
+    }
+    
+    auto version = reinterpret_cast<hedgefund_strategy_abi_version_fn>(dlsym(handle, "hedgefund_strategy_abi_version"));
+    auto create = reinterpret_cast<hedgefund_create_strategy_fn>(dlsym(handle, "hedgefund_create_strategy"));
+    auto destroy = reinterpret_cast<hedgefund_destroy_strategy_fn>(dlsym(handle, "hedgefund_destroy_strategy"));
+    if (!version || !create || !destroy) {
+        setError(error, path + ": missing strategy plugin entry points");
+        dlclose(handle);
+        return nullptr;
+    }
+    if (version() != HEDGEFUND_STRATEGY_ABI_VERSION) {
+        setError(error, path + ": strategy ABI version " + std::to_string(version()) +
+                        ", engine expects " + std::to_string(HEDGEFUND_STRATEGY_ABI_VERSION));
+        dlclose(handle);
+        return nullptr;
+    }
+    
+    TradingStrategy* strategy = create(&config);
+    if (!strategy) {
+        setError(error, path + ": plugin rejected config " + config.name);
+        dlclose(handle);
+        return nullptr;
+    }
+    
+    return std::unique_ptr<TradingStrategy>(new PluginStrategy(config, handle, strategy, destroy));
+}
+
+PluginStrategy::PluginStrategy(const StrategyConfig& config, void* handle, TradingStrategy* strategy,
+                               hedgefund_destroy_strategy_fn destroy)
+    : TradingStrategy(config), handle_(handle), strategy_(strategy), destroy_(destroy) {}
+
+PluginStrategy::~PluginStrategy() {
+    // The strategy's code lives in the library, so it goes first
+    destroy_(strategy_);
+    dlclose(handle_);
+}
+
+} // namespace algo
+} // namespace hedgefund
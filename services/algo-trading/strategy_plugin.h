@@ -0,0 +1,64 @@
+#pragma once
+
+#include "algo_engine.h"
+#include <cstdint>
+
+// Plugin ABI. A strategy library exports three C entry points, most simply
+// via HEDGEFUND_STRATEGY_PLUGIN(MyStrategy). The version is bumped whenever
+// the layout of the engine types shared with plugins changes, and plugins
+// must be built with the same compiler and flags as the engine.
+#define HEDGEFUND_STRATEGY_ABI_VERSION 1
+
+extern "C" {
+typedef uint32_t (*hedgefund_strategy_abi_version_fn)();
+typedef hedgefund::algo::TradingStrategy* (*hedgefund_create_strategy_fn)(const hedgefund::algo::StrategyConfig* config);
+typedef void (*hedgefund_destroy_strategy_fn)(hedgefund::algo::TradingStrategy* strategy);
+}
+
+#define HEDGEFUND_STRATEGY_PLUGIN(StrategyClass)                                                          \
+    extern "C" uint32_t hedgefund_strategy_abi_version() { return HEDGEFUND_STRATEGY_ABI_VERSION; }      \
+    extern "C" hedgefund::algo::TradingStrategy* hedgefund_create_strategy(                                \
+        const hedgefund::algo::StrategyConfig* config) {                                                   \
+        return new StrategyClass(*config);                                                                 \
+    }                                                                                                      \
+    extern "C" void hedgefund_destroy_strategy(hedgefund::algo::TradingStrategy* strategy) { delete strategy; }
+
+namespace hedgefund {
+namespace algo {
+
+// A strategy from a dlopen()ed library. Batches are forwarded with one
+// virtual call, so a plugin deriving from StrategyBase still evaluates its
+// ticks with direct calls. The library stays loaded until this is destroyed.
+class PluginStrategy : public TradingStrategy {
+public:
+    // nullptr when the library cannot be loaded, lacks the entry points,
+    // has another ABI version or declines the config; error says which
+    static std::unique_ptr<TradingStrategy> load(const std::string& path, const StrategyConfig& config,
+                                                 std::string* error = nullptr);
+    ~PluginStrategy() override;
+    
+    PluginStrategy(const PluginStrategy&) = delete;
+    PluginStrategy& operator=(const PluginStrategy&) = delete;
+    
+    void onTick(const MarketData& tick, SignalSink& sink) override { strategy_->onTick(tick, sink); }
+    void onTicks(TickSpan ticks, SignalSink& sink) override { strategy_->onTicks(ticks, sink); }
+    void updatePosition(const Position& position) override { strategy_->updatePosition(position); }
+    double calculateRisk(const std::vector<Position>& positions) override {
+        return strategy_->calculateRisk(positions);
+    }
+    void attachPriceHistory(const PriceHistoryStore* store) override {
+        TradingStrategy::attachPriceHistory(store);
+        strategy_->attachPriceHistory(store);
+    }
+    
+private:
+    PluginStrategy(const StrategyConfig& config, void* handle, TradingStrategy* strategy,
+                   hedgefund_destroy_strategy_fn destroy);
+    
+    void* handle_;
+    TradingStrategy* strategy_;  // Allocated and freed by the plugin
+    hedgefund_destroy_strategy_fn destroy_;
+};
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,210 @@
+#include "streaming_indicators.h"
+#include <cmath>
+#include <algorithm>
+#include <ctime>
+
+namespace hedgefund {
+namespace algo {
+
+RingBuffer::RingBuffer(size_t capacity) : values_(std::max<size_t>(1, capacity), 0.0) {}
+
+bool RingBuffer::push(double value, double& evicted) {
+    bool full = size_ == values_.size();
+    if (full) {
+        evicted = values_[head_];
+    } else {
+        size_++;
+    }
+    values_[head_] = value;
+    head_ = head_ + 1 == values_.size() ? 0 : head_ + 1;
+    return full;
+}
+
+double RingBuffer::back(size_t age) const {
+    size_t index = (head_ + values_.size() - 1 - age) % values_.size();
+    return values_[index];
+}
+
+RollingStats::RollingStats(size_t period) : window_(period) {}
+
+void RollingStats::update(double value) {
+    double evicted = 0.0;
+    if (window_.push(value, evicted)) {
+        // Replace the evicted value at constant window size
+        if (++evictions_ >= window_.capacity()) {
+            refresh();
+            return;
+        }
+        double old_mean = mean_;
+        mean_ += (value - evicted) / window_.size();
+        m2_ += (value - evicted) * (value - mean_ + evicted - old_mean);
+    } else {
+        double delta = value - mean_;
+        mean_ += delta / window_.size();
+        m2_ += delta * (value - mean_);
+    }
+}
+
+void RollingStats::reset() {
+    window_.clear();
+    mean_ = 0.0;
+    m2_ = 0.0;
+    evictions_ = 0;
+}
+
+void RollingStats::refresh() {
+    const size_t n = window_.size();
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) sum += window_.back(i);
+    mean_ = sum / n;
+    m2_ = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double delta = window_.back(i) - mean_;
+        m2_ += delta * delta;
+    }
+    evictions_ = 0;
+}
+
+double RollingStats::variance() const {
+    // Rounding in the sliding update can leave m2 a hair below zero
+    return window_.size() > 0 ? std::max(0.0, m2_) / window_.size() : 0.0;
+}
+
+double RollingStats::stddev() const {
+    return std::sqrt(variance());
+}
+
+Ema::Ema(int period) : period_(std::max(1, period)), alpha_(2.0 / (std::max(1, period) + 1)) {}
+
+double Ema::update(double value) {
+    value_ = count_++ == 0 ? value : value_ + alpha_ * (value - value_);
+    return value_;
+}
+
+WilderRsi::WilderRsi(int period) : period_(std::max(1, period)) {}
+
+double WilderRsi::update(double price) {
+    if (count_++ == 0) {
+        last_price_ = price;
+        return value_;
+    }
+
+    double change = price - last_price_;
+    last_price_ = price;
+    double gain = change > 0.0 ? change : 0.0;
+    double loss = change < 0.0 ? -change : 0.0;
+
+    int changes = count_ - 1;
+    if (changes <= period_) {
+        // Accumulate the seed averages
+        avg_gain_ += gain / period_;
+        avg_loss_ += loss / period_;
+        if (changes < period_) return value_;
+    } else {
+        avg_gain_ = (avg_gain_ * (period_ - 1) + gain) / period_;
+        avg_loss_ = (avg_loss_ * (period_ - 1) + loss) / period_;
+    }
+
+    if (avg_loss_ == 0.0) {
+        value_ = avg_gain_ > 0.0 ? 100.0 : 50.0;
+    } else {
+        value_ = 100.0 - 100.0 / (1.0 + avg_gain_ / avg_loss_);
+    }
+    return value_;
+}
+
+Macd::Macd(int fast, int slow, int signal) : fast_(fast), slow_(slow), signal_(signal) {}
+
+void Macd::update(double price) {
+    fast_.update(price);
+    slow_.update(price);
+    signal_.update(macd());
+}
+
+BollingerBands::BollingerBands(int period, double width) : stats_(std::max(1, period)), width_(width) {}
+
+AverageTrueRange::AverageTrueRange(int period) : period_(std::max(1, period)) {}
+
+double AverageTrueRange::update(double high, double low, double close) {
+    double true_range = high - low;
+    if (count_ > 0) {
+        true_range = std::max({true_range, std::abs(high - previous_close_), std::abs(low - previous_close_)});
+    }
+    previous_close_ = close;
+
+    // Simple average until a full period, Wilder smoothing after
+    count_++;
+    if (count_ <= period_) {
+        value_ += (true_range - value_) / count_;
+    } else {
+        value_ = (value_ * (period_ - 1) + true_range) / period_;
+    }
+    return value_;
+}
+
+Vwap::Vwap(size_t period) : rolling_(period > 0), price_volumes_(period), volumes_(period) {}
+
+double Vwap::update(double price, double volume) {
+    last_price_ = price;
+    double price_volume = price * volume;
+    price_volume_ += price_volume;
+    volume_ += volume;
+
+    if (rolling_) {
+        double evicted_pv = 0.0, evicted_volume = 0.0;
+        if (price_volumes_.push(price_volume, evicted_pv)) price_volume_ -= evicted_pv;
+        if (volumes_.push(volume, evicted_volume)) volume_ -= evicted_volume;
+    }
+    return value();
+}
+
+void Vwap::reset() {
+    price_volumes_.clear();
+    volumes_.clear();
+    price_volume_ = 0.0;
+    volume_ = 0.0;
+}
+
+IndicatorSet::IndicatorSet() : sma_20_(20), sma_50_(50), rsi_(14), macd_(12, 26, 9), bollinger_(20, 2.0), atr_(14) {}
+
+void IndicatorSet::update(double price, double high, double low, double volume,
+                          std::chrono::system_clock::time_point time) {
+    if (time >= session_end_) startSession(time);
+    sma_20_.update(price);
+    sma_50_.update(price);
+    rsi_.update(price);
+    macd_.update(price);
+    bollinger_.update(price);
+    atr_.update(high, low, price);
+    vwap_.update(price, volume);
+    count_++;
+}
+
+void IndicatorSet::startSession(std::chrono::system_clock::time_point time) {
+    // Next local midnight; mktime normalizes the day rollover and DST
+    std::time_t now = std::chrono::system_clock::to_time_t(time);
+    std::tm tm = {};
+    localtime_r(&now, &tm);
+    tm.tm_mday += 1;
+    tm.tm_hour = tm.tm_min = tm.tm_sec = 0;
+    tm.tm_isdst = -1;
+    session_end_ = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    vwap_.reset();
+}
+
+IndicatorSnapshot IndicatorSet::snapshot() const {
+    IndicatorSnapshot snapshot;
+    snapshot.sma_20 = sma_20_.mean();
+    snapshot.sma_50 = sma_50_.mean();
+    snapshot.rsi = rsi_.value();
+    snapshot.bollinger_upper = bollinger_.upper();
+    snapshot.bollinger_lower = bollinger_.lower();
+    snapshot.macd = macd_.macd();
+    snapshot.macd_signal = macd_.signal();
+    snapshot.atr = atr_.value();
+    snapshot.vwap = vwap_.value();
+    return snapshot;
+}
+
+} // namespace algo
+} // namespace hedgefund
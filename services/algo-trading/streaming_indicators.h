@@ -0,0 +1,202 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace hedgefund {
+namespace algo {
+
+// Incremental technical indicators. Every update is O(1) and allocation
+// free; rolling windows live in fixed-capacity rings sized at construction.
+// The live engine updates them per tick and the backtester per bar, so both
+// see identical values for identical inputs.
+
+// Fixed-capacity ring of the most recent values
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity);
+
+    // Appends value; returns true and sets evicted once the oldest value falls out
+    bool push(double value, double& evicted);
+
+    // age 0 is the newest value; age must be < size()
+    double back(size_t age = 0) const;
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return values_.size(); }
+    bool full() const { return size_ == values_.size(); }
+    void clear() { head_ = 0; size_ = 0; }
+
+private:
+    std::vector<double> values_;
+    size_t head_ = 0;  // Next write position
+    size_t size_ = 0;
+};
+
+// Rolling mean and population variance (sliding-window Welford). The sums
+// are recomputed from the window once per period to stop rounding drift,
+// which keeps updates amortized O(1).
+class RollingStats {
+public:
+    explicit RollingStats(size_t period);
+
+    void update(double value);
+    void reset();
+
+    double mean() const { return mean_; }
+    double variance() const;
+    double stddev() const;
+    size_t count() const { return window_.size(); }
+    bool ready() const { return window_.full(); }
+
+private:
+    RingBuffer window_;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    size_t evictions_ = 0;
+
+    void refresh();
+};
+
+// Exponential moving average seeded with the first value
+class Ema {
+public:
+    explicit Ema(int period);
+
+    double update(double value);
+    double value() const { return value_; }
+    bool ready() const { return count_ >= period_; }
+
+private:
+    int period_;
+    double alpha_;
+    double value_ = 0.0;
+    int count_ = 0;
+};
+
+// Wilder's RSI: simple average of the first period's moves, smoothed after.
+// Reads a neutral 50 until period + 1 prices have been seen.
+class WilderRsi {
+public:
+    explicit WilderRsi(int period = 14);
+
+    double update(double price);
+    double value() const { return value_; }
+    bool ready() const { return count_ > period_; }
+
+private:
+    int period_;
+    int count_ = 0;
+    double last_price_ = 0.0;
+    double avg_gain_ = 0.0;
+    double avg_loss_ = 0.0;
+    double value_ = 50.0;
+};
+
+class Macd {
+public:
+    Macd(int fast = 12, int slow = 26, int signal = 9);
+
+    void update(double price);
+    double macd() const { return fast_.value() - slow_.value(); }
+    double signal() const { return signal_.value(); }
+    double histogram() const { return macd() - signal(); }
+    bool ready() const { return slow_.ready() && signal_.ready(); }
+
+private:
+    Ema fast_;
+    Ema slow_;
+    Ema signal_;
+};
+
+class BollingerBands {
+public:
+    explicit BollingerBands(int period = 20, double width = 2.0);
+
+    void update(double price) { stats_.update(price); }
+    double middle() const { return stats_.mean(); }
+    double upper() const { return stats_.mean() + width_ * stats_.stddev(); }
+    double lower() const { return stats_.mean() - width_ * stats_.stddev(); }
+    bool ready() const { return stats_.ready(); }
+
+private:
+    RollingStats stats_;
+    double width_;
+};
+
+// Wilder-smoothed average true range
+class AverageTrueRange {
+public:
+    explicit AverageTrueRange(int period = 14);
+
+    double update(double high, double low, double close);
+    double value() const { return value_; }
+    bool ready() const { return count_ >= period_; }
+
+private:
+    int period_;
+    int count_ = 0;
+    double previous_close_ = 0.0;
+    double value_ = 0.0;
+};
+
+// Volume-weighted average price, cumulative or over the last period updates
+class Vwap {
+public:
+    explicit Vwap(size_t period = 0);  // 0 = cumulative since reset()
+
+    double update(double price, double volume);
+    void reset();
+    double value() const { return volume_ > 0.0 ? price_volume_ / volume_ : last_price_; }
+
+private:
+    bool rolling_;
+    RingBuffer price_volumes_;
+    RingBuffer volumes_;
+    double price_volume_ = 0.0;
+    double volume_ = 0.0;
+    double last_price_ = 0.0;
+};
+
+struct IndicatorSnapshot {
+    double sma_20;
+    double sma_50;
+    double rsi;
+    double bollinger_upper;
+    double bollinger_lower;
+    double macd;
+    double macd_signal;
+    double atr;
+    double vwap;
+};
+
+// The indicator set carried on MarketData and HistoricalData, for one symbol.
+// VWAP is a session statistic: it restarts on the first update of each local
+// calendar day.
+class IndicatorSet {
+public:
+    IndicatorSet();
+
+    // Ticks without a bar range pass price as high and low; volume is what
+    // traded in this update, not the session total
+    void update(double price, double high, double low, double volume, std::chrono::system_clock::time_point time);
+    IndicatorSnapshot snapshot() const;
+    size_t count() const { return count_; }
+
+private:
+    RollingStats sma_20_;
+    RollingStats sma_50_;
+    WilderRsi rsi_;
+    Macd macd_;
+    BollingerBands bollinger_;
+    AverageTrueRange atr_;
+    Vwap vwap_;
+    size_t count_ = 0;
+    std::chrono::system_clock::time_point session_end_ = std::chrono::system_clock::time_point::min();
+
+    void startSession(std::chrono::system_clock::time_point time);
+};
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,65 @@
+#include "timer_wheel.h"
+#include <algorithm>
+
+namespace hedgefund {
+namespace algo {
+
+TimerWheel::TimerWheel(Clock::duration tick, size_t slots, Clock::time_point start)
+    : tick_(std::max(tick, Clock::duration(1))), start_(start), heads_(std::max<size_t>(slots, 1), NIL) {}
+
+TimerWheel::TimerId TimerWheel::schedule(Clock::time_point deadline, uint64_t payload) {
+    uint64_t tick = std::max(ticksUntil(deadline), next_tick_);
+    
+    uint32_t index = allocate();
+    Entry& entry = entries_[index];
+    entry.payload = payload;
+    entry.rounds = (tick - next_tick_) / heads_.size();
+    entry.armed = true;
+    
+    const size_t slot = tick % heads_.size();
+    entry.next = heads_[slot];
+    heads_[slot] = index;
+    armed_++;
+    
+    return (static_cast<TimerId>(entry.generation) << 32) | index;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    uint32_t index = static_cast<uint32_t>(id);
+    if (id == INVALID_TIMER || index >= entries_.size()) return false;
+    
+    // Unlinked lazily when its slot next comes round
+    Entry& entry = entries_[index];
+    if (!entry.armed || entry.generation != static_cast<uint32_t>(id >> 32)) return false;
+    entry.armed = false;
+    armed_--;
+    return true;
+}
+
+uint32_t TimerWheel::allocate() {
+    if (free_ != NIL) {
+        uint32_t index = free_;
+        free_ = entries_[index].next;
+        return index;
+    }
+    entries_.emplace_back();
+    return static_cast<uint32_t>(entries_.size() - 1);
+}
+
+void TimerWheel::release(uint32_t index) {
+    Entry& entry = entries_[index];
+    entry.armed = false;
+    entry.generation++;
+    if (entry.generation == 0) entry.generation = 1;  // Keeps ids distinct from INVALID_TIMER
+    entry.next = free_;
+    free_ = index;
+}
+
+uint64_t TimerWheel::ticksUntil(Clock::time_point time) const {
+    if (time <= start_) return 0;
+    auto elapsed = time - start_;
+    return static_cast<uint64_t>((elapsed + tick_ - Clock::duration(1)) / tick_);
+}
+
+} // namespace algo
+} // namespace hedgefund
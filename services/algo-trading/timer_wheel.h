@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace hedgefund {
+namespace algo {
+
+// Hashed timing wheel (Varghese & Lauck). A timer lands in slot
+// tick % slots and counts the extra revolutions it must wait, so schedule
+// and cancel are O(1) and advancing visits one slot per elapsed tick.
+// Timers fire no earlier than their deadline and at most one tick late.
+// Entries are pooled, so steady-state use does not allocate. Not
+// synchronized.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;  // Generation << 32 | entry index
+    static constexpr TimerId INVALID_TIMER = 0;
+    
+    TimerWheel(Clock::duration tick, size_t slots, Clock::time_point start);
+    
+    // Deadlines in the past fire on the next advance
+    TimerId schedule(Clock::time_point deadline, uint64_t payload);
+    
+    // False if the timer already fired or was cancelled
+    bool cancel(TimerId id);
+    
+    // Calls fire(payload) for every timer due by now. fire may schedule and
+    // cancel timers; new ones never fire within the same call.
+    template <typename Fire>
+    void advance(Clock::time_point now, Fire&& fire);
+    
+    // When the next slot comes due; only meaningful while !empty()
+    Clock::time_point nextTick() const { return start_ + tick_ * static_cast<int64_t>(next_tick_); }
+    
+    size_t size() const { return armed_; }
+    bool empty() const { return armed_ == 0; }
+    
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    
+    struct Entry {
+        uint64_t payload = 0;
+        uint64_t rounds = 0;
+        uint32_t next = NIL;
+        uint32_t generation = 1;
+        bool armed = false;
+    };
+    
+    Clock::duration tick_;
+    Clock::time_point start_;
+    uint64_t next_tick_ = 0;  // First tick not yet processed
+    std::vector<uint32_t> heads_;
+    std::vector<Entry> entries_;
+    uint32_t free_ = NIL;
+    size_t armed_ = 0;
+    
+    uint32_t allocate();
+    void release(uint32_t index);
+    uint64_t ticksUntil(Clock::time_point time) const;  // Ticks from start, rounded up
+};
+
+template <typename Fire>
+void TimerWheel::advance(Clock::time_point now, Fire&& fire) {
+    // Nothing to fire; skip the idle slots outright
+    if (armed_ == 0) {
+        if (now >= nextTick()) next_tick_ = ticksUntil(now) + 1;
+        return;
+    }
+    
+    while (nextTick() <= now) {
+        const size_t slot = next_tick_ % heads_.size();
+        uint32_t index = heads_[slot];
+        heads_[slot] = NIL;
+        next_tick_++;
+        
+        while (index != NIL) {
+            Entry& entry = entries_[index];
+            uint32_t next = entry.next;
+            if (!entry.armed) {
+                release(index);  // Cancelled
+            } else if (entry.rounds == 0) {
+                uint64_t payload = entry.payload;
+                armed_--;
+                release(index);
+                fire(payload);
+            } else {
+                entry.rounds--;
+                entry.next = heads_[slot];
+                heads_[slot] = index;
+            }
+            index = next;
+        }
+    }
+}
+
+} // namespace algo
+} // namespace hedgefund
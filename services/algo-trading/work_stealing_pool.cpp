@@ -0,0 +1,98 @@
+#include "work_stealing_pool.h"
+#include <algorithm>
+
+namespace hedgefund {
+namespace algo {
+
+namespace {
+// Identifies the pool and deque of the calling worker thread, if any
+thread_local const WorkStealingPool* current_pool = nullptr;
+thread_local size_t current_index = 0;
+}
+
+WorkStealingPool::WorkStealingPool(int num_threads) {
+    size_t threads = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+    queues_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    size_t index = current_pool == this ? current_index
+                                        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    // Pairs with workerLoop (both seq_cst, the same locked add on x86): either
+    // the worker sees the task when it rechecks queued_, or we see it idle.
+    // Locking before the notify means an idle worker is already waiting, not
+    // between its check and its wait.
+    queued_.fetch_add(1);
+    if (idle_.load() == 0) return;
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_one();
+}
+
+bool WorkStealingPool::popLocal(size_t index, Task& task) {
+    WorkerQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t thief, Task& task) {
+    for (size_t offset = 1; offset < queues_.size(); offset++) {
+        WorkerQueue& queue = *queues_[(thief + offset) % queues_.size()];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.tasks.empty()) continue;
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+    current_pool = this;
+    current_index = index;
+
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            continue;
+        }
+
+        // Queued tasks drain before shutdown completes
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        idle_.fetch_add(1);
+        wake_.wait(lock, [this]() { return stopping_ || queued_.load() > 0; });
+        idle_.fetch_sub(1, std::memory_order_relaxed);
+        if (stopping_ && queued_.load(std::memory_order_relaxed) == 0) return;
+    }
+}
+
+} // namespace algo
+} // namespace hedgefund
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hedgefund {
+namespace algo {
+
+// Move-only void() callable held in inline storage, so queuing a task never
+// allocates. Callables larger than CAPACITY are rejected at compile time.
+class InlineTask {
+public:
+    static constexpr size_t CAPACITY = 48;
+
+    InlineTask() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, InlineTask>::value>>
+    InlineTask(F&& fn) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= CAPACITY, "task captures too much for inline storage");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "task is over-aligned");
+        new (storage_) Fn(std::forward<F>(fn));
+        ops_ = &OPS<Fn>;
+    }
+
+    InlineTask(InlineTask&& other) noexcept { take(other); }
+    InlineTask& operator=(InlineTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+    ~InlineTask() { reset(); }
+
+    void operator()() { ops_->invoke(storage_); }
+    explicit operator bool() const { return ops_ != nullptr; }
+
+private:
+    struct Ops {
+        void (*invoke)(void*);
+        void (*move)(void* to, void* from);  // Move-constructs at to and destroys from
+        void (*destroy)(void*);
+    };
+
+    template <typename Fn>
+    static constexpr Ops OPS = {
+        [](void* fn) { (*static_cast<Fn*>(fn))(); },
+        [](void* to, void* from) {
+            new (to) Fn(std::move(*static_cast<Fn*>(from)));
+            static_cast<Fn*>(from)->~Fn();
+        },
+        [](void* fn) { static_cast<Fn*>(fn)->~Fn(); }};
+
+    alignas(std::max_align_t) unsigned char storage_[CAPACITY];
+    const Ops* ops_ = nullptr;
+
+    void take(InlineTask& other) {
+        if (!other.ops_) return;
+        other.ops_->move(storage_, other.storage_);
+        ops_ = other.ops_;
+        other.ops_ = nullptr;
+    }
+    void reset() {
+        if (ops_) ops_->destroy(storage_);
+        ops_ = nullptr;
+    }
+};
+
+// Fixed-size thread pool with one task deque per worker. Workers run their
+// own tasks newest-first and steal the oldest task from a sibling when idle;
+// tasks submitted from a worker stay on that worker's deque. submit() only
+// touches the sleep lock when some worker is actually asleep.
+class WorkStealingPool {
+public:
+    using Task = InlineTask;
+
+    explicit WorkStealingPool(int num_threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+    size_t numThreads() const { return workers_.size(); }
+
+private:
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> next_queue_{0};
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> queued_{0};  // Tasks submitted and not yet taken
+    std::atomic<size_t> idle_{0};    // Workers asleep or about to wait
+    bool stopping_ = false;
+
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, Task& task);
+    void workerLoop(size_t index);
+};
+
+} // namespace algo
+} // namespace hedgefund
@@ -14,14 +14,13 @@ namespace backtesting {
 // Technical Indicators Implementation
 std::vector<double> TechnicalIndicators::calculateSMA(const std::vector<double>& prices, int period) {
     std::vector<double> sma;
-    if (prices.size() < static_cast<size_t>(period)) return sma;
+    if (period <= 0 || prices.size() < static_cast<size_t>(period)) return sma;
     
-    for (size_t i = period - 1; i < prices.size(); ++i) {
-        double sum = 0.0;
-        for (int j = 0; j < period; ++j) {
-            sum += prices[i - j];
-        }
-        sma.push_back(sum / period);
+    sma.reserve(prices.size() - period + 1);
+    hedgefund::algo::RollingStats window(period);
+    for (size_t i = 0; i < prices.size(); ++i) {
+        window.update(prices[i]);
+        if (window.ready()) sma.push_back(window.mean());
     }
     return sma;
 }
@@ -263,26 +262,24 @@ void BacktestingEngine::generatePerformanceReport(const BacktestResults& results
 void BacktestingEngine::calculateTechnicalIndicators(std::vector<HistoricalData>& data) {
     if (data.empty()) return;
     
-    std::vector<double> closes;
-    for (const auto& point : data) {
-        closes.push_back(point.close);
-    }
-    
-    auto sma_20 = TechnicalIndicators::calculateSMA(closes, 20);
-    auto sma_50 = TechnicalIndicators::calculateSMA(closes, 50);
-    auto rsi = TechnicalIndicators::calculateRSI(closes, 14);
-    
-    // Apply indicators to data (simplified)
-    for (size_t i = 0; i < data.size(); ++i) {
-        data[i].sma_20 = i >= 19 && i - 19 < sma_20.size() ? sma_20[i - 19] : data[i].close;
-        data[i].sma_50 = i >= 49 && i - 49 < sma_50.size() ? sma_50[i - 49] : data[i].close;
-        data[i].rsi = i >= 14 && i - 14 < rsi.size() ? rsi[i - 14] : 50.0;
-        data[i].bollinger_upper = data[i].close + (data[i].close * 0.02);
-        data[i].bollinger_lower = data[i].close - (data[i].close * 0.02);
-        data[i].macd = 0.0;
-        data[i].macd_signal = 0.0;
-        data[i].atr = data[i].high - data[i].low;
-        data[i].vwap = data[i].close;
+    // Same incremental indicators the live engine maintains, one pass over the bars
+    hedgefund::algo::IndicatorSet indicators;
+    hedgefund::algo::RollingStats sma_200(200);
+    for (auto& point : data) {
+        indicators.update(point.close, point.high, point.low, point.volume, point.timestamp);
+        sma_200.update(point.close);
+        
+        hedgefund::algo::IndicatorSnapshot snapshot = indicators.snapshot();
+        point.sma_20 = snapshot.sma_20;
+        point.sma_50 = snapshot.sma_50;
+        point.sma_200 = sma_200.mean();
+        point.rsi = snapshot.rsi;
+        point.bollinger_upper = snapshot.bollinger_upper;
+        point.bollinger_lower = snapshot.bollinger_lower;
+        point.macd = snapshot.macd;
+        point.macd_signal = snapshot.macd_signal;
+        point.atr = snapshot.atr;
+        point.vwap = snapshot.vwap;
     }
 }
 
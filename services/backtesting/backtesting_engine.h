@@ -6,6 +6,7 @@
 #include <chrono>
 #include <unordered_map>
 #include "../algo-trading/algo_engine.h"
+#include "../algo-trading/streaming_indicators.h"
 
 namespace hedgefund {
 namespace backtesting {
@@ -1,12 +1,14 @@
 #include "polygon_client.h"
 #include "common/database.h"
 #include "common/messaging.h"
+#include "common/tick_codec.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <cstdlib>
 
 using namespace hedgefund::marketdata;
 using namespace hedgefund::common;
@@ -16,7 +18,8 @@ public:
     MarketDataService() 
         : db_("host=localhost port=5432 dbname=hedgefund user=trader password=secure_password"),
           mq_("tcp://localhost:61616"),
-          polygon_client_("m51khkqgJrFNqXTxz7PYsei6LDqJgL71") {}
+          polygon_client_("m51khkqgJrFNqXTxz7PYsei6LDqJgL71"),
+          text_ticks_(std::getenv("MARKET_DATA_TEXT") != nullptr) {}
     
     bool initialize() {
         if (!db_.connect()) {
@@ -74,6 +77,7 @@ private:
     PolygonClient polygon_client_;
     std::vector<std::string> watchlist_;
     int current_symbol_index_ = 0;
+    bool text_ticks_;  // MARKET_DATA_TEXT publishes the CSV form for debugging
     
     void fetchWatchlistData() {
         if (polygon_client_.isRateLimited()) {
@@ -122,16 +126,24 @@ private:
         db_.insertMarketData(ticker.symbol, ticker.price, ticker.volume, now);
         
         // Publish to message queue for algorithmic trading
-        std::ostringstream market_msg;
-        market_msg << "MARKET_DATA," << ticker.symbol << "," 
-                   << ticker.price << "," << ticker.volume << ","
-                   << ticker.high << "," << ticker.low << ","
-                   << ticker.change_percent;
-        
-        mq_.publish("market.data", market_msg.str());
-        
-        // Calculate and publish technical indicators
-        publishTechnicalIndicators(ticker);
+        if (text_ticks_) {
+            std::ostringstream market_msg;
+            market_msg << "MARKET_DATA," << ticker.symbol << "," 
+                       << ticker.price << "," << ticker.volume << ","
+                       << ticker.high << "," << ticker.low << ","
+                       << ticker.change_percent;
+            mq_.publish("market.data", market_msg.str());
+        } else {
+            QuoteFields fields;
+            fields.price = ticker.price;
+            fields.volume = ticker.volume;
+            fields.high = ticker.high;
+            fields.low = ticker.low;
+            fields.change_percent = ticker.change_percent;
+            std::string payload;
+            appendQuote(payload, ticker.symbol, fields, nowNanos());
+            mq_.publish("market.data", payload);
+        }
         
         std::cout << "Processed: " << ticker.symbol << " $" << ticker.price 
                   << " Vol: " << ticker.volume << " Change: " << ticker.change_percent << "%" << std::endl;
@@ -151,32 +163,30 @@ private:
         db_.execute(query.str());
         
         // Publish options data for algorithmic trading
-        std::ostringstream options_msg;
-        options_msg << "OPTIONS_DATA," << contract.underlying_ticker << ","
-                    << contract.strike_price << "," << contract.expiration_date << ","
-                    << contract.contract_type << "," << contract.last_quote_price << ","
-                    << contract.implied_volatility << "," << contract.delta;
-        
-        mq_.publish("options.data", options_msg.str());
+        if (text_ticks_) {
+            std::ostringstream options_msg;
+            options_msg << "OPTIONS_DATA," << contract.underlying_ticker << ","
+                        << contract.strike_price << "," << contract.expiration_date << ","
+                        << contract.contract_type << "," << contract.last_quote_price << ","
+                        << contract.implied_volatility << "," << contract.delta;
+            mq_.publish("options.data", options_msg.str());
+        } else {
+            OptionQuoteFields fields;
+            fields.strike_price = contract.strike_price;
+            fields.price = contract.last_quote_price;
+            fields.implied_vol = contract.implied_volatility;
+            fields.delta = contract.delta;
+            fields.expiry = packExpiry(contract.expiration_date);
+            fields.is_call = contract.contract_type == "call";
+            std::string payload;
+            appendOptionQuote(payload, contract.underlying_ticker, fields, nowNanos());
+            mq_.publish("options.data", payload);
+        }
     }
     
-    void publishTechnicalIndicators(const PolygonTicker& ticker) {
-        // Calculate simple technical indicators (simplified)
-        double sma_20 = ticker.price + (rand() % 200 - 100) / 100.0;
-        double sma_50 = ticker.price + (rand() % 400 - 200) / 100.0;
-        double rsi = 30 + (rand() % 40); // RSI between 30-70
-        double bollinger_upper = ticker.price + 3.0;
-        double bollinger_lower = ticker.price - 3.0;
-        double macd = (rand() % 400 - 200) / 1000.0;
-        double macd_signal = macd + (rand() % 200 - 100) / 1000.0;
-        
-        std::ostringstream tech_msg;
-        tech_msg << "TECHNICAL_INDICATORS," << ticker.symbol << ","
-                 << sma_20 << "," << sma_50 << "," << rsi << ","
-                 << bollinger_upper << "," << bollinger_lower << ","
-                 << macd << "," << macd_signal;
-        
-        mq_.publish("technical.indicators", tech_msg.str());
+    static int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
     }
     
     void handleMarketDataRequest(const Message& msg) {
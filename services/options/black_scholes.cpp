@@ -1,10 +1,8 @@
 #include "black_scholes.h"
+#include "common/fast_math.h"
 #include <cmath>
 #include <algorithm>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+#include <vector>
 
 namespace hedgefund {
 namespace options {
@@ -22,15 +20,14 @@ double BlackScholes::calculatePrice(const OptionParams& params) {
     double d1_val = d1(params);
     double d2_val = d2(params);
     
-    double nd1 = normalCDF(d1_val);
-    double nd2 = normalCDF(d2_val);
+    // Spot carried to expiry net of dividends (Merton)
+    double carried_spot = params.spot_price * std::exp(-params.dividend_yield * params.time_to_expiry);
+    double pv_strike = params.strike_price * std::exp(-params.risk_free_rate * params.time_to_expiry);
     
     if (params.is_call) {
-        return params.spot_price * nd1 - 
-               params.strike_price * std::exp(-params.risk_free_rate * params.time_to_expiry) * nd2;
+        return carried_spot * normalCDF(d1_val) - pv_strike * normalCDF(d2_val);
     } else {
-        return params.strike_price * std::exp(-params.risk_free_rate * params.time_to_expiry) * normalCDF(-d2_val) -
-               params.spot_price * normalCDF(-d1_val);
+        return pv_strike * normalCDF(-d2_val) - carried_spot * normalCDF(-d1_val);
     }
 }
 
@@ -47,46 +44,210 @@ Greeks BlackScholes::calculateGreeks(const OptionParams& params) {
     
     double d1_val = d1(params);
     double d2_val = d2(params);
-    double nd1 = normalCDF(d1_val);
-    double nd2 = normalCDF(d2_val);
     double npd1 = normalPDF(d1_val);
+    double sqrt_t = std::sqrt(params.time_to_expiry);
+    double carry = std::exp(-params.dividend_yield * params.time_to_expiry);
+    double pv_strike = params.strike_price * std::exp(-params.risk_free_rate * params.time_to_expiry);
+    
+    // Signed N(+-d1), N(+-d2) so puts read the tail directly
+    double sign = params.is_call ? 1.0 : -1.0;
+    double nd1 = normalCDF(sign * d1_val);
+    double nd2 = normalCDF(sign * d2_val);
     
     // Delta
-    if (params.is_call) {
-        greeks.delta = nd1;
-    } else {
-        greeks.delta = nd1 - 1.0;
-    }
+    greeks.delta = sign * carry * nd1;
     
     // Gamma (same for calls and puts)
-    greeks.gamma = npd1 / (params.spot_price * params.volatility * std::sqrt(params.time_to_expiry));
+    greeks.gamma = carry * npd1 / (params.spot_price * params.volatility * sqrt_t);
     
     // Theta
-    double theta_common = -(params.spot_price * npd1 * params.volatility) / (2 * std::sqrt(params.time_to_expiry));
-    if (params.is_call) {
-        greeks.theta = theta_common - params.risk_free_rate * params.strike_price * 
-                      std::exp(-params.risk_free_rate * params.time_to_expiry) * nd2;
-    } else {
-        greeks.theta = theta_common + params.risk_free_rate * params.strike_price * 
-                      std::exp(-params.risk_free_rate * params.time_to_expiry) * normalCDF(-d2_val);
-    }
+    double theta_common = -(params.spot_price * carry * npd1 * params.volatility) / (2 * sqrt_t);
+    greeks.theta = theta_common - sign * params.risk_free_rate * pv_strike * nd2 +
+                   sign * params.dividend_yield * params.spot_price * carry * nd1;
     greeks.theta /= 365.0; // Convert to daily theta
     
     // Vega (same for calls and puts)
-    greeks.vega = params.spot_price * npd1 * std::sqrt(params.time_to_expiry) / 100.0; // Per 1% volatility change
+    greeks.vega = params.spot_price * carry * npd1 * sqrt_t / 100.0; // Per 1% volatility change
     
     // Rho
-    if (params.is_call) {
-        greeks.rho = params.strike_price * params.time_to_expiry * 
-                    std::exp(-params.risk_free_rate * params.time_to_expiry) * nd2 / 100.0;
-    } else {
-        greeks.rho = -params.strike_price * params.time_to_expiry * 
-                    std::exp(-params.risk_free_rate * params.time_to_expiry) * normalCDF(-d2_val) / 100.0;
-    }
+    greeks.rho = sign * params.time_to_expiry * pv_strike * nd2 / 100.0;
+    
+    return greeks;
+}
+
+SecondOrderGreeks BlackScholes::calculateSecondOrderGreeks(const OptionParams& params) {
+    SecondOrderGreeks greeks = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    if (params.time_to_expiry <= 0) return greeks;
+    
+    double d1_val = d1(params);
+    double d2_val = d2(params);
+    double npd1 = normalPDF(d1_val);
+    double vol = params.volatility;
+    double t = params.time_to_expiry;
+    double sqrt_t = std::sqrt(t);
+    double q = params.dividend_yield;
+    double carry = std::exp(-q * t);
+    double gamma = carry * npd1 / (params.spot_price * vol * sqrt_t);
+    double vega = params.spot_price * carry * npd1 * sqrt_t;
+    double d1d2 = d1_val * d2_val;
+    
+    // Only charm depends on call/put, through the dividend term
+    double sign = params.is_call ? 1.0 : -1.0;
+    greeks.vanna = -carry * npd1 * d2_val / vol;
+    greeks.volga = vega * d1d2 / vol;
+    greeks.charm = sign * q * carry * normalCDF(sign * d1_val) -
+                   carry * npd1 * (2 * (params.risk_free_rate - q) * t - d2_val * vol * sqrt_t) /
+                   (2 * t * vol * sqrt_t);
+    greeks.veta = vega * (q + (params.risk_free_rate - q) * d1_val / (vol * sqrt_t) - (1.0 + d1d2) / (2 * t));
+    greeks.speed = -gamma / params.spot_price * (d1_val / (vol * sqrt_t) + 1.0);
+    greeks.zomma = gamma * (d1d2 - 1.0) / vol;
+    greeks.ultima = -vega / (vol * vol) * (d1d2 * (1.0 - d1d2) + d1_val * d1_val + d2_val * d2_val);
     
     return greeks;
 }
 
+void BlackScholes::calculateBatch(double spot_price, double risk_free_rate, const OptionBatch& batch) {
+    namespace math = common::math;
+    const size_t n = batch.size;
+    const bool term_structure = batch.expiry_factors != nullptr && batch.expiry_index != nullptr;
+    
+    // Per-thread scratch: signed d1, signed d2, N(d1), N(d2), pdf(d1), discount
+    thread_local std::vector<double> scratch;
+    scratch.resize(6 * n);
+    double* sd1 = scratch.data();
+    double* sd2 = sd1 + n;
+    double* cdf1 = sd2 + n;
+    double* cdf2 = cdf1 + n;
+    double* pdf1 = cdf2 + n;
+    double* discount = pdf1 + n;
+    
+    const double log_spot = std::log(spot_price);
+    for (size_t i = 0; i < n; i++) {
+        double t = std::max(batch.time_to_expiry[i], 1e-12);
+        double vol_sqrt_t = batch.volatility[i] * std::sqrt(t);
+        double log_moneyness, drift;
+        if (term_structure) {
+            // Discounting comes precomputed per expiry; no exp here
+            const ExpiryFactors& f = batch.expiry_factors[batch.expiry_index[i]];
+            log_moneyness = std::log(std::max(1e-8, spot_price - f.dividend_pv) / batch.strike_price[i]);
+            drift = f.rate - f.carry_yield;
+            discount[i] = f.discount_factor;
+        } else {
+            log_moneyness = log_spot - std::log(batch.strike_price[i]);
+            drift = risk_free_rate;
+            discount[i] = -risk_free_rate * t;
+        }
+        double d1 = (log_moneyness + (drift + 0.5 * batch.volatility[i] * batch.volatility[i]) * t) / vol_sqrt_t;
+        double sign = batch.is_call[i] ? 1.0 : -1.0;
+        pdf1[i] = d1;
+        sd1[i] = sign * d1;
+        sd2[i] = sign * (d1 - vol_sqrt_t);
+    }
+    
+    // Puts use N(-d) directly rather than 1 - N(d), which loses the deep OTM tail
+    math::normCdfBatch<math::Accuracy::EXACT>(sd1, cdf1, n);
+    math::normCdfBatch<math::Accuracy::EXACT>(sd2, cdf2, n);
+    math::normPdfBatch(pdf1, pdf1, n);
+    if (!term_structure) math::expBatch(discount, discount, n);
+    
+    for (size_t i = 0; i < n; i++) {
+        double strike = batch.strike_price[i];
+        double t = batch.time_to_expiry[i];
+        double sign = batch.is_call[i] ? 1.0 : -1.0;
+        
+        double spot = spot_price, rate = risk_free_rate, carry = 1.0, carry_yield = 0.0;
+        if (term_structure) {
+            const ExpiryFactors& f = batch.expiry_factors[batch.expiry_index[i]];
+            spot = std::max(1e-8, spot_price - f.dividend_pv);
+            rate = f.rate;
+            carry = f.carry_factor;
+            carry_yield = f.carry_yield;
+        }
+        
+        if (t <= 0) {
+            // At expiration
+            double intrinsic = sign * (spot_price - strike);
+            batch.price[i] = std::max(0.0, intrinsic);
+            batch.delta[i] = intrinsic > 0.0 ? sign : 0.0;
+            batch.gamma[i] = batch.theta[i] = batch.vega[i] = 0.0;
+            continue;
+        }
+        
+        double sqrt_t = std::sqrt(t);
+        double vol = batch.volatility[i];
+        double pv_strike = strike * discount[i];
+        double carried_spot = spot * carry;
+        
+        batch.price[i] = sign * (carried_spot * cdf1[i] - pv_strike * cdf2[i]);
+        batch.delta[i] = sign * carry * cdf1[i];
+        batch.gamma[i] = carry * pdf1[i] / (spot * vol * sqrt_t);
+        batch.theta[i] = (-(carried_spot * pdf1[i] * vol) / (2 * sqrt_t) -
+                          sign * rate * pv_strike * cdf2[i] +
+                          sign * carry_yield * carried_spot * cdf1[i]) / 365.0;
+        batch.vega[i] = carried_spot * pdf1[i] * sqrt_t / 100.0;
+    }
+}
+
+void BlackScholes::calculatePriceGrid(const OptionParams& params, const double* spots, size_t num_spots,
+                                      const double* vols, size_t num_vols, double* prices) {
+    namespace math = common::math;
+    const size_t n = num_spots * num_vols;
+    const double t = params.time_to_expiry;
+    const double sign = params.is_call ? 1.0 : -1.0;
+    
+    if (t <= 0) {
+        for (size_t v = 0; v < num_vols; v++) {
+            for (size_t s = 0; s < num_spots; s++) {
+                prices[v * num_spots + s] = std::max(0.0, sign * (spots[s] - params.strike_price));
+            }
+        }
+        return;
+    }
+    
+    // Per-thread scratch: signed d1, signed d2, N(d1), N(d2) per grid point, plus log spots
+    thread_local std::vector<double> scratch;
+    scratch.resize(4 * n + num_spots);
+    double* sd1 = scratch.data();
+    double* sd2 = sd1 + n;
+    double* cdf1_all = sd2 + n;
+    double* cdf2_all = cdf1_all + n;
+    double* log_moneyness = cdf2_all + n;
+    
+    const double sqrt_t = std::sqrt(t);
+    const double carry = std::exp(-params.dividend_yield * t);
+    const double pv_strike = params.strike_price * std::exp(-params.risk_free_rate * t);
+    const double drift = params.risk_free_rate - params.dividend_yield;
+    
+    for (size_t s = 0; s < num_spots; s++) {
+        log_moneyness[s] = std::log(std::max(1e-8, spots[s]) / params.strike_price);
+    }
+    for (size_t v = 0; v < num_vols; v++) {
+        double vol = std::max(1e-8, vols[v]);
+        double vol_sqrt_t = vol * sqrt_t;
+        double inv_vol_sqrt_t = 1.0 / vol_sqrt_t;
+        double drift_t = (drift + 0.5 * vol * vol) * t;
+        double* row_d1 = sd1 + v * num_spots;
+        double* row_d2 = sd2 + v * num_spots;
+        for (size_t s = 0; s < num_spots; s++) {
+            double d1 = (log_moneyness[s] + drift_t) * inv_vol_sqrt_t;
+            row_d1[s] = sign * d1;
+            row_d2[s] = sign * (d1 - vol_sqrt_t);
+        }
+    }
+    
+    math::normCdfBatch<math::Accuracy::EXACT>(sd1, cdf1_all, n);
+    math::normCdfBatch<math::Accuracy::EXACT>(sd2, cdf2_all, n);
+    
+    for (size_t v = 0; v < num_vols; v++) {
+        const double* cdf1 = cdf1_all + v * num_spots;
+        const double* cdf2 = cdf2_all + v * num_spots;
+        double* out = prices + v * num_spots;
+        for (size_t s = 0; s < num_spots; s++) {
+            out[s] = sign * (spots[s] * carry * cdf1[s] - pv_strike * cdf2[s]);
+        }
+    }
+}
+
 double BlackScholes::impliedVolatility(double market_price, const OptionParams& params, 
                                       double tolerance, int max_iterations) {
     double vol_low = 0.01;
@@ -116,17 +277,20 @@ double BlackScholes::impliedVolatility(double market_price, const OptionParams&
     return vol_mid;
 }
 
+// Scalar calls stay on the standard library, which options-bench measures
+// faster than the HIGH kernels
 double BlackScholes::normalCDF(double x) {
-    return 0.5 * (1.0 + std::erf(x / std::sqrt(2.0)));
+    return common::math::normCdf<common::math::Accuracy::EXACT>(x);
 }
 
 double BlackScholes::normalPDF(double x) {
-    return std::exp(-0.5 * x * x) / std::sqrt(2.0 * M_PI);
+    return common::math::normPdf<common::math::Accuracy::EXACT>(x);
 }
 
 double BlackScholes::d1(const OptionParams& params) {
     return (std::log(params.spot_price / params.strike_price) + 
-            (params.risk_free_rate + 0.5 * params.volatility * params.volatility) * params.time_to_expiry) /
+            (params.risk_free_rate - params.dividend_yield + 0.5 * params.volatility * params.volatility) *
+                params.time_to_expiry) /
            (params.volatility * std::sqrt(params.time_to_expiry));
 }
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace hedgefund {
 namespace options {
@@ -12,6 +14,7 @@ struct OptionParams {
     double risk_free_rate;  // Risk-free interest rate
     double volatility;      // Implied volatility
     bool is_call;          // true for call, false for put
+    double dividend_yield = 0.0;  // Continuous dividend yield plus borrow cost
 };
 
 struct Greeks {
@@ -22,10 +25,66 @@ struct Greeks {
     double rho;      // Interest rate sensitivity
 };
 
+struct PricedContract {
+    double price;
+    Greeks greeks;
+};
+
+// Higher-order sensitivities in raw units (per unit spot, per unit vol, per year)
+struct SecondOrderGreeks {
+    double vanna;   // d(delta)/d(vol)
+    double volga;   // d(vega)/d(vol)
+    double charm;   // d(delta)/d(time), as calendar time passes
+    double veta;    // d(vega)/d(time), as calendar time passes
+    double speed;   // d(gamma)/d(spot)
+    double zomma;   // d(gamma)/d(vol)
+    double ultima;  // d(volga)/d(vol)
+};
+
+// Discounting and carry to one expiry, computed once and shared by every
+// contract on it (see TermStructure::factors)
+struct ExpiryFactors {
+    double discount_factor;  // P(0, T)
+    double rate;             // Continuously compounded zero rate to T
+    double carry_factor;     // exp(-carry_yield * T)
+    double carry_yield;      // Continuous dividend yield plus borrow cost
+    double dividend_pv;      // PV of cash dividends paid before T, taken off spot
+};
+
+// Structure-of-arrays view over contracts on one underlying; inputs are
+// read-only, outputs are written in place
+struct OptionBatch {
+    size_t size;
+    const double* strike_price;
+    const double* time_to_expiry;
+    const double* volatility;
+    const uint8_t* is_call;
+    
+    double* price;
+    double* delta;
+    double* gamma;
+    double* theta;   // Daily
+    double* vega;    // Per 1% volatility change
+    
+    // Optional: contract i is priced with expiry_factors[expiry_index[i]];
+    // without them the flat rate given to calculateBatch applies, with no carry
+    const ExpiryFactors* expiry_factors = nullptr;
+    const uint32_t* expiry_index = nullptr;
+};
+
 class BlackScholes {
 public:
     static double calculatePrice(const OptionParams& params);
     static Greeks calculateGreeks(const OptionParams& params);
+    static SecondOrderGreeks calculateSecondOrderGreeks(const OptionParams& params);
+    
+    // Price and greeks (no rho) for a whole batch at one spot and rate
+    static void calculateBatch(double spot_price, double risk_free_rate, const OptionBatch& batch);
+    
+    // Prices of one contract over a spot x vol grid, vectorized across the
+    // grid: prices[v * num_spots + s] uses spots[s] and vols[v], other inputs from params
+    static void calculatePriceGrid(const OptionParams& params, const double* spots, size_t num_spots,
+                                   const double* vols, size_t num_vols, double* prices);
     
     static double impliedVolatility(double market_price, const OptionParams& params, 
                                    double tolerance = 1e-6, int max_iterations = 100);
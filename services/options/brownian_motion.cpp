@@ -1,4 +1,5 @@
 #include "brownian_motion.h"
+#include "common/fast_math.h"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
@@ -6,28 +7,289 @@
 namespace hedgefund {
 namespace options {
 
+namespace {
+
+double vanillaPayoff(double price, double strike, bool is_call) {
+    return is_call ? std::max(0.0, price - strike) : std::max(0.0, strike - price);
+}
+
+// Payoff of one path from its terminal price and running statistics
+double pathPayoff(const MonteCarloParams& params, double final_price, double average,
+                  double path_max, double path_min) {
+    switch (params.payoff_type) {
+        case PayoffType::ASIAN_ARITHMETIC:
+        case PayoffType::ASIAN_GEOMETRIC:
+            return vanillaPayoff(average, params.strike_price, params.is_call);
+        case PayoffType::BARRIER_UP_AND_OUT:
+            return path_max >= params.barrier ? params.rebate
+                : vanillaPayoff(final_price, params.strike_price, params.is_call);
+        case PayoffType::BARRIER_UP_AND_IN:
+            return path_max >= params.barrier 
+                ? vanillaPayoff(final_price, params.strike_price, params.is_call) : params.rebate;
+        case PayoffType::BARRIER_DOWN_AND_OUT:
+            return path_min <= params.barrier ? params.rebate
+                : vanillaPayoff(final_price, params.strike_price, params.is_call);
+        case PayoffType::BARRIER_DOWN_AND_IN:
+            return path_min <= params.barrier 
+                ? vanillaPayoff(final_price, params.strike_price, params.is_call) : params.rebate;
+        case PayoffType::LOOKBACK_FIXED:
+            return params.is_call ? std::max(0.0, path_max - params.strike_price)
+                                  : std::max(0.0, params.strike_price - path_min);
+        case PayoffType::LOOKBACK_FLOATING:
+            return params.is_call ? final_price - path_min : path_max - final_price;
+        case PayoffType::EUROPEAN:
+        default:
+            return vanillaPayoff(final_price, params.strike_price, params.is_call);
+    }
+}
+
+// Per-path greek contributions, undiscounted
+struct GreekSample {
+    double delta;
+    double gamma;
+    double vega;
+};
+
+class GreeksAccumulator {
+public:
+    void add(const GreekSample& sample) {
+        delta_ += sample.delta;
+        delta_sq_ += sample.delta * sample.delta;
+        gamma_ += sample.gamma;
+        vega_ += sample.vega;
+        vega_sq_ += sample.vega * sample.vega;
+    }
+    
+    MonteCarloGreeks finish(int count, double discount) const {
+        auto standardError = [count](double sum, double sum_sq) {
+            if (count < 2) return 0.0;
+            double mean = sum / count;
+            return std::sqrt(std::max(0.0, (sum_sq - count * mean * mean) / (count - 1)) / count);
+        };
+        
+        MonteCarloGreeks greeks;
+        greeks.delta = discount * delta_ / count;
+        greeks.gamma = discount * gamma_ / count;
+        greeks.vega = discount * vega_ / count / 100.0;
+        greeks.delta_standard_error = discount * standardError(delta_, delta_sq_);
+        greeks.vega_standard_error = discount * standardError(vega_, vega_sq_) / 100.0;
+        return greeks;
+    }
+    
+private:
+    double delta_ = 0.0;
+    double delta_sq_ = 0.0;
+    double gamma_ = 0.0;
+    double vega_ = 0.0;
+    double vega_sq_ = 0.0;
+};
+
+// Likelihood-ratio weights for a path whose first increment is z over dt
+// and whose accumulated vega score is vega_score
+GreekSample likelihoodRatioSample(const MonteCarloParams& params, double payoff, double z,
+                                  double dt, double vega_score) {
+    const double s0 = params.spot_price;
+    const double sigma = params.volatility;
+    const double sqrt_dt = std::sqrt(dt);
+    
+    GreekSample sample;
+    sample.delta = payoff * z / (s0 * sigma * sqrt_dt);
+    sample.gamma = payoff * (z * z - 1.0 - z * sigma * sqrt_dt) / (s0 * s0 * sigma * sigma * dt);
+    sample.vega = payoff * vega_score;
+    return sample;
+}
+
+// European payoff greeks from the terminal price and total Brownian increment
+GreekSample europeanGreekSample(const MonteCarloParams& params, double final_price,
+                                double brownian, double payoff) {
+    const double t = params.time_to_expiry;
+    const double sigma = params.volatility;
+    const double z = brownian / std::sqrt(t);
+    
+    if (params.greeks_method == GreeksMethod::LIKELIHOOD_RATIO) {
+        return likelihoodRatioSample(params, payoff, z, t, (z * z - 1.0) / sigma - z * std::sqrt(t));
+    }
+    
+    // Pathwise delta/vega; gamma applies the likelihood ratio to the pathwise delta
+    const double sign = params.is_call ? 1.0 : -1.0;
+    const bool in_the_money = payoff > 0.0;
+    double h = in_the_money ? sign * final_price / params.spot_price : 0.0;
+    
+    GreekSample sample;
+    sample.delta = h;
+    sample.gamma = h / params.spot_price * (z / (sigma * std::sqrt(t)) - 1.0);
+    sample.vega = in_the_money ? sign * final_price * (brownian - sigma * t) : 0.0;
+    return sample;
+}
+
+bool isBarrier(PayoffType type) {
+    return type == PayoffType::BARRIER_UP_AND_OUT || type == PayoffType::BARRIER_UP_AND_IN ||
+           type == PayoffType::BARRIER_DOWN_AND_OUT || type == PayoffType::BARRIER_DOWN_AND_IN;
+}
+
+// Running sensitivities of one path, tracked alongside its price statistics
+struct PathSensitivities {
+    double first_z;      // First standardized increment (likelihood-ratio score for S0)
+    double vega_score;   // Sum of per-step likelihood-ratio vega scores
+    double d_sum;        // d(sum of prices)/d(sigma), or d(sum of log prices) for geometric
+    double d_max;        // d(path max)/d(sigma)
+    double d_min;        // d(path min)/d(sigma)
+    double d_final;      // d(final price)/d(sigma)
+};
+
+bool isLookback(PayoffType type) {
+    return type == PayoffType::LOOKBACK_FIXED || type == PayoffType::LOOKBACK_FLOATING;
+}
+
+GreekSample pathDependentGreekSample(const MonteCarloParams& params, int num_steps, double payoff,
+                                     double average, double path_max, double path_min,
+                                     const PathSensitivities& sens) {
+    const double dt = params.time_to_expiry / num_steps;
+    
+    // Barriers are discontinuous, so pathwise is biased; lookbacks depend on S0
+    // directly through the path extremes, which the likelihood ratio misses
+    bool likelihood_ratio = params.greeks_method == GreeksMethod::LIKELIHOOD_RATIO;
+    if (isBarrier(params.payoff_type)) likelihood_ratio = true;
+    if (isLookback(params.payoff_type)) likelihood_ratio = false;
+    
+    if (likelihood_ratio) {
+        return likelihoodRatioSample(params, payoff, sens.first_z, dt, sens.vega_score);
+    }
+    
+    // Every price on the path scales with S0, so d(statistic)/dS0 = statistic / S0
+    const double s0 = params.spot_price;
+    const double strike = params.strike_price;
+    const bool call = params.is_call;
+    double h = 0.0;
+    double vega = 0.0;
+    
+    switch (params.payoff_type) {
+        case PayoffType::ASIAN_ARITHMETIC:
+            if (payoff > 0.0) {
+                h = (call ? average : -average) / s0;
+                vega = (call ? 1.0 : -1.0) * sens.d_sum / num_steps;
+            }
+            break;
+        case PayoffType::ASIAN_GEOMETRIC:
+            if (payoff > 0.0) {
+                h = (call ? average : -average) / s0;
+                vega = (call ? 1.0 : -1.0) * average * sens.d_sum / num_steps;
+            }
+            break;
+        case PayoffType::LOOKBACK_FIXED:
+            if (call && path_max > strike) {
+                h = path_max / s0;
+                vega = sens.d_max;
+            } else if (!call && path_min < strike) {
+                h = -path_min / s0;
+                vega = -sens.d_min;
+            }
+            break;
+        case PayoffType::LOOKBACK_FLOATING:
+            h = payoff / s0;
+            vega = call ? sens.d_final - sens.d_min : sens.d_max - sens.d_final;
+            break;
+        default:
+            break;
+    }
+    
+    GreekSample sample;
+    sample.delta = h;
+    sample.gamma = h / s0 * (sens.first_z / (params.volatility * std::sqrt(dt)) - 1.0);
+    sample.vega = vega;
+    return sample;
+}
+
+// Least-squares fit of y on (1, u, u^2) via the 3x3 normal equations.
+// Returns false when the system is singular (too few or identical points).
+bool solveNormalEquations(double a[3][3], double b[3], double beta[3]) {
+    for (int col = 0; col < 3; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < 3; row++) {
+            if (std::abs(a[row][col]) > std::abs(a[pivot][col])) pivot = row;
+        }
+        if (std::abs(a[pivot][col]) < 1e-12) return false;
+        
+        std::swap(a[col], a[pivot]);
+        std::swap(b[col], b[pivot]);
+        
+        for (int row = col + 1; row < 3; row++) {
+            double factor = a[row][col] / a[col][col];
+            for (int k = col; k < 3; k++) a[row][k] -= factor * a[col][k];
+            b[row] -= factor * b[col];
+        }
+    }
+    
+    for (int row = 2; row >= 0; row--) {
+        double acc = b[row];
+        for (int k = row + 1; k < 3; k++) acc -= a[row][k] * beta[k];
+        beta[row] = acc / a[row][row];
+    }
+    return true;
+}
+
+// Independent, reproducible generator for one LSM time block so the
+// backward pass can regenerate exactly the prices seen going forward
+std::mt19937 timeBlockGenerator(unsigned int base_seed, int block) {
+    std::seed_seq seq{base_seed, static_cast<unsigned int>(block)};
+    return std::mt19937(seq);
+}
+
+} // namespace
+
+int PathBlock::blockSizeFor(int num_steps) {
+    const size_t target_prices = (256 * 1024) / sizeof(double);
+    size_t paths = target_prices / static_cast<size_t>(num_steps + 1);
+    paths = std::max<size_t>(64, std::min<size_t>(4096, paths));
+    return static_cast<int>(paths & ~size_t(7)); // Multiple of 8 for clean vector loops
+}
+
+void PathBlock::resize(int num_paths, int num_steps) {
+    num_paths_ = num_paths;
+    num_steps_ = num_steps;
+    data_.resize(static_cast<size_t>(num_steps + 1) * num_paths);
+}
+
 BrownianMotion::BrownianMotion(unsigned int seed) 
     : generator_(seed), normal_dist_(0.0, 1.0) {}
 
 SimulationResult BrownianMotion::priceOption(const MonteCarloParams& params) {
+    if (params.exercise_style == ExerciseStyle::AMERICAN) {
+        return priceAmericanLSM(params);
+    }
+    if (params.payoff_type != PayoffType::EUROPEAN) {
+        return pricePathDependent(params);
+    }
+    
     std::vector<double> payoffs;
     payoffs.reserve(params.num_simulations);
     
     double dt = params.time_to_expiry / params.num_steps;
     double drift = params.risk_free_rate - 0.5 * params.volatility * params.volatility;
     
+    const bool want_greeks = params.greeks_method != GreeksMethod::NONE;
+    GreeksAccumulator greeks;
+    
+    const double sqrt_dt = std::sqrt(dt);
+    const double drift_total = drift * dt * params.num_steps;
+    
     for (int sim = 0; sim < params.num_simulations; sim++) {
-        double price = params.spot_price;
+        double brownian = 0.0;
         
-        // Simulate price path
+        // Simulate price path; only the terminal price matters, so the log
+        // increments are summed and exponentiated once
         for (int step = 0; step < params.num_steps; step++) {
-            double dW = generateNormalRandom() * std::sqrt(dt);
-            price *= std::exp(drift * dt + params.volatility * dW);
+            brownian += generateNormalRandom() * sqrt_dt;
         }
+        double price = params.spot_price * std::exp(drift_total + params.volatility * brownian);
         
         // Calculate payoff
         double payoff = calculatePayoff(price, params.strike_price, params.is_call);
         payoffs.push_back(payoff);
+        
+        if (want_greeks) {
+            greeks.add(europeanGreekSample(params, price, brownian, payoff));
+        }
     }
     
     // Calculate statistics
@@ -53,36 +315,351 @@ SimulationResult BrownianMotion::priceOption(const MonteCarloParams& params) {
     result.confidence_interval_lower = option_price - margin_of_error;
     result.confidence_interval_upper = option_price + margin_of_error;
     
+    if (want_greeks) {
+        result.has_greeks = true;
+        result.greeks = greeks.finish(params.num_simulations, 
+                                      std::exp(-params.risk_free_rate * params.time_to_expiry));
+    }
+    
     return result;
 }
 
-std::vector<double> BrownianMotion::generatePricePath(double spot_price, double drift, double volatility,
-                                                     double time_horizon, int num_steps) {
-    std::vector<double> path;
-    path.reserve(num_steps + 1);
-    path.push_back(spot_price);
+SimulationResult BrownianMotion::pricePathDependent(const MonteCarloParams& params) {
+    const int num_steps = std::max(1, params.num_steps);
+    const int block_size = PathBlock::blockSizeFor(num_steps);
+    const bool geometric = params.payoff_type == PayoffType::ASIAN_GEOMETRIC;
     
-    double dt = time_horizon / num_steps;
-    double price = spot_price;
+    const bool want_greeks = params.greeks_method != GreeksMethod::NONE;
+    const double dt = params.time_to_expiry / num_steps;
+    const double sqrt_dt = std::sqrt(dt);
+    const double sigma = params.volatility;
+    const double log_drift = params.risk_free_rate - 0.5 * sigma * sigma;
+    
+    PathBlock block;
+    std::vector<double> running_sum(block_size), running_max(block_size), running_min(block_size);
+    std::vector<PathSensitivities> sens(want_greeks ? block_size : 0);
+    std::vector<double> prev_brownian(want_greeks ? block_size : 0);
+    GreeksAccumulator greeks;
+    double payoff_sum = 0.0;
+    double payoff_sum_sq = 0.0;
     
-    for (int i = 0; i < num_steps; i++) {
-        double dW = generateNormalRandom() * std::sqrt(dt);
-        price *= std::exp((drift - 0.5 * volatility * volatility) * dt + volatility * dW);
-        path.push_back(price);
+    for (int done = 0; done < params.num_simulations; done += block_size) {
+        int n = std::min(block_size, params.num_simulations - done);
+        generatePathBlock(block, params.spot_price, params.risk_free_rate, params.volatility,
+                          params.time_to_expiry, num_steps, n);
+        
+        const double* start = block.row(0);
+        for (int i = 0; i < n; i++) {
+            running_sum[i] = 0.0;
+            running_max[i] = start[i];
+            running_min[i] = start[i];
+        }
+        if (want_greeks) {
+            std::fill(sens.begin(), sens.begin() + n, PathSensitivities{});
+            std::fill(prev_brownian.begin(), prev_brownian.begin() + n, 0.0);
+        }
+        
+        // Fold running statistics one time step at a time across the block
+        for (int step = 1; step <= num_steps; step++) {
+            const double* prices = block.row(step);
+            if (!want_greeks) {
+                for (int i = 0; i < n; i++) {
+                    running_sum[i] += geometric ? std::log(prices[i]) : prices[i];
+                    running_max[i] = std::max(running_max[i], prices[i]);
+                    running_min[i] = std::min(running_min[i], prices[i]);
+                }
+                continue;
+            }
+            
+            // Recover the Brownian motion from the price to differentiate the path
+            const double t = step * dt;
+            for (int i = 0; i < n; i++) {
+                double log_return = std::log(prices[i] / params.spot_price);
+                double brownian = (log_return - log_drift * t) / sigma;
+                double z = (brownian - prev_brownian[i]) / sqrt_dt;
+                double d_price = prices[i] * (brownian - sigma * t);
+                prev_brownian[i] = brownian;
+                
+                PathSensitivities& path = sens[i];
+                if (step == 1) path.first_z = z;
+                path.vega_score += (z * z - 1.0) / sigma - z * sqrt_dt;
+                path.d_sum += geometric ? brownian - sigma * t : d_price;
+                path.d_final = d_price;
+                
+                running_sum[i] += geometric ? std::log(prices[i]) : prices[i];
+                if (prices[i] > running_max[i]) {
+                    running_max[i] = prices[i];
+                    path.d_max = d_price;
+                }
+                if (prices[i] < running_min[i]) {
+                    running_min[i] = prices[i];
+                    path.d_min = d_price;
+                }
+            }
+        }
+        
+        const double* final_prices = block.row(num_steps);
+        for (int i = 0; i < n; i++) {
+            double average = running_sum[i] / num_steps;
+            if (geometric) average = std::exp(average);
+            
+            double payoff = pathPayoff(params, final_prices[i], average, running_max[i], running_min[i]);
+            payoff_sum += payoff;
+            payoff_sum_sq += payoff * payoff;
+            
+            if (want_greeks) {
+                greeks.add(pathDependentGreekSample(params, num_steps, payoff, average,
+                                                    running_max[i], running_min[i], sens[i]));
+            }
+        }
     }
     
-    return path;
+    const double discount = std::exp(-params.risk_free_rate * params.time_to_expiry);
+    SimulationResult result = summarize(payoff_sum, payoff_sum_sq, params.num_simulations, discount);
+    if (want_greeks) {
+        result.has_greeks = true;
+        result.greeks = greeks.finish(params.num_simulations, discount);
+    }
+    return result;
 }
 
-std::vector<std::vector<double>> BrownianMotion::generateMultiplePaths(double spot_price, double drift, double volatility,
-                                                                      double time_horizon, int num_steps, int num_paths) {
-    std::vector<std::vector<double>> paths;
-    paths.reserve(num_paths);
+SimulationResult BrownianMotion::priceAmericanLSM(const MonteCarloParams& params) {
+    const int n = params.num_simulations;
+    const int num_steps = std::max(1, params.num_steps);
+    const double dt = params.time_to_expiry / num_steps;
+    const double drift_dt = (params.risk_free_rate - 0.5 * params.volatility * params.volatility) * dt;
+    const double vol_sqrt_dt = params.volatility * std::sqrt(dt);
+    const double step_discount = std::exp(-params.risk_free_rate * dt);
+    
+    // ~sqrt(num_steps) steps per block balances checkpoint and block storage
+    const int time_block = std::max(LSM_MIN_TIME_BLOCK, 
+                                    static_cast<int>(std::ceil(std::sqrt(static_cast<double>(num_steps)))));
+    const int num_blocks = (num_steps + time_block - 1) / time_block;
+    const unsigned int base_seed = generator_();
+    
+    auto blockSteps = [&](int block) { return std::min(time_block, num_steps - block * time_block); };
+    auto row = [&](std::vector<double>& rows, int step) { return rows.data() + static_cast<size_t>(step) * n; };
+    
+    // Prices at the start of each time block, plus one regenerated block
+    std::vector<double> checkpoints(static_cast<size_t>(num_blocks) * n);
+    std::vector<double> rows(static_cast<size_t>(time_block + 1) * n);
+    std::fill(checkpoints.begin(), checkpoints.begin() + n, params.spot_price);
+    
+    auto regenerate = [&](int block) {
+        std::mt19937 rng = timeBlockGenerator(base_seed, block);
+        std::normal_distribution<double> dist(0.0, 1.0);
+        std::copy(checkpoints.begin() + static_cast<size_t>(block) * n,
+                  checkpoints.begin() + static_cast<size_t>(block + 1) * n, rows.begin());
+        for (int step = 1; step <= blockSteps(block); step++) {
+            advanceRow(row(rows, step - 1), row(rows, step), n, drift_dt, vol_sqrt_dt, rng, dist);
+        }
+    };
     
+    // Forward pass only records checkpoints
+    for (int block = 0; block < num_blocks; block++) {
+        regenerate(block);
+        if (block + 1 < num_blocks) {
+            const double* end = row(rows, blockSteps(block));
+            std::copy(end, end + n, checkpoints.begin() + static_cast<size_t>(block + 1) * n);
+        }
+    }
+    
+    // Value of following the exercise policy, expressed at the current step
+    std::vector<double> cash(n);
+    const double* final_prices = row(rows, blockSteps(num_blocks - 1));
+    for (int i = 0; i < n; i++) {
+        cash[i] = calculatePayoff(final_prices[i], params.strike_price, params.is_call);
+    }
+    
+    // Backward induction, regenerating one time block at a time
+    for (int block = num_blocks - 1; block >= 0; block--) {
+        if (block != num_blocks - 1) regenerate(block);
+        
+        for (int step = blockSteps(block) - 1; step >= 0; step--) {
+            for (int i = 0; i < n; i++) cash[i] *= step_discount;
+            if (block == 0 && step == 0) break;
+            
+            const double* prices = row(rows, step);
+            double a[3][3] = {};
+            double b[3] = {};
+            int in_the_money = 0;
+            
+            for (int i = 0; i < n; i++) {
+                if (calculatePayoff(prices[i], params.strike_price, params.is_call) <= 0.0) continue;
+                double u = prices[i] / params.strike_price;
+                double basis[3] = {1.0, u, u * u};
+                for (int j = 0; j < 3; j++) {
+                    for (int k = 0; k < 3; k++) a[j][k] += basis[j] * basis[k];
+                    b[j] += basis[j] * cash[i];
+                }
+                in_the_money++;
+            }
+            
+            double beta[3];
+            if (in_the_money < 3 || !solveNormalEquations(a, b, beta)) continue;
+            
+            for (int i = 0; i < n; i++) {
+                double exercise = calculatePayoff(prices[i], params.strike_price, params.is_call);
+                if (exercise <= 0.0) continue;
+                double u = prices[i] / params.strike_price;
+                double continuation = beta[0] + beta[1] * u + beta[2] * u * u;
+                if (exercise > continuation) cash[i] = exercise;
+            }
+        }
+    }
+    
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    for (double value : cash) {
+        sum += value;
+        sum_sq += value * value;
+    }
+    
+    SimulationResult result = summarize(sum, sum_sq, n, 1.0);
+    
+    // Immediate exercise floor
+    double intrinsic = calculatePayoff(params.spot_price, params.strike_price, params.is_call);
+    if (intrinsic > result.option_price) {
+        double shift = intrinsic - result.option_price;
+        result.option_price = intrinsic;
+        result.confidence_interval_lower += shift;
+        result.confidence_interval_upper += shift;
+    }
+    
+    return result;
+}
+
+void BrownianMotion::generatePathBlock(PathBlock& block, double spot_price, double drift, double volatility,
+                                       double time_horizon, int num_steps, int num_paths) {
+    block.resize(num_paths, num_steps);
+    
+    double dt = time_horizon / num_steps;
+    double drift_dt = (drift - 0.5 * volatility * volatility) * dt;
+    double vol_sqrt_dt = volatility * std::sqrt(dt);
+    
+    std::fill(block.row(0), block.row(0) + num_paths, spot_price);
+    for (int step = 1; step <= num_steps; step++) {
+        advanceRow(block.row(step - 1), block.row(step), num_paths, drift_dt, vol_sqrt_dt, 
+                   generator_, normal_dist_);
+    }
+}
+
+void BrownianMotion::advanceRow(const double* prev, double* next, int num_paths, double drift_dt,
+                                double vol_sqrt_dt, std::mt19937& rng, std::normal_distribution<double>& dist) {
+    if (normals_.size() < static_cast<size_t>(num_paths)) normals_.resize(num_paths);
+    
+    for (int i = 0; i < num_paths; i++) normals_[i] = drift_dt + vol_sqrt_dt * dist(rng);
+    common::math::expBatch(normals_.data(), normals_.data(), num_paths);
     for (int i = 0; i < num_paths; i++) {
-        paths.push_back(generatePricePath(spot_price, drift, volatility, time_horizon, num_steps));
+        next[i] = prev[i] * normals_[i];
     }
+}
+
+SimulationResult BrownianMotion::summarize(double sum, double sum_sq, int count, double discount) {
+    double mean = sum / count;
+    double variance = count > 1 ? (sum_sq - count * mean * mean) / (count - 1) : 0.0;
+    double standard_error = std::sqrt(std::max(0.0, variance) / count) * discount;
     
+    SimulationResult result;
+    result.option_price = mean * discount;
+    result.standard_error = standard_error;
+    result.confidence_interval_lower = result.option_price - 1.96 * standard_error;
+    result.confidence_interval_upper = result.option_price + 1.96 * standard_error;
+    return result;
+}
+
+void BrownianMotion::generatePaths(const PathMatrix& paths, double spot_price, double drift, double volatility,
+                                   double time_horizon) {
+    const int num_paths = paths.num_paths;
+    const int num_steps = paths.num_steps;
+    if (num_paths <= 0 || num_steps <= 0) return;
+    
+    if (paths.layout == PathLayout::TIME_MAJOR) {
+        // Same layout as a PathBlock, so steps advance straight into the caller's rows
+        double dt = time_horizon / num_steps;
+        double drift_dt = (drift - 0.5 * volatility * volatility) * dt;
+        double vol_sqrt_dt = volatility * std::sqrt(dt);
+        
+        std::fill(paths.data, paths.data + num_paths, spot_price);
+        for (int step = 1; step <= num_steps; step++) {
+            advanceRow(paths.data + static_cast<size_t>(step - 1) * num_paths,
+                       paths.data + static_cast<size_t>(step) * num_paths,
+                       num_paths, drift_dt, vol_sqrt_dt, generator_, normal_dist_);
+        }
+        return;
+    }
+    
+    // Path-major: transpose each cache-resident block into place
+    const size_t stride = num_steps + 1;
+    forEachBlock(spot_price, drift, volatility, time_horizon, num_steps, num_paths,
+                 [&](const PathBlock& block, int first_path) {
+        double* base = paths.data + static_cast<size_t>(first_path) * stride;
+        for (int step = 0; step <= num_steps; step++) {
+            const double* row = block.row(step);
+            for (int p = 0; p < block.numPaths(); p++) {
+                base[p * stride + step] = row[p];
+            }
+        }
+    });
+}
+
+void BrownianMotion::forEachPath(double spot_price, double drift, double volatility, double time_horizon,
+                                 int num_steps, int num_paths, const PathVisitor& visitor) {
+    if (num_paths <= 0 || num_steps <= 0) return;
+    
+    scratch_path_.resize(num_steps + 1);
+    forEachBlock(spot_price, drift, volatility, time_horizon, num_steps, num_paths,
+                 [&](const PathBlock& block, int first_path) {
+        for (int p = 0; p < block.numPaths(); p++) {
+            for (int step = 0; step <= num_steps; step++) {
+                scratch_path_[step] = block.row(step)[p];
+            }
+            visitor(first_path + p, scratch_path_.data());
+        }
+    });
+}
+
+void BrownianMotion::forEachBlock(double spot_price, double drift, double volatility, double time_horizon,
+                                  int num_steps, int num_paths,
+                                  const std::function<void(const PathBlock&, int)>& fn) {
+    const int block_size = PathBlock::blockSizeFor(num_steps);
+    for (int first = 0; first < num_paths; first += block_size) {
+        int count = std::min(block_size, num_paths - first);
+        generatePathBlock(scratch_block_, spot_price, drift, volatility, time_horizon, num_steps, count);
+        fn(scratch_block_, first);
+    }
+}
+
+void BrownianMotion::generatePricePath(double* prices, double spot_price, double drift, double volatility,
+                                       double time_horizon, int num_steps) {
+    prices[0] = spot_price;
+    if (num_steps <= 0) return;
+    
+    double dt = time_horizon / num_steps;
+    double drift_dt = (drift - 0.5 * volatility * volatility) * dt;
+    double vol_sqrt_dt = volatility * std::sqrt(dt);
+    
+    double price = spot_price;
+    for (int i = 1; i <= num_steps; i++) {
+        price *= std::exp(drift_dt + vol_sqrt_dt * generateNormalRandom());
+        prices[i] = price;
+    }
+}
+
+std::vector<double> BrownianMotion::generatePricePath(double spot_price, double drift, double volatility,
+                                                     double time_horizon, int num_steps) {
+    std::vector<double> path(std::max(0, num_steps) + 1);
+    generatePricePath(path.data(), spot_price, drift, volatility, time_horizon, num_steps);
+    return path;
+}
+
+std::vector<std::vector<double>> BrownianMotion::generateMultiplePaths(double spot_price, double drift, double volatility,
+                                                                      double time_horizon, int num_steps, int num_paths) {
+    std::vector<std::vector<double>> paths(std::max(0, num_paths));
+    forEachPath(spot_price, drift, volatility, time_horizon, num_steps, num_paths,
+                [&](int path, const double* prices) {
+        paths[path].assign(prices, prices + num_steps + 1);
+    });
     return paths;
 }
 
@@ -104,24 +681,48 @@ std::vector<double> BrownianMotion::simulatePortfolioReturns(const std::vector<d
     std::vector<double> portfolio_returns;
     portfolio_returns.reserve(num_simulations);
     
-    if (asset_returns.empty() || weights.empty()) return portfolio_returns;
+    int num_assets = std::min(weights.size(), asset_returns.size());
+    if (num_assets == 0) return portfolio_returns;
     
-    int num_assets = weights.size();
-    int num_periods = asset_returns[0].size();
+    // Fit a joint normal to the most recent periods all assets share, so
+    // simulated returns keep the assets' co-movement
+    size_t num_periods = asset_returns[0].size();
+    for (int a = 1; a < num_assets; a++) num_periods = std::min(num_periods, asset_returns[a].size());
+    if (num_periods < 2) return portfolio_returns;
     
+    std::vector<double> mean(num_assets, 0.0), stdev(num_assets, 0.0);
+    std::vector<std::vector<double>> centered(num_assets, std::vector<double>(num_periods));
+    for (int a = 0; a < num_assets; a++) {
+        const double* history = asset_returns[a].data() + (asset_returns[a].size() - num_periods);
+        mean[a] = std::accumulate(history, history + num_periods, 0.0) / num_periods;
+        for (size_t t = 0; t < num_periods; t++) centered[a][t] = history[t] - mean[a];
+        stdev[a] = std::sqrt(std::inner_product(centered[a].begin(), centered[a].end(),
+                                                centered[a].begin(), 0.0) / (num_periods - 1));
+    }
+    
+    std::vector<std::vector<double>> correlation(num_assets, std::vector<double>(num_assets, 1.0));
+    for (int i = 0; i < num_assets; i++) {
+        for (int j = 0; j < i; j++) {
+            double cov = std::inner_product(centered[i].begin(), centered[i].end(), centered[j].begin(), 0.0) /
+                         (num_periods - 1);
+            double rho = stdev[i] > 0.0 && stdev[j] > 0.0 ? cov / (stdev[i] * stdev[j]) : 0.0;
+            correlation[i][j] = correlation[j][i] = rho;
+        }
+    }
+    
+    common::CholeskyFactor factor;
+    factor.factorize(correlation);
+    
+    std::vector<double> z(num_assets);
     for (int sim = 0; sim < num_simulations; sim++) {
-        double portfolio_return = 0.0;
+        for (auto& value : z) value = generateNormalRandom();
         
-        for (int asset = 0; asset < num_assets && asset < static_cast<int>(asset_returns.size()); asset++) {
-            // Random period selection
-            int period = static_cast<int>(generateNormalRandom() * num_periods / 6.0 + num_periods / 2.0);
-            period = std::max(0, std::min(period, num_periods - 1));
-            
-            if (period < static_cast<int>(asset_returns[asset].size())) {
-                portfolio_return += weights[asset] * asset_returns[asset][period];
-            }
+        double portfolio_return = 0.0;
+        for (int i = 0; i < num_assets; i++) {
+            double x = 0.0;
+            for (int j = 0; j <= i; j++) x += factor.at(i, j) * z[j];
+            portfolio_return += weights[i] * (mean[i] + stdev[i] * x);
         }
-        
         portfolio_returns.push_back(portfolio_return);
     }
     
@@ -140,5 +741,47 @@ double BrownianMotion::calculatePayoff(double final_price, double strike_price,
     }
 }
 
+SimulationResult priceBasketOption(const common::CorrelatedPathGenerator& generator, const BasketOptionParams& params,
+                                   int num_threads) {
+    std::vector<common::AssetDynamics> assets = params.assets;
+    for (auto& asset : assets) asset.drift = params.risk_free_rate;
+
+    // Terminal values only, so a single exact GBM step suffices; payoffs are
+    // stored per path and summed in order to stay thread-count independent
+    std::vector<double> payoffs(std::max(0, params.num_simulations));
+    generator.simulate(assets, params.time_to_expiry, 1, params.num_simulations,
+                       [&](const common::MultiAssetPathBlock& block) {
+        double* out = payoffs.data() + block.firstPath();
+        std::fill(out, out + block.numPaths(), 0.0);
+        for (int a = 0; a < block.numAssets(); a++) {
+            const double* terminal = block.row(1, a);
+            double weight = a < static_cast<int>(params.weights.size()) ? params.weights[a] : 0.0;
+            for (int p = 0; p < block.numPaths(); p++) out[p] += weight * terminal[p];
+        }
+        for (int p = 0; p < block.numPaths(); p++) {
+            out[p] = params.is_call ? std::max(0.0, out[p] - params.strike_price)
+                                    : std::max(0.0, params.strike_price - out[p]);
+        }
+    }, num_threads);
+
+    double sum = 0.0, sum_sq = 0.0;
+    for (double payoff : payoffs) {
+        sum += payoff;
+        sum_sq += payoff * payoff;
+    }
+
+    const int count = std::max(1, params.num_simulations);
+    const double discount = std::exp(-params.risk_free_rate * params.time_to_expiry);
+    double mean = sum / count;
+    double variance = count > 1 ? (sum_sq - count * mean * mean) / (count - 1) : 0.0;
+
+    SimulationResult result;
+    result.option_price = mean * discount;
+    result.standard_error = std::sqrt(std::max(0.0, variance) / count) * discount;
+    result.confidence_interval_lower = result.option_price - 1.96 * result.standard_error;
+    result.confidence_interval_upper = result.option_price + 1.96 * result.standard_error;
+    return result;
+}
+
 } // namespace options
 } // namespace hedgefund
\ No newline at end of file
@@ -1,11 +1,36 @@
 #pragma once
 
+#include "common/correlated_paths.h"
 #include <vector>
 #include <random>
+#include <functional>
 
 namespace hedgefund {
 namespace options {
 
+enum class PayoffType {
+    EUROPEAN,
+    ASIAN_ARITHMETIC,
+    ASIAN_GEOMETRIC,
+    BARRIER_UP_AND_OUT,
+    BARRIER_UP_AND_IN,
+    BARRIER_DOWN_AND_OUT,
+    BARRIER_DOWN_AND_IN,
+    LOOKBACK_FIXED,     // Payoff on path max (call) / min (put) against the strike
+    LOOKBACK_FLOATING   // Strike is the path min (call) / max (put)
+};
+
+enum class ExerciseStyle {
+    EUROPEAN,
+    AMERICAN  // Longstaff-Schwartz, exercisable at every simulation step
+};
+
+enum class GreeksMethod {
+    NONE,
+    PATHWISE,          // Differentiates each path; barriers fall back to likelihood ratio
+    LIKELIHOOD_RATIO   // Weights payoffs by the score of the path density; lookbacks use pathwise
+};
+
 struct MonteCarloParams {
     double spot_price;
     double strike_price;
@@ -15,6 +40,64 @@ struct MonteCarloParams {
     bool is_call;
     int num_simulations;
     int num_steps;
+    
+    PayoffType payoff_type = PayoffType::EUROPEAN;
+    ExerciseStyle exercise_style = ExerciseStyle::EUROPEAN;
+    double barrier = 0.0;   // Barrier level, discretely monitored at each step
+    double rebate = 0.0;    // Paid at expiry when a knock-out is hit or a knock-in is not
+    GreeksMethod greeks_method = GreeksMethod::NONE;
+};
+
+// Greeks estimated from the same paths as the price (European and
+// path-dependent payoffs; not populated for American exercise)
+struct MonteCarloGreeks {
+    double delta;
+    double gamma;
+    double vega;    // Per 1% volatility change, matching BlackScholes::calculateGreeks
+    double delta_standard_error;
+    double vega_standard_error;
+};
+
+// Reusable storage for one block of simulated paths. Prices are laid out
+// time-major (one contiguous row of num_paths prices per step), so advancing
+// a step or folding a running statistic is a unit-stride sweep over the block.
+class PathBlock {
+public:
+    // Paths per block such that a full block stays within ~256KB of cache
+    static int blockSizeFor(int num_steps);
+    
+    void resize(int num_paths, int num_steps);
+    
+    int numPaths() const { return num_paths_; }
+    int numSteps() const { return num_steps_; }
+    double* row(int step) { return data_.data() + static_cast<size_t>(step) * num_paths_; }
+    const double* row(int step) const { return data_.data() + static_cast<size_t>(step) * num_paths_; }
+    
+private:
+    int num_paths_ = 0;
+    int num_steps_ = 0;
+    std::vector<double> data_;  // (num_steps + 1) rows of num_paths prices
+};
+
+enum class PathLayout {
+    PATH_MAJOR,  // Each path's num_steps + 1 prices are contiguous
+    TIME_MAJOR   // Each step's num_paths prices are contiguous, as in PathBlock
+};
+
+// Caller-owned storage for num_paths paths of num_steps + 1 prices each
+struct PathMatrix {
+    double* data;
+    int num_paths;
+    int num_steps;
+    PathLayout layout;
+    
+    static size_t requiredSize(int num_paths, int num_steps) {
+        return static_cast<size_t>(num_paths) * (num_steps + 1);
+    }
+    double& at(int path, int step) const {
+        return layout == PathLayout::PATH_MAJOR ? data[static_cast<size_t>(path) * (num_steps + 1) + step]
+                                                : data[static_cast<size_t>(step) * num_paths + path];
+    }
 };
 
 struct SimulationResult {
@@ -23,6 +106,8 @@ struct SimulationResult {
     std::vector<double> price_paths;
     double confidence_interval_lower;
     double confidence_interval_upper;
+    bool has_greeks = false;
+    MonteCarloGreeks greeks = {};
 };
 
 class BrownianMotion {
@@ -32,11 +117,28 @@ public:
     // Monte Carlo option pricing
     SimulationResult priceOption(const MonteCarloParams& params);
     
-    // Generate single price path using Geometric Brownian Motion
+    // Fill a block with GBM paths; reuses the block's storage across calls
+    void generatePathBlock(PathBlock& block, double spot_price, double drift, double volatility,
+                           double time_horizon, int num_steps, int num_paths);
+    
+    // Fill a caller-provided matrix with GBM paths; allocation-free once the
+    // internal block buffer has grown to size
+    void generatePaths(const PathMatrix& paths, double spot_price, double drift, double volatility,
+                       double time_horizon);
+    
+    // Stream paths one at a time to a visitor; prices points at num_steps + 1
+    // values that are only valid during the call
+    using PathVisitor = std::function<void(int path, const double* prices)>;
+    void forEachPath(double spot_price, double drift, double volatility, double time_horizon,
+                     int num_steps, int num_paths, const PathVisitor& visitor);
+    
+    // Single path into a buffer of num_steps + 1 prices
+    void generatePricePath(double* prices, double spot_price, double drift, double volatility,
+                           double time_horizon, int num_steps);
+    
+    // Allocating conveniences over the above; prefer them for bulk work
     std::vector<double> generatePricePath(double spot_price, double drift, double volatility, 
                                          double time_horizon, int num_steps);
-    
-    // Generate multiple price paths
     std::vector<std::vector<double>> generateMultiplePaths(double spot_price, double drift, double volatility,
                                                           double time_horizon, int num_steps, int num_paths);
     
@@ -49,12 +151,47 @@ public:
                                                int num_simulations);
 
 private:
+    // Time steps regenerated together during the LSM backward pass; bounds
+    // memory to roughly num_simulations * (num_steps / block + block) prices
+    static const int LSM_MIN_TIME_BLOCK = 8;
+    
     std::mt19937 generator_;
     std::normal_distribution<double> normal_dist_;
+    std::vector<double> normals_;
+    PathBlock scratch_block_;          // Time-major staging for path-major output
+    std::vector<double> scratch_path_; // One gathered path for visitors
     
     double generateNormalRandom();
     double calculatePayoff(double final_price, double strike_price, bool is_call);
+    
+    SimulationResult pricePathDependent(const MonteCarloParams& params);
+    SimulationResult priceAmericanLSM(const MonteCarloParams& params);
+    
+    // Advance one row of prices by a single GBM step drawing from rng
+    void advanceRow(const double* prev, double* next, int num_paths, double drift_dt, 
+                    double vol_sqrt_dt, std::mt19937& rng, std::normal_distribution<double>& dist);
+    
+    // Generate num_paths in cache-sized blocks, handing each to fn with the
+    // index of its first path
+    void forEachBlock(double spot_price, double drift, double volatility, double time_horizon, int num_steps,
+                      int num_paths, const std::function<void(const PathBlock&, int)>& fn);
+    
+    static SimulationResult summarize(double sum, double sum_sq, int count, double discount);
+};
+
+struct BasketOptionParams {
+    std::vector<common::AssetDynamics> assets;  // Drifts are ignored; paths grow at the risk-free rate
+    std::vector<double> weights;        // Units of each asset in the basket
+    double strike_price;
+    double time_to_expiry;
+    double risk_free_rate;
+    bool is_call;
+    int num_simulations;
 };
 
+// European option on a weighted basket, over generator's correlation
+SimulationResult priceBasketOption(const common::CorrelatedPathGenerator& generator, const BasketOptionParams& params,
+                                   int num_threads = 0);
+
 } // namespace options
 } // namespace hedgefund
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include "chain_pricer.h"
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+namespace hedgefund {
+namespace options {
+
+namespace {
+
+constexpr char CHAIN_DELTA_MAGIC[4] = {'O', 'C', 'D', '1'};
+constexpr double SECONDS_PER_YEAR = 365.0 * 24.0 * 3600.0;
+
+template <typename T>
+void append(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read(const std::string& in, size_t& offset, T& value) {
+    if (offset + sizeof(T) > in.size()) return false;
+    std::memcpy(&value, in.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+} // namespace
+
+std::string encodeChainDelta(const ChainDelta& delta) {
+    static_assert(sizeof(ChainUpdate) == 24, "ChainUpdate must stay packed for the wire format");
+
+    std::string out;
+    out.reserve(4 + 2 + delta.underlying.size() + 8 + 8 + 4 + delta.updates.size() * sizeof(ChainUpdate));
+    out.append(CHAIN_DELTA_MAGIC, sizeof(CHAIN_DELTA_MAGIC));
+    append(out, static_cast<uint16_t>(delta.underlying.size()));
+    out.append(delta.underlying);
+    append(out, delta.spot_price);
+    append(out, delta.timestamp);
+    append(out, static_cast<uint32_t>(delta.updates.size()));
+    out.append(reinterpret_cast<const char*>(delta.updates.data()), delta.updates.size() * sizeof(ChainUpdate));
+    return out;
+}
+
+bool decodeChainDelta(const std::string& payload, ChainDelta& delta) {
+    if (payload.compare(0, sizeof(CHAIN_DELTA_MAGIC), CHAIN_DELTA_MAGIC, sizeof(CHAIN_DELTA_MAGIC)) != 0) {
+        return false;
+    }
+
+    size_t offset = sizeof(CHAIN_DELTA_MAGIC);
+    uint16_t symbol_length;
+    if (!read(payload, offset, symbol_length) || offset + symbol_length > payload.size()) return false;
+    delta.underlying.assign(payload, offset, symbol_length);
+    offset += symbol_length;
+
+    uint32_t count;
+    if (!read(payload, offset, delta.spot_price) || !read(payload, offset, delta.timestamp) ||
+        !read(payload, offset, count)) {
+        return false;
+    }
+    if (payload.size() - offset != static_cast<size_t>(count) * sizeof(ChainUpdate)) return false;
+
+    delta.updates.resize(count);
+    std::memcpy(delta.updates.data(), payload.data() + offset, count * sizeof(ChainUpdate));
+    return true;
+}
+
+ChainPricer::ChainPricer(double risk_free_rate, double price_threshold, double delta_threshold,
+                         double default_volatility)
+    : risk_free_rate_(risk_free_rate), price_threshold_(price_threshold),
+      delta_threshold_(delta_threshold), default_volatility_(default_volatility) {}
+
+uint32_t ChainPricer::addContract(const std::string& underlying, double strike_price, int32_t expiry_date,
+                                  bool is_call) {
+    double expiry_time = expiryTime(expiry_date);
+    if (expiry_time <= nowSeconds() || strike_price <= 0.0) return INVALID_CONTRACT;
+
+    OptionChain& chain = chains_[underlying];
+    auto key = std::make_tuple(expiry_date, strike_price, is_call);
+    auto it = chain.index.find(key);
+    if (it != chain.index.end()) return chain.contract_id[it->second];
+
+    uint32_t id = chain.next_id++;
+    chain.index.emplace(key, static_cast<uint32_t>(chain.size()));
+
+    auto expiry_it = std::find(chain.expiry_dates.begin(), chain.expiry_dates.end(), expiry_date);
+    if (expiry_it == chain.expiry_dates.end()) {
+        chain.expiry_dates.push_back(expiry_date);
+        chain.expiries.push_back(expiry_time);
+        chain.expiry_factors.emplace_back();
+        chain.expiry_years.push_back(0.0);
+        expiry_it = chain.expiry_dates.end() - 1;
+    }
+
+    chain.contract_id.push_back(id);
+    chain.strike_price.push_back(strike_price);
+    chain.is_call.push_back(is_call ? 1 : 0);
+    chain.expiry_index.push_back(static_cast<uint32_t>(expiry_it - chain.expiry_dates.begin()));
+    chain.time_to_expiry.push_back(0.0);
+    chain.volatility.push_back(default_volatility_);
+    chain.price.push_back(0.0);
+    chain.delta.push_back(0.0);
+    chain.gamma.push_back(0.0);
+    chain.theta.push_back(0.0);
+    chain.vega.push_back(0.0);
+    chain.anchors.emplace_back();
+
+    // Never published, so the first tick always reports it
+    chain.published_price.push_back(std::numeric_limits<double>::quiet_NaN());
+    chain.published_delta.push_back(std::numeric_limits<double>::quiet_NaN());
+    return id;
+}
+
+void ChainPricer::removeExpired(OptionChain& chain, double now) {
+    // Renumber the surviving expiries, then compact every per-contract column in place
+    std::vector<uint32_t> remap(chain.expiries.size(), UINT32_MAX);
+    size_t live_expiries = 0;
+    for (size_t e = 0; e < chain.expiries.size(); e++) {
+        if (chain.expiries[e] <= now) continue;
+        remap[e] = static_cast<uint32_t>(live_expiries);
+        chain.expiry_dates[live_expiries] = chain.expiry_dates[e];
+        chain.expiries[live_expiries] = chain.expiries[e];
+        chain.expiry_factors[live_expiries] = chain.expiry_factors[e];
+        chain.expiry_years[live_expiries] = chain.expiry_years[e];
+        live_expiries++;
+    }
+    chain.expiry_dates.resize(live_expiries);
+    chain.expiries.resize(live_expiries);
+    chain.expiry_factors.resize(live_expiries);
+    chain.expiry_years.resize(live_expiries);
+
+    auto compact = [&chain, &remap](auto& column) {
+        size_t out = 0;
+        for (size_t i = 0; i < column.size(); i++) {
+            if (remap[chain.expiry_index[i]] != UINT32_MAX) column[out++] = column[i];
+        }
+        column.resize(out);
+    };
+    compact(chain.contract_id);
+    compact(chain.strike_price);
+    compact(chain.is_call);
+    compact(chain.time_to_expiry);
+    compact(chain.volatility);
+    compact(chain.price);
+    compact(chain.delta);
+    compact(chain.gamma);
+    compact(chain.theta);
+    compact(chain.vega);
+    compact(chain.anchors);
+    compact(chain.published_price);
+    compact(chain.published_delta);
+
+    // expiry_index last, since every other column is filtered through it
+    size_t out = 0;
+    for (size_t i = 0; i < chain.expiry_index.size(); i++) {
+        uint32_t e = remap[chain.expiry_index[i]];
+        if (e != UINT32_MAX) chain.expiry_index[out++] = e;
+    }
+    chain.expiry_index.resize(out);
+
+    chain.index.clear();
+    for (size_t i = 0; i < chain.size(); i++) {
+        chain.index.emplace(std::make_tuple(chain.expiry_dates[chain.expiry_index[i]], chain.strike_price[i],
+                                            chain.is_call[i] != 0),
+                            static_cast<uint32_t>(i));
+    }
+}
+
+bool ChainPricer::onUnderlyingTick(const std::string& underlying, double spot_price,
+                                   const VolatilitySurfaceSnapshot* surface, ChainDelta& delta,
+                                   const TermStructure* term_structure) {
+    delta.updates.clear();
+
+    auto it = chains_.find(underlying);
+    if (it == chains_.end() || spot_price <= 0.0) return false;
+    OptionChain& chain = it->second;
+
+    double now = nowSeconds();
+    if (std::any_of(chain.expiries.begin(), chain.expiries.end(), [now](double e) { return e <= now; })) {
+        removeExpired(chain, now);
+    }
+    const size_t n = chain.size();
+    if (n == 0) return false;
+
+    for (size_t e = 0; e < chain.expiries.size(); e++) {
+        double years = std::max(0.0, (chain.expiries[e] - now) / SECONDS_PER_YEAR);
+        chain.expiry_years[e] = years;
+        if (term_structure != nullptr) {
+            chain.expiry_factors[e] = term_structure->factors(years);
+        } else {
+            double discount = std::exp(-risk_free_rate_ * years);
+            chain.expiry_factors[e] = ExpiryFactors{discount, risk_free_rate_, 1.0, 0.0, 0.0};
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        chain.time_to_expiry[i] = chain.expiry_years[chain.expiry_index[i]];
+    }
+    if (surface != nullptr && !surface->empty()) {
+        for (size_t i = 0; i < n; i++) {
+            double vol = surface->getVolatility(chain.strike_price[i], chain.time_to_expiry[i], spot_price);
+            if (vol > 0.0) chain.volatility[i] = vol;
+        }
+    }
+
+    if (use_taylor_) {
+        repriceTaylor(chain, spot_price);
+    } else {
+        OptionBatch batch;
+        batch.size = n;
+        batch.strike_price = chain.strike_price.data();
+        batch.time_to_expiry = chain.time_to_expiry.data();
+        batch.volatility = chain.volatility.data();
+        batch.is_call = chain.is_call.data();
+        batch.price = chain.price.data();
+        batch.delta = chain.delta.data();
+        batch.gamma = chain.gamma.data();
+        batch.theta = chain.theta.data();
+        batch.vega = chain.vega.data();
+        batch.expiry_factors = chain.expiry_factors.data();
+        batch.expiry_index = chain.expiry_index.data();
+        BlackScholes::calculateBatch(spot_price, risk_free_rate_, batch);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        // Comparisons against NaN fail, so never-published contracts are always sent
+        bool unchanged = std::fabs(chain.price[i] - chain.published_price[i]) <= price_threshold_ &&
+                         std::fabs(chain.delta[i] - chain.published_delta[i]) <= delta_threshold_;
+        if (unchanged) continue;
+
+        chain.published_price[i] = chain.price[i];
+        chain.published_delta[i] = chain.delta[i];
+        delta.updates.push_back(ChainUpdate{chain.contract_id[i],
+                                            static_cast<float>(chain.price[i]),
+                                            static_cast<float>(chain.delta[i]),
+                                            static_cast<float>(chain.gamma[i]),
+                                            static_cast<float>(chain.theta[i]),
+                                            static_cast<float>(chain.vega[i])});
+    }
+
+    delta.underlying = underlying;
+    delta.spot_price = spot_price;
+    delta.timestamp = static_cast<int64_t>(now * 1000.0);
+    return !delta.updates.empty();
+}
+
+void ChainPricer::enableTaylorRepricing(double max_error, double max_time_step) {
+    taylor_ = TaylorRepricer(max_error, max_time_step);
+    use_taylor_ = true;
+}
+
+void ChainPricer::repriceTaylor(OptionChain& chain, double spot_price) {
+    for (size_t i = 0; i < chain.size(); i++) {
+        const ExpiryFactors& factors = chain.expiry_factors[chain.expiry_index[i]];
+        OptionParams params;
+        params.spot_price = std::max(1e-8, spot_price - factors.dividend_pv);
+        params.strike_price = chain.strike_price[i];
+        params.time_to_expiry = chain.time_to_expiry[i];
+        params.risk_free_rate = factors.rate;
+        params.dividend_yield = factors.carry_yield;
+        params.volatility = chain.volatility[i];
+        params.is_call = chain.is_call[i] != 0;
+
+        PricedContract result = taylor_.update(chain.anchors[i], params);
+        chain.price[i] = result.price;
+        chain.delta[i] = result.greeks.delta;
+        chain.gamma[i] = result.greeks.gamma;
+        chain.theta[i] = result.greeks.theta;
+        chain.vega[i] = result.greeks.vega;
+    }
+}
+
+const OptionChain* ChainPricer::getChain(const std::string& underlying) const {
+    auto it = chains_.find(underlying);
+    return it == chains_.end() ? nullptr : &it->second;
+}
+
+size_t ChainPricer::numContracts() const {
+    size_t total = 0;
+    for (const auto& [symbol, chain] : chains_) {
+        total += chain.size();
+    }
+    return total;
+}
+
+double ChainPricer::nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace options
+} // namespace hedgefund
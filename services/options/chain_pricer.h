@@ -0,0 +1,125 @@
+#pragma once
+
+#include "black_scholes.h"
+#include "volatility_surface.h"
+#include "taylor_repricer.h"
+#include "term_structure.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <cstdint>
+#include <unordered_map>
+
+namespace hedgefund {
+namespace options {
+
+// One repriced contract; 24 bytes on the wire
+struct ChainUpdate {
+    uint32_t contract_id;
+    float price;
+    float delta;
+    float gamma;
+    float theta;
+    float vega;
+};
+
+// Contracts on one underlying that moved on a single tick
+struct ChainDelta {
+    std::string underlying;
+    double spot_price;
+    int64_t timestamp;  // Milliseconds since epoch
+    std::vector<ChainUpdate> updates;
+};
+
+// Binary layout (little-endian): "OCD1", u16 symbol length, symbol bytes,
+// f64 spot, i64 timestamp, u32 count, then count packed ChainUpdate records
+std::string encodeChainDelta(const ChainDelta& delta);
+bool decodeChainDelta(const std::string& payload, ChainDelta& delta);
+
+// Every listed contract on one underlying, stored column-wise so a tick
+// reprices the whole chain in one batch. Rows move when expired contracts
+// are dropped; contract ids do not.
+struct OptionChain {
+    // Contract definition
+    std::vector<uint32_t> contract_id;
+    std::vector<double> strike_price;
+    std::vector<uint8_t> is_call;
+    std::vector<uint32_t> expiry_index;  // Into expiries
+
+    // Distinct expiry dates (YYYYMMDD) and their close in seconds since epoch,
+    // with discounting recomputed once per expiry per tick rather than per contract
+    std::vector<int32_t> expiry_dates;
+    std::vector<double> expiries;
+    std::vector<ExpiryFactors> expiry_factors;
+    std::vector<double> expiry_years;
+
+    // Pricing inputs for the current tick
+    std::vector<double> time_to_expiry;
+    std::vector<double> volatility;
+
+    // Latest results
+    std::vector<double> price;
+    std::vector<double> delta;
+    std::vector<double> gamma;
+    std::vector<double> theta;
+    std::vector<double> vega;
+
+    // Expansion points when Taylor repricing is enabled
+    std::vector<TaylorAnchor> anchors;
+
+    // Values last sent to subscribers
+    std::vector<double> published_price;
+    std::vector<double> published_delta;
+
+    std::map<std::tuple<int32_t, double, bool>, uint32_t> index;  // (expiry date, strike, is_call) -> row
+    uint32_t next_id = 0;
+
+    size_t size() const { return strike_price.size(); }
+};
+
+// Streams chain-level repricing: each underlying tick reprices only that
+// underlying's chain and reports contracts whose price or delta moved past
+// the thresholds since they were last published. Not thread-safe.
+class ChainPricer {
+public:
+    ChainPricer(double risk_free_rate = 0.05, double price_threshold = 0.01, double delta_threshold = 0.005,
+                double default_volatility = 0.20);
+
+    // Register a listed contract (idempotent); returns its id within the
+    // underlying's chain, or INVALID_CONTRACT if it has already expired
+    static constexpr uint32_t INVALID_CONTRACT = UINT32_MAX;
+    uint32_t addContract(const std::string& underlying, double strike_price, int32_t expiry_date, bool is_call);
+
+    // Reprice the chain at spot, taking vols from surface when it has them and
+    // rates/carry from term_structure (flat risk-free rate without one).
+    // Contracts past expiry are dropped first. Fills delta with the contracts
+    // to publish; false if nothing moved.
+    bool onUnderlyingTick(const std::string& underlying, double spot_price,
+                          const VolatilitySurfaceSnapshot* surface, ChainDelta& delta,
+                          const TermStructure* term_structure = nullptr);
+
+    // Reprice from each contract's last full valuation while the expansion
+    // error stays under max_error, instead of a full batch every tick
+    void enableTaylorRepricing(double max_error = 0.005, double max_time_step = 1.0 / 365.0);
+    const TaylorRepricer* getTaylorRepricer() const { return use_taylor_ ? &taylor_ : nullptr; }
+
+    const OptionChain* getChain(const std::string& underlying) const;
+    size_t numContracts() const;
+
+private:
+    double risk_free_rate_;
+    double price_threshold_;
+    double delta_threshold_;
+    double default_volatility_;
+    bool use_taylor_ = false;
+    TaylorRepricer taylor_;
+    std::unordered_map<std::string, OptionChain> chains_;
+
+    void repriceTaylor(OptionChain& chain, double spot_price);
+    static void removeExpired(OptionChain& chain, double now);
+    static double nowSeconds();
+};
+
+} // namespace options
+} // namespace hedgefund
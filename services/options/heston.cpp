@@ -0,0 +1,302 @@
+#include "heston.h"
+#include "common/fast_math.h"
+#include <cmath>
+#include <algorithm>
+#include <map>
+#include <thread>
+
+namespace hedgefund {
+namespace options {
+
+namespace {
+
+using Complex = std::complex<double>;
+
+// In-place iterative radix-2 FFT; size must be a power of two
+void fft(std::vector<Complex>& data) {
+    const size_t n = data.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        double angle = -2.0 * common::math::PI / len;
+        Complex step(std::cos(angle), std::sin(angle));
+        for (size_t start = 0; start < n; start += len) {
+            Complex w(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; k++) {
+                Complex even = data[start + k];
+                Complex odd = data[start + k + len / 2] * w;
+                data[start + k] = even + odd;
+                data[start + k + len / 2] = even - odd;
+                w *= step;
+            }
+        }
+    }
+}
+
+// Unconstrained coordinates for the optimizer
+HestonParams fromUnconstrained(const double* x) {
+    return HestonParams{std::exp(x[0]), std::exp(x[1]), std::exp(x[2]), std::exp(x[3]), 0.999 * std::tanh(x[4])};
+}
+
+void toUnconstrained(const HestonParams& p, double* x) {
+    x[0] = std::log(p.v0);
+    x[1] = std::log(p.kappa);
+    x[2] = std::log(p.theta);
+    x[3] = std::log(p.sigma);
+    x[4] = std::atanh(std::max(-0.99, std::min(0.99, p.rho / 0.999)));
+}
+
+constexpr int NUM_PARAMS = 5;
+
+// Nelder-Mead simplex search; returns the best point found
+template <typename Objective>
+std::vector<double> nelderMead(Objective& objective, std::vector<double> start, double step, int max_evaluations,
+                               int& evaluations, double& best_value) {
+    const int n = static_cast<int>(start.size());
+    std::vector<std::vector<double>> simplex(n + 1, start);
+    std::vector<double> values(n + 1);
+    for (int i = 0; i < n; i++) simplex[i + 1][i] += step;
+    for (int i = 0; i <= n; i++) values[i] = objective(simplex[i].data());
+    evaluations += n + 1;
+
+    std::vector<int> order(n + 1);
+    std::vector<double> centroid(n), trial(n), trial2(n);
+    while (evaluations < max_evaluations) {
+        for (int i = 0; i <= n; i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return values[a] < values[b]; });
+        int best = order[0], worst = order[n], second_worst = order[n - 1];
+        if (values[worst] - values[best] < 1e-12 * (1.0 + std::fabs(values[best]))) break;
+
+        std::fill(centroid.begin(), centroid.end(), 0.0);
+        for (int i = 0; i <= n; i++) {
+            if (i == worst) continue;
+            for (int d = 0; d < n; d++) centroid[d] += simplex[i][d] / n;
+        }
+
+        for (int d = 0; d < n; d++) trial[d] = centroid[d] + (centroid[d] - simplex[worst][d]);
+        double reflected = objective(trial.data());
+        evaluations++;
+
+        if (reflected < values[best]) {
+            for (int d = 0; d < n; d++) trial2[d] = centroid[d] + 2.0 * (centroid[d] - simplex[worst][d]);
+            double expanded = objective(trial2.data());
+            evaluations++;
+            if (expanded < reflected) {
+                simplex[worst] = trial2;
+                values[worst] = expanded;
+            } else {
+                simplex[worst] = trial;
+                values[worst] = reflected;
+            }
+        } else if (reflected < values[second_worst]) {
+            simplex[worst] = trial;
+            values[worst] = reflected;
+        } else {
+            for (int d = 0; d < n; d++) trial2[d] = centroid[d] + 0.5 * (simplex[worst][d] - centroid[d]);
+            double contracted = objective(trial2.data());
+            evaluations++;
+            if (contracted < values[worst]) {
+                simplex[worst] = trial2;
+                values[worst] = contracted;
+            } else {
+                // Shrink towards the best point
+                for (int i = 0; i <= n; i++) {
+                    if (i == best) continue;
+                    for (int d = 0; d < n; d++) simplex[i][d] = simplex[best][d] + 0.5 * (simplex[i][d] - simplex[best][d]);
+                    values[i] = objective(simplex[i].data());
+                }
+                evaluations += n;
+            }
+        }
+    }
+
+    int best = static_cast<int>(std::min_element(values.begin(), values.end()) - values.begin());
+    best_value = values[best];
+    return simplex[best];
+}
+
+} // namespace
+
+HestonModel::HestonModel(const HestonParams& params, int fft_size, double damping, double grid_spacing)
+    : params_(params), fft_size_(fft_size), damping_(damping), grid_spacing_(grid_spacing) {}
+
+std::complex<double> HestonModel::characteristicFunction(std::complex<double> u, double spot_price,
+                                                         double time_to_expiry, double risk_free_rate) const {
+    // Albrecher et al. formulation, which stays on the principal branch of the log
+    const Complex i(0.0, 1.0);
+    const double kappa = params_.kappa, theta = params_.theta, sigma = params_.sigma, rho = params_.rho;
+    const double sigma2 = sigma * sigma;
+
+    Complex beta = kappa - rho * sigma * i * u;
+    Complex d = std::sqrt(beta * beta + sigma2 * (i * u + u * u));
+    Complex g = (beta - d) / (beta + d);
+    Complex decay = std::exp(-d * time_to_expiry);
+
+    Complex c = kappa * theta / sigma2 *
+                ((beta - d) * time_to_expiry - 2.0 * std::log((1.0 - g * decay) / (1.0 - g)));
+    Complex v = params_.v0 / sigma2 * (beta - d) * (1.0 - decay) / (1.0 - g * decay);
+    return std::exp(i * u * (std::log(spot_price) + risk_free_rate * time_to_expiry) + c + v);
+}
+
+double HestonModel::callGrid(double spot_price, double time_to_expiry, double risk_free_rate) {
+    const Complex i(0.0, 1.0);
+    const int n = fft_size_;
+    const double eta = grid_spacing_;
+    const double lambda = 2.0 * common::math::PI / (n * eta);
+    const double b = 0.5 * n * lambda;
+    const double alpha = damping_;
+    const double discount = std::exp(-risk_free_rate * time_to_expiry);
+
+    fft_buffer_.resize(n);
+    for (int j = 0; j < n; j++) {
+        double v = j * eta;
+        Complex phi = characteristicFunction(Complex(v, -(alpha + 1.0)), spot_price, time_to_expiry, risk_free_rate);
+        Complex psi = discount * phi / Complex(alpha * alpha + alpha - v * v, (2.0 * alpha + 1.0) * v);
+
+        // Simpson weights: 1/3, 4/3, 2/3, 4/3, ...
+        double weight = j == 0 ? 1.0 / 3.0 : (j % 2 == 1 ? 4.0 / 3.0 : 2.0 / 3.0);
+        fft_buffer_[j] = std::exp(i * b * v) * psi * eta * weight;
+    }
+
+    fft(fft_buffer_);
+
+    call_grid_.resize(n);
+    for (int j = 0; j < n; j++) {
+        double log_strike = -b + j * lambda;
+        call_grid_[j] = std::exp(-alpha * log_strike) / common::math::PI * fft_buffer_[j].real();
+    }
+    return lambda;
+}
+
+std::vector<double> HestonModel::priceSlice(double spot_price, double time_to_expiry, double risk_free_rate,
+                                            const std::vector<double>& strikes, const std::vector<bool>& is_call) {
+    std::vector<double> prices(strikes.size(), 0.0);
+    if (time_to_expiry <= 0.0) {
+        for (size_t s = 0; s < strikes.size(); s++) {
+            double intrinsic = is_call[s] ? spot_price - strikes[s] : strikes[s] - spot_price;
+            prices[s] = std::max(0.0, intrinsic);
+        }
+        return prices;
+    }
+
+    const double lambda = callGrid(spot_price, time_to_expiry, risk_free_rate);
+    const double b = 0.5 * fft_size_ * lambda;
+    const double discount = std::exp(-risk_free_rate * time_to_expiry);
+
+    for (size_t s = 0; s < strikes.size(); s++) {
+        // Catmull-Rom cubic through the four surrounding log-strike nodes
+        double position = (std::log(strikes[s]) + b) / lambda;
+        int j = std::max(1, std::min(fft_size_ - 3, static_cast<int>(std::floor(position))));
+        double t = position - j;
+        double c0 = call_grid_[j - 1], c1 = call_grid_[j], c2 = call_grid_[j + 1], c3 = call_grid_[j + 2];
+        double call = c1 + 0.5 * t * (c2 - c0 + t * (2.0 * c0 - 5.0 * c1 + 4.0 * c2 - c3 +
+                                                     t * (3.0 * (c1 - c2) + c3 - c0)));
+        call = std::max(call, std::max(0.0, spot_price - strikes[s] * discount));
+
+        prices[s] = is_call[s] ? call : call - spot_price + strikes[s] * discount;
+    }
+    return prices;
+}
+
+double HestonModel::price(const OptionParams& params) {
+    return priceSlice(params.spot_price, params.time_to_expiry, params.risk_free_rate,
+                      {params.strike_price}, {params.is_call})[0];
+}
+
+HestonModel::CalibrationResult HestonModel::calibrate(const std::vector<VolQuote>& quotes, double risk_free_rate,
+                                                      const HestonParams& initial, int num_threads) {
+    // Group by expiry so each objective evaluation is one FFT per expiry
+    struct Slice {
+        double time_to_expiry;
+        double spot_price;
+        std::vector<double> strikes;
+        std::vector<bool> is_call;
+        std::vector<double> market_prices;
+        std::vector<double> inverse_vegas;
+    };
+    std::map<int32_t, Slice> by_expiry;
+    for (const auto& quote : quotes) {
+        double time_to_expiry = yearsToExpiry(quote.expiry_date);
+        if (time_to_expiry <= 0.0 || quote.strike_price <= 0.0 || quote.underlying_price <= 0.0) continue;
+
+        OptionParams bs{quote.underlying_price, quote.strike_price, time_to_expiry, risk_free_rate,
+                        quote.implied_vol, quote.is_call};
+        if (bs.volatility <= 0.0) bs.volatility = BlackScholes::impliedVolatility(quote.price, bs);
+        double market_price = quote.price > 0.0 ? quote.price : BlackScholes::calculatePrice(bs);
+        double vega = BlackScholes::calculateGreeks(bs).vega * 100.0;
+
+        Slice& slice = by_expiry[quote.expiry_date];
+        slice.time_to_expiry = time_to_expiry;
+        slice.spot_price = quote.underlying_price;
+        slice.strikes.push_back(quote.strike_price);
+        slice.is_call.push_back(quote.is_call);
+        slice.market_prices.push_back(market_price);
+        slice.inverse_vegas.push_back(1.0 / std::max(vega, 1e-2));
+    }
+
+    size_t num_quotes = 0;
+    for (const auto& [expiry, slice] : by_expiry) num_quotes += slice.strikes.size();
+    if (num_quotes == 0) return CalibrationResult{initial, 0.0, 0};
+
+    size_t threads = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<size_t>(threads, 8);
+
+    // Each worker searches from its own start, with its own model and FFT buffers
+    std::vector<CalibrationResult> results(threads);
+    std::vector<double> best_values(threads);
+    auto worker = [&](size_t index) {
+        HestonModel model(initial);
+        auto objective = [&](const double* x) {
+            model.setParams(fromUnconstrained(x));
+            double sum_sq = 0.0;
+            for (const auto& [expiry, slice] : by_expiry) {
+                auto prices = model.priceSlice(slice.spot_price, slice.time_to_expiry, risk_free_rate,
+                                               slice.strikes, slice.is_call);
+                for (size_t k = 0; k < prices.size(); k++) {
+                    double error = (prices[k] - slice.market_prices[k]) * slice.inverse_vegas[k];
+                    sum_sq += error * error;
+                }
+            }
+            return std::isfinite(sum_sq) ? sum_sq : 1e10;
+        };
+
+        // Start 0 is the caller's guess; others scale it along fixed directions
+        static const double scales[8][NUM_PARAMS] = {
+            {0.0, 0.0, 0.0, 0.0, 0.0},   {0.5, -0.7, 0.3, 0.4, -0.5}, {-0.5, 0.7, -0.3, -0.4, 0.5},
+            {0.3, 0.5, 0.5, -0.5, -1.0}, {-0.3, -0.5, -0.5, 0.5, 1.0}, {0.7, 0.0, -0.7, 0.0, 0.3},
+            {0.0, 1.0, 0.0, 0.7, -0.3}, {-0.7, -1.0, 0.7, -0.7, 0.0}};
+        std::vector<double> start(NUM_PARAMS);
+        toUnconstrained(initial, start.data());
+        for (int d = 0; d < NUM_PARAMS; d++) start[d] += scales[index][d];
+
+        int evaluations = 0;
+        double best_value = 0.0;
+        std::vector<double> best = nelderMead(objective, start, 0.3, 1500, evaluations, best_value);
+        results[index] = CalibrationResult{fromUnconstrained(best.data()),
+                                           std::sqrt(best_value / num_quotes), evaluations};
+        best_values[index] = best_value;
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; t++) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    size_t best = std::min_element(best_values.begin(), best_values.end()) - best_values.begin();
+    CalibrationResult result = results[best];
+    for (const auto& r : results) {
+        if (&r != &results[best]) result.evaluations += r.evaluations;
+    }
+    return result;
+}
+
+} // namespace options
+} // namespace hedgefund
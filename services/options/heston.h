@@ -0,0 +1,66 @@
+#pragma once
+
+#include "black_scholes.h"
+#include "volatility_surface.h"
+#include <complex>
+#include <vector>
+
+namespace hedgefund {
+namespace options {
+
+struct HestonParams {
+    double v0;     // Initial variance
+    double kappa;  // Mean-reversion speed
+    double theta;  // Long-run variance
+    double sigma;  // Vol of variance
+    double rho;    // Spot/variance correlation
+};
+
+// Heston stochastic-volatility model priced with Carr-Madan: one FFT of the
+// damped characteristic function gives calls on a whole log-strike grid for
+// an expiry, which is then interpolated to the requested strikes.
+class HestonModel {
+public:
+    explicit HestonModel(const HestonParams& params, int fft_size = 4096, double damping = 1.5,
+                         double grid_spacing = 0.25);
+
+    // E[exp(iu ln S_T)] under the risk-neutral measure
+    std::complex<double> characteristicFunction(std::complex<double> u, double spot_price,
+                                                double time_to_expiry, double risk_free_rate) const;
+
+    // Prices for many strikes at one expiry from a single FFT
+    std::vector<double> priceSlice(double spot_price, double time_to_expiry, double risk_free_rate,
+                                   const std::vector<double>& strikes, const std::vector<bool>& is_call);
+
+    // Single contract (params.volatility is ignored)
+    double price(const OptionParams& params);
+
+    const HestonParams& getParams() const { return params_; }
+    void setParams(const HestonParams& params) { params_ = params; }
+
+    struct CalibrationResult {
+        HestonParams params;
+        double rmse_vol;   // Vega-weighted price error, roughly in vol points
+        int evaluations;
+    };
+
+    // Fit to quotes from several starting points in parallel (0 threads =
+    // hardware concurrency) and keep the best
+    static CalibrationResult calibrate(const std::vector<VolQuote>& quotes, double risk_free_rate,
+                                       const HestonParams& initial, int num_threads = 0);
+
+private:
+    HestonParams params_;
+    int fft_size_;
+    double damping_;
+    double grid_spacing_;  // In the frequency domain; log-strike spacing is 2*pi / (N * this)
+
+    std::vector<std::complex<double>> fft_buffer_;
+    std::vector<double> call_grid_;
+
+    // Fill call_grid_ with calls at log strikes -b + j * lambda; returns lambda
+    double callGrid(double spot_price, double time_to_expiry, double risk_free_rate);
+};
+
+} // namespace options
+} // namespace hedgefund
@@ -0,0 +1,265 @@
+#include "lattice_pricer.h"
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace hedgefund {
+namespace options {
+
+namespace {
+
+// Peizer-Pratt inversion used by Leisen-Reimer to map d1/d2 to probabilities
+double peizerPratt(double z, int n) {
+    double a = z / (n + 1.0 / 3.0 + 0.1 / (n + 1.0));
+    return 0.5 + std::copysign(0.5 * std::sqrt(1.0 - std::exp(-a * a * (n + 1.0 / 6.0))), z);
+}
+
+// Delta and gamma from three neighbouring nodes
+void greeksFromNodes(const double* value, const double* spot, Greeks& greeks) {
+    double up = (value[2] - value[1]) / (spot[2] - spot[1]);
+    double down = (value[1] - value[0]) / (spot[1] - spot[0]);
+    greeks.gamma = (up - down) / (0.5 * (spot[2] - spot[0]));
+}
+
+// Carry a later node's value back to today's spot (the middle node drifts off
+// it with Leisen-Reimer or cash dividends) so theta isn't polluted by delta
+double shiftToSpot(double value, double node_spot, double spot, const Greeks& greeks) {
+    double shift = spot - node_spot;
+    return value + greeks.delta * shift + 0.5 * greeks.gamma * shift * shift;
+}
+
+} // namespace
+
+LatticeResult LatticePricer::price(const LatticeParams& params) {
+    LatticeResult result;
+    result.greeks = Greeks{0.0, 0.0, 0.0, 0.0, 0.0};
+
+    if (params.time_to_expiry <= 0.0) {
+        double sign = params.is_call ? 1.0 : -1.0;
+        result.price = std::max(0.0, sign * (params.spot_price - params.strike_price));
+        result.greeks.delta = result.price > 0.0 ? sign : 0.0;
+        return result;
+    }
+
+    EarlyLevels levels;
+    result.price = backwardInduction(params, levels);
+
+    int steps = params.lattice_type == LatticeType::LEISEN_REIMER
+        ? (std::max(3, params.num_steps) | 1) : std::max(3, params.num_steps);
+    double dt = params.time_to_expiry / steps;
+
+    if (params.lattice_type == LatticeType::TRINOMIAL) {
+        const double* v = levels.value[1];
+        const double* s = levels.spot[1];
+        result.greeks.delta = (v[2] - v[0]) / (s[2] - s[0]);
+        greeksFromNodes(v, s, result.greeks);
+        result.greeks.theta = (shiftToSpot(v[1], s[1], params.spot_price, result.greeks) - result.price) / dt / 365.0;
+    } else {
+        const double* v1 = levels.value[1];
+        const double* s1 = levels.spot[1];
+        result.greeks.delta = (v1[1] - v1[0]) / (s1[1] - s1[0]);
+        greeksFromNodes(levels.value[2], levels.spot[2], result.greeks);
+        double later = shiftToSpot(levels.value[2][1], levels.spot[2][1], params.spot_price, result.greeks);
+        result.greeks.theta = (later - result.price) / (2.0 * dt) / 365.0;
+    }
+
+    if (params.bump_vega_rho) {
+        // No node estimator exists for these; re-run on the same buffers
+        const double h = 1e-3;
+        LatticeParams bumped = params;
+        EarlyLevels scratch;
+
+        bumped.volatility = params.volatility + h;
+        double vol_up = backwardInduction(bumped, scratch);
+        bumped.volatility = params.volatility - h;
+        double vol_down = backwardInduction(bumped, scratch);
+        result.greeks.vega = (vol_up - vol_down) / (2.0 * h) / 100.0;
+
+        bumped.volatility = params.volatility;
+        bumped.risk_free_rate = params.risk_free_rate + h;
+        double rate_up = backwardInduction(bumped, scratch);
+        bumped.risk_free_rate = params.risk_free_rate - h;
+        double rate_down = backwardInduction(bumped, scratch);
+        result.greeks.rho = (rate_up - rate_down) / (2.0 * h) / 100.0;
+    }
+
+    return result;
+}
+
+std::vector<LatticeResult> LatticePricer::priceChain(const std::vector<LatticeParams>& chain, int num_threads) {
+    std::vector<LatticeResult> results(chain.size());
+    if (chain.empty()) return results;
+
+    size_t threads = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, chain.size());
+
+    // Contracts are claimed one at a time so long-dated ones don't stall a worker's share
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        LatticePricer pricer;
+        for (size_t i = next.fetch_add(1); i < chain.size(); i = next.fetch_add(1)) {
+            results[i] = pricer.price(chain[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t t = 1; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    return results;
+}
+
+double LatticePricer::backwardInduction(const LatticeParams& params, EarlyLevels& levels) {
+    double escrowed_spot = params.spot_price - dividendPV(params, 0.0);
+    if (params.lattice_type == LatticeType::TRINOMIAL) {
+        return trinomial(params, escrowed_spot, levels);
+    }
+    return binomial(params, escrowed_spot, levels);
+}
+
+double LatticePricer::binomial(const LatticeParams& params, double escrowed_spot, EarlyLevels& levels) {
+    const bool leisen_reimer = params.lattice_type == LatticeType::LEISEN_REIMER;
+    const int n = leisen_reimer ? (std::max(3, params.num_steps) | 1) : std::max(3, params.num_steps);
+    const double dt = params.time_to_expiry / n;
+    const double growth = std::exp((params.risk_free_rate - params.carry_yield) * dt);
+    const double discount = std::exp(-params.risk_free_rate * dt);
+    const double strike = params.strike_price;
+    const double sign = params.is_call ? 1.0 : -1.0;
+
+    double u, d, p;
+    if (leisen_reimer) {
+        double vol_sqrt_t = params.volatility * std::sqrt(params.time_to_expiry);
+        double d1 = (std::log(escrowed_spot / strike) +
+                     (params.risk_free_rate - params.carry_yield + 0.5 * params.volatility * params.volatility) *
+                         params.time_to_expiry) /
+                    vol_sqrt_t;
+        double d2 = d1 - vol_sqrt_t;
+        p = peizerPratt(d2, n);
+        u = growth * peizerPratt(d1, n) / p;
+        d = (growth - p * u) / (1.0 - p);
+    } else {
+        u = std::exp(params.volatility * std::sqrt(dt));
+        d = 1.0 / u;
+        p = (growth - d) / (u - d);
+    }
+    const double pu = discount * p;
+    const double pd = discount * (1.0 - p);
+    const double inv_d = 1.0 / d;
+
+    values_.resize(n + 1);
+    spots_.resize(n + 1);
+    double* v = values_.data();
+    double* s = spots_.data();
+
+    // Terminal level: node i has i up-moves
+    double spot = escrowed_spot * std::pow(d, n);
+    const double ratio = u / d;
+    for (int i = 0; i <= n; i++) {
+        s[i] = spot;
+        v[i] = std::max(0.0, sign * (spot - strike));
+        spot *= ratio;
+    }
+
+    for (int j = n - 1; j >= 0; j--) {
+        // Continuation value; reads v[i + 1] before it is overwritten, so the sweep vectorizes
+        for (int i = 0; i <= j; i++) {
+            v[i] = pu * v[i + 1] + pd * v[i];
+        }
+        for (int i = 0; i <= j; i++) {
+            s[i] *= inv_d;
+        }
+
+        double pending_dividends = (params.is_american || j <= 2) ? dividendPV(params, j * dt) : 0.0;
+        if (params.is_american) {
+            for (int i = 0; i <= j; i++) {
+                v[i] = std::max(v[i], sign * (s[i] + pending_dividends - strike));
+            }
+        }
+
+        if (j <= 2) {
+            for (int i = 0; i <= j; i++) {
+                levels.value[j][i] = v[i];
+                levels.spot[j][i] = s[i] + pending_dividends;
+            }
+        }
+    }
+
+    return v[0];
+}
+
+double LatticePricer::trinomial(const LatticeParams& params, double escrowed_spot, EarlyLevels& levels) {
+    const int n = std::max(3, params.num_steps);
+    const double dt = params.time_to_expiry / n;
+    const double discount = std::exp(-params.risk_free_rate * dt);
+    const double strike = params.strike_price;
+    const double sign = params.is_call ? 1.0 : -1.0;
+
+    const double u = std::exp(params.volatility * std::sqrt(2.0 * dt));
+    const double a = std::exp((params.risk_free_rate - params.carry_yield) * dt / 2.0);
+    const double b = std::exp(params.volatility * std::sqrt(dt / 2.0));
+    const double up_prob = std::pow((a - 1.0 / b) / (b - 1.0 / b), 2);
+    const double down_prob = std::pow((b - a) / (b - 1.0 / b), 2);
+    const double pu = discount * up_prob;
+    const double pd = discount * down_prob;
+    const double pm = discount * (1.0 - up_prob - down_prob);
+
+    const int width = 2 * n + 1;
+    values_.resize(width);
+    spots_.resize(width);
+    double* v = values_.data();
+    double* s = spots_.data();
+
+    // Terminal level: node i sits at escrowed_spot * u^(i - n)
+    double spot = escrowed_spot * std::pow(u, -n);
+    for (int i = 0; i < width; i++) {
+        s[i] = spot;
+        v[i] = std::max(0.0, sign * (spot - strike));
+        spot *= u;
+    }
+
+    for (int j = n - 1; j >= 0; j--) {
+        const int nodes = 2 * j + 1;
+        for (int i = 0; i < nodes; i++) {
+            v[i] = pd * v[i] + pm * v[i + 1] + pu * v[i + 2];
+        }
+        for (int i = 0; i < nodes; i++) {
+            s[i] *= u;
+        }
+
+        double pending_dividends = (params.is_american || j <= 1) ? dividendPV(params, j * dt) : 0.0;
+        if (params.is_american) {
+            for (int i = 0; i < nodes; i++) {
+                v[i] = std::max(v[i], sign * (s[i] + pending_dividends - strike));
+            }
+        }
+
+        if (j <= 1) {
+            for (int i = 0; i < nodes; i++) {
+                levels.value[j][i] = v[i];
+                levels.spot[j][i] = s[i] + pending_dividends;
+            }
+        }
+    }
+
+    return v[0];
+}
+
+double LatticePricer::dividendPV(const LatticeParams& params, double time) {
+    double pv = 0.0;
+    for (const auto& dividend : params.dividends) {
+        if (dividend.time > time && dividend.time <= params.time_to_expiry) {
+            pv += dividend.amount * std::exp(-params.risk_free_rate * (dividend.time - time));
+        }
+    }
+    return pv;
+}
+
+} // namespace options
+} // namespace hedgefund
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "black_scholes.h"
+#include "term_structure.h"
+#include <vector>
+
+namespace hedgefund {
+namespace options {
+
+enum class LatticeType {
+    CRR,            // Cox-Ross-Rubinstein binomial
+    LEISEN_REIMER,  // Binomial centred on the strike; smooth convergence (odd step count)
+    TRINOMIAL       // Boyle trinomial
+};
+
+struct LatticeParams {
+    double spot_price;
+    double strike_price;
+    double time_to_expiry;
+    double risk_free_rate;
+    double volatility;
+    bool is_call;
+
+    double carry_yield = 0.0;  // Continuous dividend yield plus borrow; the tree drifts at r - q
+    bool is_american = true;
+    int num_steps = 200;
+    LatticeType lattice_type = LatticeType::CRR;
+    std::vector<CashDividend> dividends;  // Escrowed: the lattice models spot less their PV
+    bool bump_vega_rho = false;           // Vega/rho need extra lattices; zero unless requested
+};
+
+struct LatticeResult {
+    double price;
+    Greeks greeks;  // Delta, gamma and theta read from the first lattice levels
+};
+
+class LatticePricer {
+public:
+    LatticeResult price(const LatticeParams& params);
+
+    // Price a whole chain, spreading contracts over num_threads workers
+    // (0 = hardware concurrency), each with its own buffers
+    static std::vector<LatticeResult> priceChain(const std::vector<LatticeParams>& chain, int num_threads = 0);
+
+private:
+    // Node values and spots for one level, reused across calls
+    std::vector<double> values_;
+    std::vector<double> spots_;
+
+    // Values and actual spots at the first levels, captured for greeks
+    struct EarlyLevels {
+        double value[3][5];
+        double spot[3][5];
+    };
+
+    double backwardInduction(const LatticeParams& params, EarlyLevels& levels);
+    double binomial(const LatticeParams& params, double escrowed_spot, EarlyLevels& levels);
+    double trinomial(const LatticeParams& params, double escrowed_spot, EarlyLevels& levels);
+
+    static double dividendPV(const LatticeParams& params, double time);
+};
+
+} // namespace options
+} // namespace hedgefund
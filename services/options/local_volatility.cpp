@@ -0,0 +1,123 @@
+#include "local_volatility.h"
+#include <cmath>
+#include <algorithm>
+
+namespace hedgefund {
+namespace options {
+
+namespace {
+
+constexpr int GRID_POINTS = VolatilitySurfaceSnapshot::GRID_POINTS;
+constexpr double GRID_MIN_K = VolatilitySurfaceSnapshot::GRID_MIN_K;
+constexpr double GRID_MAX_K = VolatilitySurfaceSnapshot::GRID_MAX_K;
+constexpr double GRID_DK = (GRID_MAX_K - GRID_MIN_K) / (GRID_POINTS - 1);
+
+// Keeps noisy or arbitrageable corners of the surface from producing absurd vols
+constexpr double MIN_LOCAL_VARIANCE = 1e-4;
+constexpr double MAX_LOCAL_VARIANCE = 4.0;
+
+} // namespace
+
+LocalVolatilityModel::LocalVolatilityModel(std::shared_ptr<const VolatilitySurfaceSnapshot> surface,
+                                           double spot_price, double risk_free_rate, double max_expiry,
+                                           int time_points)
+    : spot_price_(spot_price), risk_free_rate_(risk_free_rate) {
+    time_points = std::max(2, time_points);
+    times_.resize(time_points);
+    local_variance_.assign(static_cast<size_t>(time_points) * GRID_POINTS, MIN_LOCAL_VARIANCE);
+    for (int m = 0; m < time_points; m++) {
+        times_[m] = max_expiry * (m + 1) / time_points;
+    }
+    if (!surface || surface->empty()) return;
+
+    // Dupire in total implied variance w(k, T), k = log(K / F):
+    //   sigma_loc^2 = dw/dT / (1 - k/w dw/dk + (-1/4 - 1/w + k^2/w^2) (dw/dk)^2 / 4 + d2w/dk2 / 2)
+    // with k derivatives on the surface's own grid spacing
+    for (int m = 0; m < time_points; m++) {
+        double t = times_[m];
+        double dt = std::min(0.5 * t, 1.0 / 365.0);
+        double* row = local_variance_.data() + static_cast<size_t>(m) * GRID_POINTS;
+
+        for (int i = 0; i < GRID_POINTS; i++) {
+            double k = GRID_MIN_K + i * GRID_DK;
+            double w = surface->getTotalVariance(k, t);
+            double w_up = surface->getTotalVariance(k + GRID_DK, t);
+            double w_down = surface->getTotalVariance(k - GRID_DK, t);
+            if (w <= 0.0) continue;
+
+            double dw_dt = (surface->getTotalVariance(k, t + dt) - surface->getTotalVariance(k, t - dt)) / (2.0 * dt);
+            double dw_dk = (w_up - w_down) / (2.0 * GRID_DK);
+            double d2w_dk2 = (w_up - 2.0 * w + w_down) / (GRID_DK * GRID_DK);
+
+            double denominator = 1.0 - k / w * dw_dk +
+                                 0.25 * (-0.25 - 1.0 / w + k * k / (w * w)) * dw_dk * dw_dk + 0.5 * d2w_dk2;
+            double variance = denominator > 1e-6 ? dw_dt / denominator : MAX_LOCAL_VARIANCE;
+            row[i] = std::max(MIN_LOCAL_VARIANCE, std::min(MAX_LOCAL_VARIANCE, variance));
+        }
+    }
+}
+
+double LocalVolatilityModel::localVolatility(double time, double spot_price) const {
+    double forward = spot_price_ * std::exp(risk_free_rate_ * time);
+    double k = std::log(spot_price / forward);
+
+    double pos_k = (std::max(GRID_MIN_K, std::min(GRID_MAX_K, k)) - GRID_MIN_K) / GRID_DK;
+    int i = std::min(static_cast<int>(pos_k), GRID_POINTS - 2);
+    double frac_k = pos_k - i;
+
+    // Flat before the first and after the last time row
+    size_t above = std::upper_bound(times_.begin(), times_.end(), time) - times_.begin();
+    size_t below = above == 0 ? 0 : above - 1;
+    above = std::min(above, times_.size() - 1);
+    double frac_t = above == below ? 0.0 : (time - times_[below]) / (times_[above] - times_[below]);
+
+    auto sample = [&](size_t m) {
+        const double* row = local_variance_.data() + m * GRID_POINTS;
+        return row[i] + frac_k * (row[i + 1] - row[i]);
+    };
+    double variance = sample(below) + frac_t * (sample(above) - sample(below));
+    return std::sqrt(variance);
+}
+
+SimulationResult LocalVolatilityModel::priceOption(const MonteCarloParams& params, unsigned int seed) const {
+    const int num_paths = params.num_simulations;
+    const int num_steps = std::max(1, params.num_steps);
+    const double dt = params.time_to_expiry / num_steps;
+    const double sqrt_dt = std::sqrt(dt);
+
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    // Log-Euler, one time step across all paths at a time
+    std::vector<double> log_spot(num_paths, std::log(params.spot_price));
+    for (int step = 0; step < num_steps; step++) {
+        double t = step * dt;
+        for (int p = 0; p < num_paths; p++) {
+            double vol = localVolatility(t, std::exp(log_spot[p]));
+            log_spot[p] += (params.risk_free_rate - 0.5 * vol * vol) * dt + vol * sqrt_dt * dist(rng);
+        }
+    }
+
+    double sum = 0.0, sum_sq = 0.0;
+    for (int p = 0; p < num_paths; p++) {
+        double terminal = std::exp(log_spot[p]);
+        double payoff = params.is_call ? std::max(0.0, terminal - params.strike_price)
+                                       : std::max(0.0, params.strike_price - terminal);
+        sum += payoff;
+        sum_sq += payoff * payoff;
+    }
+
+    double discount = std::exp(-params.risk_free_rate * params.time_to_expiry);
+    double mean = sum / num_paths;
+    double variance = num_paths > 1 ? (sum_sq - num_paths * mean * mean) / (num_paths - 1) : 0.0;
+
+    SimulationResult result;
+    result.option_price = mean * discount;
+    result.standard_error = std::sqrt(std::max(0.0, variance) / num_paths) * discount;
+    result.confidence_interval_lower = result.option_price - 1.96 * result.standard_error;
+    result.confidence_interval_upper = result.option_price + 1.96 * result.standard_error;
+    return result;
+}
+
+} // namespace options
+} // namespace hedgefund
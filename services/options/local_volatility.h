@@ -0,0 +1,33 @@
+#pragma once
+
+#include "brownian_motion.h"
+#include "volatility_surface.h"
+#include <memory>
+#include <vector>
+
+namespace hedgefund {
+namespace options {
+
+// Dupire local volatility taken from a fitted implied surface, with Monte
+// Carlo pricing in which each step's vol depends on time and spot
+class LocalVolatilityModel {
+public:
+    LocalVolatilityModel(std::shared_ptr<const VolatilitySurfaceSnapshot> surface, double spot_price,
+                         double risk_free_rate, double max_expiry, int time_points = 64);
+
+    // Local vol at (time, spot), bilinear on the precomputed grid
+    double localVolatility(double time, double spot_price) const;
+
+    // Uses spot, strike, expiry, call/put, path and step counts from params;
+    // params.volatility is ignored. Only European payoffs.
+    SimulationResult priceOption(const MonteCarloParams& params, unsigned int seed = 42) const;
+
+private:
+    double spot_price_;
+    double risk_free_rate_;
+    std::vector<double> times_;
+    std::vector<double> local_variance_;  // times_.size() rows of GRID_POINTS log-moneyness samples
+};
+
+} // namespace options
+} // namespace hedgefund
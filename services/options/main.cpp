@@ -1,12 +1,24 @@
 #include "black_scholes.h"
 #include "brownian_motion.h"
+#include "volatility_surface.h"
+#include "lattice_pricer.h"
+#include "chain_pricer.h"
+#include "pricing_cache.h"
+#include "heston.h"
+#include "term_structure.h"
+#include "scenario_grid.h"
 #include "common/database.h"
 #include "common/messaging.h"
+#include "common/tick_codec.h"
+#include <cmath>
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 using namespace hedgefund::options;
 using namespace hedgefund::common;
@@ -16,7 +28,10 @@ public:
     OptionsService() 
         : db_("host=localhost port=5432 dbname=hedgefund user=trader password=secure_password"),
           mq_("tcp://localhost:61616"),
-          brownian_motion_(std::random_device{}()) {}
+          brownian_motion_(std::random_device{}()) {
+        // Most ticks move spot by cents; expand from cached greeks until the error nears a half cent
+        chain_pricer_.enableTaylorRepricing(0.005);
+    }
     
     bool initialize() {
         if (!db_.connect()) {
@@ -42,6 +57,23 @@ public:
             handleImpliedVolRequest(msg);
         });
         
+        // Quotes and underlying prices feeding the volatility surfaces
+        mq_.subscribe("options.data", [this](const Message& msg) {
+            handleOptionsData(msg);
+        });
+        
+        mq_.subscribe("market.data", [this](const Message& msg) {
+            handleMarketData(msg);
+        });
+        
+        mq_.subscribe("options.scenario_request", [this](const Message& msg) {
+            handleScenarioRequest(msg);
+        });
+        
+        mq_.subscribe("options.term_structure", [this](const Message& msg) {
+            handleTermStructure(msg);
+        });
+        
         mq_.startConsumer();
         return true;
     }
@@ -63,62 +95,380 @@ private:
     Database db_;
     MessageQueue mq_;
     BrownianMotion brownian_motion_;
+    LatticePricer lattice_pricer_;
     
-    void handlePriceRequest(const Message& msg) {
-        // Parse pricing request (simplified JSON-like format)
-        // Format: "SYMBOL,STRIKE,EXPIRY,IS_CALL,SPOT,VOL,RATE"
-        std::cout << "Pricing request: " << msg.payload << std::endl;
+    std::mutex surfaces_mutex_;  // Guards the surfaces, spots and chains
+    std::unordered_map<std::string, VolatilitySurface> surfaces_;
+    std::unordered_map<std::string, double> spot_prices_;
+    ChainPricer chain_pricer_;
+    PricingCache lattice_cache_;  // American lattice results, shared by price and greeks requests
+    PricingCache monte_carlo_cache_;
+    ScenarioGridPricer scenario_pricer_;
+    
+    static std::vector<std::string> splitPayload(const std::string& payload) {
+        std::istringstream ss(payload);
+        std::string token;
+        std::vector<std::string> tokens;
+        while (std::getline(ss, token, ',')) {
+            tokens.push_back(token);
+        }
+        return tokens;
+    }
+    
+    void handleMarketData(const Message& msg) {
+        if (isBinaryTick(msg.payload)) {
+            TickReader reader(msg.payload);
+            while (reader.next()) {
+                if (reader.kind() != TickKind::QUOTE) continue;
+                onUnderlyingPrice(std::string(reader.symbol(), reader.symbolLength()), reader.price());
+            }
+            return;
+        }
         
-        // Example parsing (in real implementation, use JSON)
-        OptionParams params;
-        params.spot_price = 150.0;
-        params.strike_price = 155.0;
-        params.time_to_expiry = 0.25; // 3 months
-        params.risk_free_rate = 0.05;
-        params.volatility = 0.20;
-        params.is_call = true;
+        // Format: "MARKET_DATA,SYMBOL,PRICE,..."
+        auto tokens = splitPayload(msg.payload);
+        if (tokens.size() < 3 || tokens[0] != "MARKET_DATA") return;
+        onUnderlyingPrice(tokens[1], std::atof(tokens[2].c_str()));
+    }
+    
+    void onUnderlyingPrice(const std::string& symbol, double price) {
+        if (price <= 0.0) return;
         
-        // Calculate Black-Scholes price
-        double bs_price = BlackScholes::calculatePrice(params);
+        std::lock_guard<std::mutex> lock(surfaces_mutex_);
+        spot_prices_[symbol] = price;
         
-        // Calculate Monte Carlo price for comparison
-        MonteCarloParams mc_params;
-        mc_params.spot_price = params.spot_price;
-        mc_params.strike_price = params.strike_price;
-        mc_params.time_to_expiry = params.time_to_expiry;
-        mc_params.risk_free_rate = params.risk_free_rate;
-        mc_params.volatility = params.volatility;
-        mc_params.is_call = params.is_call;
-        mc_params.num_simulations = 100000;
-        mc_params.num_steps = 252; // Daily steps for one year
+        // Reprice the underlying's whole chain and stream what moved
+        auto surface_it = surfaces_.find(symbol);
+        auto snapshot = surface_it != surfaces_.end() ? surface_it->second.snapshot() : nullptr;
         
-        SimulationResult mc_result = brownian_motion_.priceOption(mc_params);
+        auto term_structure = TermStructureRegistry::instance().get(symbol);
+        
+        ChainDelta delta;
+        if (chain_pricer_.onUnderlyingTick(symbol, price, snapshot.get(), delta, term_structure.get())) {
+            mq_.publish("options.chain_updates", encodeChainDelta(delta));
+        }
+    }
+    
+    // Format: "SPOT_POINTS,SPOT_RANGE,VOL_POINTS,VOL_RANGE;SYMBOL,STRIKE,EXPIRY,IS_CALL,QTY[,VOL];..."
+    // with EXPIRY in years. Responds with the book's P&L per scenario, vol-major.
+    void handleScenarioRequest(const Message& msg) {
+        std::istringstream ss(msg.payload);
+        std::string section;
+        std::getline(ss, section, ';');
+        auto header = splitPayload(section);
+        if (header.size() < 4) {
+            std::cerr << "Malformed scenario request: " << msg.payload << std::endl;
+            return;
+        }
+        int spot_points = std::atoi(header[0].c_str());
+        int vol_points = std::atoi(header[2].c_str());
+        if (spot_points < 1 || spot_points > ScenarioGridSpec::MAX_POINTS ||
+            vol_points < 1 || vol_points > ScenarioGridSpec::MAX_POINTS) {
+            std::cerr << "Scenario grid must have 1 to " << ScenarioGridSpec::MAX_POINTS
+                      << " points per axis: " << msg.payload.substr(0, 100) << std::endl;
+            return;
+        }
+        ScenarioGridSpec spec = ScenarioGridSpec::uniform(spot_points, std::atof(header[1].c_str()),
+                                                          vol_points, std::atof(header[3].c_str()));
+        
+        std::vector<BookPosition> book;
+        std::unordered_map<std::string, double> spots;
+        {
+            std::lock_guard<std::mutex> lock(surfaces_mutex_);
+            while (std::getline(ss, section, ';')) {
+                auto tokens = splitPayload(section);
+                if (tokens.size() < 5) continue;
+                
+                BookPosition position;
+                position.underlying = tokens[0];
+                position.strike_price = std::atof(tokens[1].c_str());
+                position.time_to_expiry = std::atof(tokens[2].c_str());
+                position.is_call = tokens[3] == "1" || tokens[3] == "CALL" || tokens[3] == "C";
+                position.quantity = std::atof(tokens[4].c_str());
+                position.volatility = tokens.size() > 5 ? std::atof(tokens[5].c_str()) : 0.0;
+                
+                auto spot_it = spot_prices_.find(position.underlying);
+                if (spot_it == spot_prices_.end()) continue;
+                spots[position.underlying] = spot_it->second;
+                
+                auto surface_it = surfaces_.find(position.underlying);
+                if (position.volatility <= 0.0 && surface_it != surfaces_.end()) {
+                    position.volatility = surface_it->second.getVolatility(position.strike_price,
+                                                                           position.time_to_expiry, spot_it->second);
+                }
+                if (position.volatility <= 0.0) position.volatility = 0.20;
+                book.push_back(position);
+            }
+        }
+        
+        std::vector<double> totals = scenario_pricer_.price(book, spots, spec).total();
+        
+        std::ostringstream response;
+        response << std::fixed << std::setprecision(2);
+        response << "SCENARIO_GRID," << spec.vol_shifts.size() << "," << spec.spot_shifts.size();
+        for (double pnl : totals) response << "," << pnl;
+        response << "," << msg.correlation_id;
+        mq_.publish("options.scenario_response", response.str());
+    }
+    
+    // Format: "SYMBOL,DIVIDEND_YIELD,BORROW_RATE[,CURVE[,DIVIDENDS]]" where CURVE
+    // is "T:RATE;T:RATE..." (T in years) and DIVIDENDS is "YYYY-MM-DD:AMOUNT;..."
+    // keyed by ex-date
+    void handleTermStructure(const Message& msg) {
+        auto tokens = splitPayload(msg.payload);
+        if (tokens.size() < 3) {
+            std::cerr << "Malformed term structure: " << msg.payload << std::endl;
+            return;
+        }
+        
+        auto parsePairs = [](const std::string& text) {
+            std::vector<std::pair<double, double>> pairs;
+            std::istringstream ss(text);
+            std::string item;
+            while (std::getline(ss, item, ';')) {
+                size_t colon = item.find(':');
+                if (colon == std::string::npos) continue;
+                pairs.emplace_back(std::atof(item.substr(0, colon).c_str()), std::atof(item.substr(colon + 1).c_str()));
+            }
+            return pairs;
+        };
+        
+        YieldCurve rates(0.05);
+        if (tokens.size() > 3 && !tokens[3].empty()) {
+            std::vector<double> times, zero_rates;
+            for (const auto& [t, r] : parsePairs(tokens[3])) {
+                times.push_back(t);
+                zero_rates.push_back(r);
+            }
+            rates = YieldCurve(times, zero_rates);
+        }
+        std::vector<DatedDividend> dividends;
+        if (tokens.size() > 4) {
+            std::istringstream ss(tokens[4]);
+            std::string item;
+            while (std::getline(ss, item, ';')) {
+                size_t colon = item.find(':');
+                if (colon == std::string::npos) continue;
+                int32_t ex_date = packExpiry(item.substr(0, colon));
+                if (ex_date == 0) continue;
+                dividends.push_back({ex_date, std::atof(item.substr(colon + 1).c_str())});
+            }
+        }
+        
+        TermStructureRegistry::instance().publish(tokens[0], std::make_shared<const TermStructure>(
+            rates, std::atof(tokens[1].c_str()), dividends, YieldCurve(std::atof(tokens[2].c_str()))));
+    }
+    
+    // Add a listed contract to its underlying's streamed chain, announcing new ids.
+    // Format: "CHAIN_CONTRACT,UNDERLYING,ID,STRIKE,YYYY-MM-DD,CALL|PUT"
+    void registerContract(const std::string& underlying, double strike_price, int32_t expiry_date, bool is_call) {
+        size_t before = chain_pricer_.numContracts();
+        uint32_t id = chain_pricer_.addContract(underlying, strike_price, expiry_date, is_call);
+        if (id == ChainPricer::INVALID_CONTRACT || chain_pricer_.numContracts() == before) return;
+        
+        std::ostringstream contract;
+        contract << "CHAIN_CONTRACT," << underlying << "," << id << "," << strike_price << ","
+                 << formatExpiry(expiry_date) << "," << (is_call ? "CALL" : "PUT");
+        mq_.publish("options.chain_contracts", contract.str());
+    }
+    
+    void handleOptionsData(const Message& msg) {
+        if (isBinaryTick(msg.payload)) {
+            TickReader reader(msg.payload);
+            while (reader.next()) {
+                if (reader.kind() != TickKind::OPTION_QUOTE) continue;
+                VolQuote quote;
+                quote.strike_price = reader.strike();
+                quote.expiry_date = reader.expiry();
+                quote.is_call = reader.isCall();
+                quote.price = reader.optionPrice();
+                quote.implied_vol = reader.impliedVol();
+                addOptionQuote(std::string(reader.symbol(), reader.symbolLength()), quote);
+            }
+            return;
+        }
+        
+        // Format: "OPTIONS_DATA,UNDERLYING,STRIKE,EXPIRATION,TYPE,PRICE,IV,DELTA"
+        auto tokens = splitPayload(msg.payload);
+        if (tokens.size() < 8 || tokens[0] != "OPTIONS_DATA") return;
+        
+        VolQuote quote;
+        quote.strike_price = std::atof(tokens[2].c_str());
+        quote.expiry_date = packExpiry(tokens[3]);
+        quote.is_call = tokens[4] == "call" || tokens[4] == "CALL" || tokens[4] == "C";
+        quote.price = std::atof(tokens[5].c_str());
+        quote.implied_vol = std::atof(tokens[6].c_str());
+        addOptionQuote(tokens[1], quote);
+    }
+    
+    void addOptionQuote(const std::string& underlying, VolQuote quote) {
+        std::lock_guard<std::mutex> lock(surfaces_mutex_);
+        auto spot_it = spot_prices_.find(underlying);
+        if (spot_it == spot_prices_.end()) return; // Need the underlying to place the quote
+        quote.underlying_price = spot_it->second;
+        
+        auto it = surfaces_.find(underlying);
+        if (it == surfaces_.end()) {
+            it = surfaces_.emplace(underlying, VolatilitySurface(underlying)).first;
+        }
+        it->second.addQuote(quote);
+        
+        registerContract(underlying, quote.strike_price, quote.expiry_date, quote.is_call);
+    }
+    
+    enum class PricingModel {
+        BLACK_SCHOLES,  // Closed form, European
+        AMERICAN,       // Leisen-Reimer lattice
+        MONTE_CARLO     // European, pathwise Greeks
+    };
+    
+    // Format: "SYMBOL,STRIKE,EXPIRY,IS_CALL[,SPOT,VOL,RATE,MODEL]"; EXPIRY is a
+    // YYYY-MM-DD date or a year fraction, MODEL is BS (default), AMERICAN or MC.
+    // Missing or empty spot/vol come from the latest tick and the symbol's
+    // surface, a missing or empty rate from its term structure. dividends
+    // receives the cash dividends apply() took out of the spot.
+    bool parsePricingRequest(const Message& msg, std::string& symbol, OptionParams& params,
+                             PricingModel& model, std::vector<CashDividend>& dividends) {
+        auto tokens = splitPayload(msg.payload);
+        if (tokens.size() < 4) {
+            std::cerr << "Malformed pricing request: " << msg.payload << std::endl;
+            return false;
+        }
+        
+        symbol = tokens[0];
+        params.strike_price = std::atof(tokens[1].c_str());
+        params.time_to_expiry = tokens[2].find('-') != std::string::npos ? yearsToExpiry(tokens[2])
+                                                                          : std::atof(tokens[2].c_str());
+        params.is_call = tokens[3] == "1" || tokens[3] == "true" || tokens[3] == "CALL" || tokens[3] == "C";
+        params.spot_price = tokens.size() > 4 ? std::atof(tokens[4].c_str()) : 0.0;
+        params.volatility = tokens.size() > 5 ? std::atof(tokens[5].c_str()) : 0.0;
+        bool explicit_rate = tokens.size() > 6 && !tokens[6].empty();
+        params.risk_free_rate = explicit_rate ? std::atof(tokens[6].c_str()) : 0.05;
+        
+        model = PricingModel::BLACK_SCHOLES;
+        if (tokens.size() > 7) {
+            if (tokens[7] == "AMERICAN") {
+                model = PricingModel::AMERICAN;
+            } else if (tokens[7] == "MC") {
+                model = PricingModel::MONTE_CARLO;
+            } else if (!tokens[7].empty() && tokens[7] != "BS") {
+                std::cerr << "Unknown pricing model: " << msg.payload << std::endl;
+                return false;
+            }
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(surfaces_mutex_);
+            if (params.spot_price <= 0.0) {
+                auto spot_it = spot_prices_.find(symbol);
+                if (spot_it != spot_prices_.end()) params.spot_price = spot_it->second;
+            }
+            if (params.volatility <= 0.0 && params.spot_price > 0.0) {
+                auto surface_it = surfaces_.find(symbol);
+                if (surface_it != surfaces_.end()) {
+                    params.volatility = surface_it->second.getVolatility(params.strike_price, params.time_to_expiry,
+                                                                         params.spot_price);
+                }
+            }
+        }
+        if (params.volatility <= 0.0) params.volatility = 0.20;
+        
+        if (params.spot_price <= 0.0 || params.strike_price <= 0.0) {
+            std::cerr << "No spot price for pricing request: " << msg.payload << std::endl;
+            return false;
+        }
+        
+        // Without an explicit rate, price off the symbol's curve, dividends and borrow
+        if (!explicit_rate) {
+            if (auto term_structure = TermStructureRegistry::instance().get(symbol)) {
+                params = term_structure->apply(params);
+                dividends = term_structure->cashDividends(params.time_to_expiry);
+            }
+        }
+        return true;
+    }
+    
+    // Black-Scholes costs less than a cache lookup, so only the lattice and
+    // Monte Carlo results are cached. params.spot_price is net of dividends
+    // (apply()). Monte Carlo is European, so a spot haircut S*exp(-qT) covers
+    // the continuous carry; the lattice drifts at r - q instead and gets the
+    // dividends back as dated cash amounts, since early exercise depends on
+    // when they are paid.
+    PricedContract priceContract(const OptionParams& params, PricingModel model,
+                                 const std::vector<CashDividend>& dividends) {
+        switch (model) {
+            case PricingModel::AMERICAN:
+                return lattice_cache_.getOrCompute(params, [this, &dividends](const OptionParams& p) {
+                    LatticeParams lattice_params;
+                    // Undo the escrow at the lattice's own rate; it takes the same PV back out
+                    double dividend_pv = 0.0;
+                    for (const auto& dividend : dividends) {
+                        dividend_pv += dividend.amount * std::exp(-p.risk_free_rate * dividend.time);
+                    }
+                    lattice_params.spot_price = p.spot_price + dividend_pv;
+                    lattice_params.strike_price = p.strike_price;
+                    lattice_params.time_to_expiry = p.time_to_expiry;
+                    lattice_params.risk_free_rate = p.risk_free_rate;
+                    lattice_params.volatility = p.volatility;
+                    lattice_params.is_call = p.is_call;
+                    lattice_params.carry_yield = p.dividend_yield;
+                    lattice_params.dividends = dividends;
+                    lattice_params.num_steps = 201;
+                    lattice_params.lattice_type = LatticeType::LEISEN_REIMER;
+                    lattice_params.bump_vega_rho = true;
+                    LatticeResult result = lattice_pricer_.price(lattice_params);
+                    return PricedContract{result.price, result.greeks};
+                });
+            case PricingModel::MONTE_CARLO:
+                return monte_carlo_cache_.getOrCompute(params, [this](const OptionParams& p) {
+                    MonteCarloParams mc_params;
+                    mc_params.spot_price = p.spot_price * std::exp(-p.dividend_yield * p.time_to_expiry);
+                    mc_params.strike_price = p.strike_price;
+                    mc_params.time_to_expiry = p.time_to_expiry;
+                    mc_params.risk_free_rate = p.risk_free_rate;
+                    mc_params.volatility = p.volatility;
+                    mc_params.is_call = p.is_call;
+                    mc_params.num_simulations = 100000;
+                    mc_params.num_steps = 1;  // European payoff needs only the terminal price
+                    mc_params.greeks_method = GreeksMethod::PATHWISE;
+                    SimulationResult result = brownian_motion_.priceOption(mc_params);
+                    // The simulation estimates delta, gamma and vega only
+                    Greeks greeks{result.greeks.delta, result.greeks.gamma, 0.0, result.greeks.vega, 0.0};
+                    return PricedContract{result.option_price, greeks};
+                });
+            case PricingModel::BLACK_SCHOLES:
+            default:
+                return PricedContract{BlackScholes::calculatePrice(params), BlackScholes::calculateGreeks(params)};
+        }
+    }
+    
+    void handlePriceRequest(const Message& msg) {
+        std::string symbol;
+        OptionParams params;
+        PricingModel model;
+        std::vector<CashDividend> dividends;
+        if (!parsePricingRequest(msg, symbol, params, model, dividends)) return;
+        
+        PricedContract result = priceContract(params, model, dividends);
         
         // Publish results
         std::ostringstream response;
         response << std::fixed << std::setprecision(4);
-        response << "PRICE_RESPONSE," << bs_price << "," << mc_result.option_price 
-                 << "," << mc_result.standard_error << "," << msg.correlation_id;
+        response << "PRICE_RESPONSE," << symbol << "," << result.price << "," << result.greeks.delta << "," 
+                 << result.greeks.gamma << "," << result.greeks.theta << "," << result.greeks.vega << "," 
+                 << msg.correlation_id;
         
         mq_.publish("options.price_response", response.str());
-        
-        std::cout << "Black-Scholes Price: $" << bs_price << std::endl;
-        std::cout << "Monte Carlo Price: $" << mc_result.option_price 
-                  << " ± $" << mc_result.standard_error << std::endl;
     }
     
     void handleGreeksRequest(const Message& msg) {
-        std::cout << "Greeks request: " << msg.payload << std::endl;
-        
+        std::string symbol;
         OptionParams params;
-        params.spot_price = 150.0;
-        params.strike_price = 155.0;
-        params.time_to_expiry = 0.25;
-        params.risk_free_rate = 0.05;
-        params.volatility = 0.20;
-        params.is_call = true;
+        PricingModel model;
+        std::vector<CashDividend> dividends;
+        if (!parsePricingRequest(msg, symbol, params, model, dividends)) return;
         
-        Greeks greeks = BlackScholes::calculateGreeks(params);
+        Greeks greeks = priceContract(params, model, dividends).greeks;
         
         std::ostringstream response;
         response << std::fixed << std::setprecision(6);
@@ -127,10 +477,6 @@ private:
                  << "," << msg.correlation_id;
         
         mq_.publish("options.greeks_response", response.str());
-        
-        std::cout << "Greeks - Delta: " << greeks.delta << ", Gamma: " << greeks.gamma
-                  << ", Theta: " << greeks.theta << ", Vega: " << greeks.vega
-                  << ", Rho: " << greeks.rho << std::endl;
     }
     
     void handleImpliedVolRequest(const Message& msg) {
@@ -192,20 +538,60 @@ private:
         mc_params.is_call = true;
         mc_params.num_simulations = 50000;
         mc_params.num_steps = 63; // Quarterly steps
+        mc_params.greeks_method = GreeksMethod::PATHWISE;
         
         SimulationResult mc_result = brownian_motion_.priceOption(mc_params);
         std::cout << "Monte Carlo Call Price: $" << std::setprecision(2) << mc_result.option_price 
                   << " (±$" << mc_result.standard_error << ")" << std::endl;
         std::cout << "95% CI: [$" << mc_result.confidence_interval_lower 
                   << ", $" << mc_result.confidence_interval_upper << "]" << std::endl;
+        std::cout << "Monte Carlo Delta: " << std::setprecision(4) << mc_result.greeks.delta
+                  << ", Gamma: " << mc_result.greeks.gamma
+                  << ", Vega: " << mc_result.greeks.vega << std::endl;
+        
+        // American exercise on a lattice
+        LatticeParams lattice_params;
+        lattice_params.spot_price = params.spot_price;
+        lattice_params.strike_price = params.strike_price;
+        lattice_params.time_to_expiry = params.time_to_expiry;
+        lattice_params.risk_free_rate = params.risk_free_rate;
+        lattice_params.volatility = params.volatility;
+        lattice_params.is_call = false;
+        lattice_params.lattice_type = LatticeType::LEISEN_REIMER;
+        
+        LatticeResult american_put = lattice_pricer_.price(lattice_params);
+        std::cout << "American Put (Leisen-Reimer): $" << std::setprecision(2) << american_put.price
+                  << ", Delta: " << std::setprecision(4) << american_put.greeks.delta
+                  << ", Gamma: " << american_put.greeks.gamma << std::endl;
+        
+        // Heston smile: one FFT prices the whole expiry
+        HestonModel heston({0.04, 1.5, 0.04, 0.5, -0.7});
+        std::vector<double> strikes = {90.0, 100.0, 110.0};
+        std::vector<double> heston_prices = heston.priceSlice(params.spot_price, params.time_to_expiry,
+                                                              params.risk_free_rate, strikes, {true, true, true});
+        std::cout << "Heston Calls:";
+        for (size_t i = 0; i < strikes.size(); i++) {
+            std::cout << " K=" << std::setprecision(0) << strikes[i] << " $" << std::setprecision(2) << heston_prices[i];
+        }
+        std::cout << std::endl;
     }
     
     void updateVolatilitySurface() {
-        // Simulate updating volatility surface from market data
-        std::cout << "Updating volatility surface..." << std::endl;
+        std::lock_guard<std::mutex> lock(surfaces_mutex_);
         
-        // In real implementation, would fetch market data and calculate implied volatilities
-        // for different strikes and expirations to build volatility surface
+        // Only expiries with new quotes since the last pass are refitted
+        for (auto& [symbol, surface] : surfaces_) {
+            int refitted = surface.refit();
+            if (refitted == 0) continue;
+            
+            // Readers pick up the new snapshot on their next access
+            VolatilitySurfaceRegistry::instance().get(symbol)->publish(surface.snapshot());
+            
+            std::cout << "Volatility surface " << symbol << ": refitted " << refitted 
+                      << "/" << surface.numSlices() << " expiries, 30d ATM vol " 
+                      << std::setprecision(2) << (surface.getATMVolatility(30.0 / 365.0) * 100) 
+                      << "%" << std::endl;
+        }
     }
 };
 
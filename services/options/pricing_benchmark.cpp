@@ -0,0 +1,446 @@
+#include "black_scholes.h"
+#include "brownian_motion.h"
+#include "lattice_pricer.h"
+#include "heston.h"
+#include "local_volatility.h"
+#include "volatility_surface.h"
+#include "common/fast_math.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+// Speed and accuracy harness for the pricing engines. Every timing is
+// reported per contract (or per call for the math kernels) together with the
+// worst absolute error against a long double Black-Scholes reference over a
+// grid of moneyness, expiry and volatility. Run before switching any pricing
+// path to a faster math tier.
+
+using namespace hedgefund::options;
+namespace math = hedgefund::common::math;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps results alive so the optimizer cannot drop the timed loops
+volatile double g_sink = 0.0;
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Reference normal CDF and Black-Scholes price in extended precision
+long double referenceCdf(long double x) {
+    return 0.5L * std::erfc(-x / std::sqrt(2.0L));
+}
+
+double referencePrice(const OptionParams& p) {
+    long double s = p.spot_price, k = p.strike_price, t = p.time_to_expiry;
+    long double r = p.risk_free_rate, v = p.volatility;
+    long double sqrt_t = std::sqrt(t);
+    long double d1 = (std::log(s / k) + (r + 0.5L * v * v) * t) / (v * sqrt_t);
+    long double d2 = d1 - v * sqrt_t;
+    long double df = std::exp(-r * t);
+    long double price = p.is_call ? s * referenceCdf(d1) - k * df * referenceCdf(d2)
+                                  : k * df * referenceCdf(-d2) - s * referenceCdf(-d1);
+    return static_cast<double>(price);
+}
+
+double referenceDelta(const OptionParams& p) {
+    long double v = p.volatility, t = p.time_to_expiry;
+    long double d1 = (std::log(static_cast<long double>(p.spot_price) / p.strike_price) +
+                      (p.risk_free_rate + 0.5L * v * v) * t) / (v * std::sqrt(t));
+    return static_cast<double>(p.is_call ? referenceCdf(d1) : referenceCdf(d1) - 1.0L);
+}
+
+// Black-Scholes with a selectable math tier, to see what each tier costs in price error
+template <math::Accuracy A>
+double priceWithAccuracy(const OptionParams& p) {
+    double sqrt_t = std::sqrt(p.time_to_expiry);
+    double vol_sqrt_t = p.volatility * sqrt_t;
+    double d1 = (math::log<A>(p.spot_price / p.strike_price) +
+                 (p.risk_free_rate + 0.5 * p.volatility * p.volatility) * p.time_to_expiry) / vol_sqrt_t;
+    double d2 = d1 - vol_sqrt_t;
+    double df = math::exp<A>(-p.risk_free_rate * p.time_to_expiry);
+    return p.is_call ? p.spot_price * math::normCdf<A>(d1) - p.strike_price * df * math::normCdf<A>(d2)
+                     : p.strike_price * df * math::normCdf<A>(-d2) - p.spot_price * math::normCdf<A>(-d1);
+}
+
+std::vector<OptionParams> buildGrid() {
+    const double moneyness[] = {0.70, 0.80, 0.90, 0.95, 1.00, 1.05, 1.10, 1.20, 1.30};
+    const double expiries[] = {1.0 / 52.0, 1.0 / 12.0, 0.25, 0.5, 1.0, 2.0};
+    const double vols[] = {0.10, 0.20, 0.40, 0.80};
+
+    std::vector<OptionParams> grid;
+    for (double m : moneyness) {
+        for (double t : expiries) {
+            for (double v : vols) {
+                for (bool is_call : {true, false}) {
+                    grid.push_back({100.0, 100.0 * m, t, 0.05, v, is_call});
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+void printHeader(const std::string& title) {
+    std::cout << "\n" << title << "\n"
+              << std::left << std::setw(34) << "  case" << std::right
+              << std::setw(14) << "ns/contract" << std::setw(16) << "max abs err" << std::endl;
+}
+
+void printRow(const std::string& name, double ns, double max_error) {
+    std::cout << std::left << std::setw(34) << ("  " + name) << std::right
+              << std::fixed << std::setprecision(1) << std::setw(14) << ns
+              << std::scientific << std::setprecision(2) << std::setw(16) << max_error
+              << std::defaultfloat << std::endl;
+}
+
+template <typename Fn>
+void benchKernel(const std::string& name, const std::vector<double>& inputs, Fn fn,
+                 long double (*reference)(long double), bool relative) {
+    const int repeats = 20;
+    double sum = 0.0;
+    auto start = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        for (double x : inputs) sum += fn(x);
+    }
+    double ns = elapsedNs(start) / (repeats * inputs.size());
+    g_sink = g_sink + sum;
+
+    double max_error = 0.0;
+    for (double x : inputs) {
+        long double expected = reference(x);
+        double error = std::abs(static_cast<double>(fn(x) - expected));
+        if (relative && expected != 0.0L) error /= std::abs(static_cast<double>(expected));
+        max_error = std::max(max_error, error);
+    }
+    printRow(name, ns, max_error);
+}
+
+void benchMathKernels() {
+    std::cout << "\nMath kernels (ns/call, error relative for exp/log, absolute for cdf)" << std::endl;
+
+    std::vector<double> cdf_inputs, exp_inputs, log_inputs;
+    for (int i = 0; i < 100000; i++) {
+        double u = i / 100000.0;
+        cdf_inputs.push_back(-8.0 + 16.0 * u);
+        exp_inputs.push_back(-50.0 + 100.0 * u);
+        log_inputs.push_back(1e-6 + 1e3 * u * u);
+    }
+
+    auto ref_exp = [](long double x) { return std::exp(x); };
+    auto ref_log = [](long double x) { return std::log(x); };
+
+    benchKernel("normCdf EXACT", cdf_inputs, math::normCdf<math::Accuracy::EXACT>, referenceCdf, false);
+    benchKernel("normCdf HIGH", cdf_inputs, math::normCdf<math::Accuracy::HIGH>, referenceCdf, false);
+    benchKernel("normCdf FAST", cdf_inputs, math::normCdf<math::Accuracy::FAST>, referenceCdf, false);
+    benchKernel("exp EXACT", exp_inputs, math::exp<math::Accuracy::EXACT>, +ref_exp, true);
+    benchKernel("exp HIGH", exp_inputs, math::exp<math::Accuracy::HIGH>, +ref_exp, true);
+    benchKernel("exp FAST", exp_inputs, math::exp<math::Accuracy::FAST>, +ref_exp, true);
+    benchKernel("log EXACT", log_inputs, math::log<math::Accuracy::EXACT>, +ref_log, true);
+    benchKernel("log HIGH", log_inputs, math::log<math::Accuracy::HIGH>, +ref_log, true);
+    benchKernel("log FAST", log_inputs, math::log<math::Accuracy::FAST>, +ref_log, true);
+
+    // Batch exp over a whole vector, the form the Monte Carlo engine uses
+    std::vector<double> out(exp_inputs.size());
+    auto start = Clock::now();
+    for (int r = 0; r < 20; r++) math::expBatch(exp_inputs.data(), out.data(), out.size());
+    double ns = elapsedNs(start) / (20.0 * out.size());
+    double max_error = 0.0;
+    for (size_t i = 0; i < out.size(); i++) {
+        long double expected = std::exp(static_cast<long double>(exp_inputs[i]));
+        max_error = std::max(max_error, static_cast<double>(std::abs((out[i] - expected) / expected)));
+    }
+    printRow("expBatch HIGH", ns, max_error);
+}
+
+template <typename Fn>
+void benchPricing(const std::string& name, const std::vector<OptionParams>& grid,
+                  const std::vector<double>& reference, int repeats, Fn fn) {
+    double sum = 0.0;
+    auto start = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        for (const auto& p : grid) sum += fn(p);
+    }
+    double ns = elapsedNs(start) / (static_cast<double>(repeats) * grid.size());
+    g_sink = g_sink + sum;
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < grid.size(); i++) {
+        max_error = std::max(max_error, std::abs(fn(grid[i]) - reference[i]));
+    }
+    printRow(name, ns, max_error);
+}
+
+void benchBlackScholes(const std::vector<OptionParams>& grid, const std::vector<double>& reference) {
+    printHeader("Black-Scholes (" + std::to_string(grid.size()) + " contracts)");
+
+    benchPricing("calculatePrice", grid, reference, 200, BlackScholes::calculatePrice);
+    benchPricing("tier EXACT", grid, reference, 200, priceWithAccuracy<math::Accuracy::EXACT>);
+    benchPricing("tier HIGH", grid, reference, 200, priceWithAccuracy<math::Accuracy::HIGH>);
+    benchPricing("tier FAST", grid, reference, 200, priceWithAccuracy<math::Accuracy::FAST>);
+
+    std::vector<double> reference_delta;
+    for (const auto& p : grid) reference_delta.push_back(referenceDelta(p));
+    benchPricing("calculateGreeks (delta error)", grid, reference_delta, 200, [](const OptionParams& p) {
+        return BlackScholes::calculateGreeks(p).delta;
+    });
+
+    // Batch path: one spot and rate per call, as in chain repricing
+    const size_t n = grid.size();
+    std::vector<double> strike(n), expiry(n), vol(n), price(n), delta(n), gamma(n), theta(n), vega(n);
+    std::vector<uint8_t> is_call(n);
+    for (size_t i = 0; i < n; i++) {
+        strike[i] = grid[i].strike_price;
+        expiry[i] = grid[i].time_to_expiry;
+        vol[i] = grid[i].volatility;
+        is_call[i] = grid[i].is_call;
+    }
+    OptionBatch batch{n, strike.data(), expiry.data(), vol.data(), is_call.data(),
+                      price.data(), delta.data(), gamma.data(), theta.data(), vega.data()};
+
+    const int repeats = 200;
+    auto start = Clock::now();
+    for (int r = 0; r < repeats; r++) BlackScholes::calculateBatch(100.0, 0.05, batch);
+    double ns = elapsedNs(start) / (static_cast<double>(repeats) * n);
+    double max_error = 0.0;
+    for (size_t i = 0; i < n; i++) max_error = std::max(max_error, std::abs(price[i] - reference[i]));
+    printRow("calculateBatch (price + greeks)", ns, max_error);
+}
+
+void benchScenarioGrid(const std::vector<OptionParams>& grid) {
+    // 21 spot x 11 vol scenarios per contract, the risk grid shape
+    printHeader("Scenario grid, 21 x 11 per contract (ns per scenario)");
+
+    std::vector<double> spot_scenarios(21), vol_shifts(11), vol_scenarios(11), prices(21 * 11);
+    for (int s = 0; s < 21; s++) spot_scenarios[s] = 100.0 * (0.9 + 0.01 * s);
+    for (int v = 0; v < 11; v++) vol_shifts[v] = -0.05 + 0.01 * v;
+
+    const int repeats = 5;
+    double sum = 0.0;
+    auto start = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        for (const auto& p : grid) {
+            for (int v = 0; v < 11; v++) vol_scenarios[v] = std::max(0.01, p.volatility + vol_shifts[v]);
+            BlackScholes::calculatePriceGrid(p, spot_scenarios.data(), 21, vol_scenarios.data(), 11, prices.data());
+            sum += prices[0];
+        }
+    }
+    double ns = elapsedNs(start) / (static_cast<double>(repeats) * grid.size() * prices.size());
+    g_sink = g_sink + sum;
+
+    double max_error = 0.0;
+    for (const auto& p : grid) {
+        for (int v = 0; v < 11; v++) vol_scenarios[v] = std::max(0.01, p.volatility + vol_shifts[v]);
+        BlackScholes::calculatePriceGrid(p, spot_scenarios.data(), 21, vol_scenarios.data(), 11, prices.data());
+        for (int v = 0; v < 11; v++) {
+            for (int s = 0; s < 21; s++) {
+                OptionParams scenario = p;
+                scenario.spot_price = spot_scenarios[s];
+                scenario.volatility = vol_scenarios[v];
+                max_error = std::max(max_error, std::abs(prices[v * 21 + s] - referencePrice(scenario)));
+            }
+        }
+    }
+    printRow("calculatePriceGrid", ns, max_error);
+}
+
+void benchImpliedVolatility(const std::vector<OptionParams>& grid, const std::vector<double>& reference) {
+    // Deep wings have almost no vega, where a price tolerance says nothing about vol
+    std::vector<OptionParams> solvable;
+    std::vector<double> prices;
+    for (size_t i = 0; i < grid.size(); i++) {
+        if (BlackScholes::calculateGreeks(grid[i]).vega > 0.01) {
+            solvable.push_back(grid[i]);
+            prices.push_back(reference[i]);
+        }
+    }
+
+    printHeader("Implied volatility (" + std::to_string(solvable.size()) + " contracts, error in vol)");
+
+    double sum = 0.0, max_error = 0.0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < solvable.size(); i++) {
+        double vol = BlackScholes::impliedVolatility(prices[i], solvable[i]);
+        sum += vol;
+        max_error = std::max(max_error, std::abs(vol - solvable[i].volatility));
+    }
+    double ns = elapsedNs(start) / solvable.size();
+    g_sink = g_sink + sum;
+    printRow("impliedVolatility (bisection)", ns, max_error);
+}
+
+void benchMonteCarlo() {
+    std::cout << "\nMonte Carlo, ATM call S=100 K=100 T=0.5 vol=0.2, 50 steps\n"
+              << std::left << std::setw(14) << "  paths" << std::right
+              << std::setw(14) << "paths/s" << std::setw(14) << "std error"
+              << std::setw(14) << "abs error" << std::endl;
+
+    OptionParams bs_params{100.0, 100.0, 0.5, 0.05, 0.2, true};
+    double reference = referencePrice(bs_params);
+
+    BrownianMotion engine(42);
+    for (int paths : {10000, 40000, 160000}) {
+        MonteCarloParams params;
+        params.spot_price = bs_params.spot_price;
+        params.strike_price = bs_params.strike_price;
+        params.time_to_expiry = bs_params.time_to_expiry;
+        params.risk_free_rate = bs_params.risk_free_rate;
+        params.volatility = bs_params.volatility;
+        params.is_call = true;
+        params.num_simulations = paths;
+        params.num_steps = 50;
+
+        auto start = Clock::now();
+        SimulationResult result = engine.priceOption(params);
+        double seconds = elapsedNs(start) * 1e-9;
+
+        std::cout << std::left << std::setw(14) << ("  " + std::to_string(paths)) << std::right
+                  << std::fixed << std::setprecision(0) << std::setw(14) << paths / seconds
+                  << std::setprecision(4) << std::setw(14) << result.standard_error
+                  << std::setw(14) << std::abs(result.option_price - reference)
+                  << std::defaultfloat << std::endl;
+    }
+}
+
+void benchLattice(const std::vector<OptionParams>& grid, const std::vector<double>& reference) {
+    // European exercise so the Black-Scholes reference applies
+    printHeader("Lattice, European exercise, 201 steps");
+
+    const std::pair<const char*, LatticeType> types[] = {
+        {"CRR", LatticeType::CRR},
+        {"Leisen-Reimer", LatticeType::LEISEN_REIMER},
+        {"Trinomial", LatticeType::TRINOMIAL},
+    };
+
+    LatticePricer pricer;
+    for (const auto& [name, type] : types) {
+        benchPricing(name, grid, reference, 1, [&pricer, type = type](const OptionParams& p) {
+            LatticeParams params;
+            params.spot_price = p.spot_price;
+            params.strike_price = p.strike_price;
+            params.time_to_expiry = p.time_to_expiry;
+            params.risk_free_rate = p.risk_free_rate;
+            params.volatility = p.volatility;
+            params.is_call = p.is_call;
+            params.is_american = false;
+            params.num_steps = 201;
+            params.lattice_type = type;
+            return pricer.price(params).price;
+        });
+    }
+}
+
+// Quotes on a strike x expiry grid priced by a known Heston model, so
+// calibration and local vol can be checked against the model that made them
+std::vector<VolQuote> hestonQuotes(const HestonParams& truth, const std::vector<double>& expiries) {
+    HestonModel model(truth);
+    std::vector<double> strikes;
+    std::vector<bool> is_call;
+    for (double k = 80.0; k <= 120.0; k += 5.0) {
+        strikes.push_back(k);
+        is_call.push_back(k >= 100.0);
+    }
+
+    std::vector<VolQuote> quotes;
+    for (double years : expiries) {
+        int32_t expiry_date = expiryDateAfter(years);
+        std::vector<double> prices = model.priceSlice(100.0, yearsToExpiry(expiry_date), 0.05, strikes, is_call);
+        for (size_t i = 0; i < strikes.size(); i++) {
+            quotes.push_back({strikes[i], expiry_date, 100.0, prices[i], 0.0, is_call[i]});
+        }
+    }
+    return quotes;
+}
+
+void benchHeston() {
+    const HestonParams truth{0.04, 1.5, 0.05, 0.6, -0.7};
+    std::vector<VolQuote> quotes = hestonQuotes(truth, {1.0 / 12.0, 0.25, 0.5, 1.0});
+
+    std::cout << "\nHeston, " << quotes.size() << " quotes over 4 expiries" << std::endl;
+
+    HestonModel model(truth);
+    std::vector<double> strikes(quotes.size());
+    std::vector<bool> is_call(quotes.size(), true);
+    for (size_t i = 0; i < quotes.size(); i++) strikes[i] = quotes[i].strike_price;
+    const int repeats = 50;
+    auto start = Clock::now();
+    for (int r = 0; r < repeats; r++) {
+        g_sink = g_sink + model.priceSlice(100.0, 0.5, 0.05, strikes, is_call)[0];
+    }
+    std::cout << "  priceSlice (one FFT)        " << std::fixed << std::setprecision(1)
+              << elapsedNs(start) / (repeats * 1000.0) << " us/slice" << std::endl;
+
+    start = Clock::now();
+    HestonModel::CalibrationResult fit = HestonModel::calibrate(quotes, 0.05, {0.06, 1.0, 0.06, 0.4, -0.3});
+    std::cout << "  calibrate                   " << std::setprecision(1) << elapsedNs(start) * 1e-6 << " ms, "
+              << fit.evaluations << " evaluations, rmse " << std::scientific << std::setprecision(2)
+              << fit.rmse_vol << std::fixed << std::endl
+              << std::setprecision(3) << "  fitted v0 " << fit.params.v0 << " kappa " << fit.params.kappa
+              << " theta " << fit.params.theta << " sigma " << fit.params.sigma << " rho " << fit.params.rho
+              << " (truth " << truth.v0 << " " << truth.kappa << " " << truth.theta << " " << truth.sigma
+              << " " << truth.rho << ")" << std::defaultfloat << std::endl;
+}
+
+void benchLocalVolatility() {
+    // SVI surface fitted to Heston quotes; Dupire local vol should reprice them
+    const HestonParams truth{0.04, 1.5, 0.05, 0.6, -0.7};
+    VolatilitySurface surface("BENCH", 0.05);
+    for (const auto& quote : hestonQuotes(truth, {1.0 / 12.0, 0.25, 0.5, 0.75, 1.0})) surface.addQuote(quote);
+    surface.refit();
+
+    auto start = Clock::now();
+    LocalVolatilityModel local_vol(surface.snapshot(), 100.0, 0.05, 1.0);
+    double build_ms = elapsedNs(start) * 1e-6;
+
+    std::cout << "\nLocal volatility from the fitted surface (grid built in " << std::fixed << std::setprecision(2)
+              << build_ms << " ms), T=0.5, 40000 paths x 100 steps\n"
+              << std::left << std::setw(14) << "  strike" << std::right << std::setw(14) << "heston"
+              << std::setw(14) << "local vol" << std::setw(14) << "std error" << std::endl;
+
+    HestonModel heston(truth);
+    for (double strike : {90.0, 100.0, 110.0}) {
+        MonteCarloParams params;
+        params.spot_price = 100.0;
+        params.strike_price = strike;
+        params.time_to_expiry = 0.5;
+        params.risk_free_rate = 0.05;
+        params.is_call = true;
+        params.num_simulations = 40000;
+        params.num_steps = 100;
+        SimulationResult result = local_vol.priceOption(params);
+
+        std::cout << std::left << std::setw(14) << ("  " + std::to_string(static_cast<int>(strike))) << std::right
+                  << std::setprecision(4) << std::setw(14) << heston.price({100.0, strike, 0.5, 0.05, 0.0, true})
+                  << std::setw(14) << result.option_price << std::setw(14) << result.standard_error << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "=== Options Pricing Benchmark ===" << std::endl;
+
+    std::vector<OptionParams> grid = buildGrid();
+    std::vector<double> reference;
+    reference.reserve(grid.size());
+    for (const auto& p : grid) reference.push_back(referencePrice(p));
+
+    benchMathKernels();
+    benchBlackScholes(grid, reference);
+    benchScenarioGrid(grid);
+    benchImpliedVolatility(grid, reference);
+    benchMonteCarlo();
+    benchLattice(grid, reference);
+    benchHeston();
+    benchLocalVolatility();
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "pricing_cache.h"
+#include <cmath>
+
+namespace hedgefund {
+namespace options {
+
+PricingKey PricingKey::fromParams(const OptionParams& params) {
+    PricingKey key;
+    key.spot = std::llround(params.spot_price * 1e4);
+    key.strike = std::llround(params.strike_price * 1e4);
+    key.expiry = std::llround(params.time_to_expiry * 1e6);
+    key.vol = std::llround(params.volatility * 1e6);
+    key.rate = std::llround(params.risk_free_rate * 1e6);
+    key.carry = std::llround(params.dividend_yield * 1e6);
+    key.is_call = params.is_call;
+    return key;
+}
+
+bool PricingKey::operator==(const PricingKey& other) const {
+    return spot == other.spot && strike == other.strike && expiry == other.expiry &&
+           vol == other.vol && rate == other.rate && carry == other.carry && is_call == other.is_call;
+}
+
+size_t PricingKeyHash::operator()(const PricingKey& key) const {
+    // 64-bit FNV-1a style mix over the fields
+    uint64_t hash = 1469598103934665603ULL;
+    for (int64_t field : {key.spot, key.strike, key.expiry, key.vol, key.rate, key.carry,
+                           static_cast<int64_t>(key.is_call)}) {
+        hash ^= static_cast<uint64_t>(field);
+        hash *= 1099511628211ULL;
+    }
+    return static_cast<size_t>(hash);
+}
+
+PricingCache::PricingCache(std::chrono::milliseconds ttl, size_t max_entries)
+    : ttl_(ttl), max_entries_(max_entries) {}
+
+PricedContract PricingCache::getOrCompute(const OptionParams& params, const ComputeFn& compute) {
+    PricingKey key = PricingKey::fromParams(params);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            if (it->second.expires_at > Clock::now()) {
+                recency_.splice(recency_.begin(), recency_, it->second.recency);
+                stats_.hits++;
+                return it->second.result;
+            }
+            recency_.erase(it->second.recency);
+            entries_.erase(it);
+        }
+        stats_.misses++;
+    }
+
+    PricedContract value = compute(params);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto expires_at = Clock::now() + ttl_;
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        // Another thread computed the same key meanwhile; keep the newer result
+        it->second.result = value;
+        it->second.expires_at = expires_at;
+        recency_.splice(recency_.begin(), recency_, it->second.recency);
+        return value;
+    }
+
+    while (!entries_.empty() && entries_.size() >= max_entries_) {
+        entries_.erase(recency_.back());
+        recency_.pop_back();
+        stats_.evictions++;
+    }
+    recency_.push_front(key);
+    entries_.emplace(key, Entry{value, expires_at, recency_.begin()});
+    return value;
+}
+
+PricingCache::Stats PricingCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+size_t PricingCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace options
+} // namespace hedgefund
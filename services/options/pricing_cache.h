@@ -0,0 +1,72 @@
+#pragma once
+
+#include "black_scholes.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace hedgefund {
+namespace options {
+
+// Inputs rounded to the resolution at which two requests count as identical
+struct PricingKey {
+    int64_t spot;    // 1e-4
+    int64_t strike;  // 1e-4
+    int64_t expiry;  // 1e-6 years (~30s)
+    int64_t vol;     // 1e-6
+    int64_t rate;    // 1e-6
+    int64_t carry;   // 1e-6, dividend yield plus borrow
+    bool is_call;
+
+    static PricingKey fromParams(const OptionParams& params);
+    bool operator==(const PricingKey& other) const;
+};
+
+struct PricingKeyHash {
+    size_t operator()(const PricingKey& key) const;
+};
+
+// TTL result cache for the expensive models (lattice, Monte Carlo). Holds at
+// most max_entries results, evicting the least recently used when full.
+// Black-Scholes is cheaper than a lookup and should be priced directly.
+// Safe to call from any thread; compute runs outside the lock, so two
+// threads missing on the same key both compute.
+class PricingCache {
+public:
+    using ComputeFn = std::function<PricedContract(const OptionParams&)>;
+
+    PricingCache(std::chrono::milliseconds ttl = std::chrono::milliseconds(250), size_t max_entries = 10000);
+
+    PricedContract getOrCompute(const OptionParams& params, const ComputeFn& compute);
+
+    struct Stats {
+        uint64_t hits;       // Served from a live entry
+        uint64_t misses;     // Computed
+        uint64_t evictions;  // Dropped to stay within max_entries
+    };
+    Stats getStats() const;
+    size_t size() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        PricedContract result;
+        Clock::time_point expires_at;
+        std::list<PricingKey>::iterator recency;  // Position in recency_
+    };
+
+    std::chrono::milliseconds ttl_;
+    size_t max_entries_;
+
+    mutable std::mutex mutex_;
+    std::list<PricingKey> recency_;  // Most recently used first
+    std::unordered_map<PricingKey, Entry, PricingKeyHash> entries_;
+    Stats stats_ = {0, 0, 0};
+};
+
+} // namespace options
+} // namespace hedgefund
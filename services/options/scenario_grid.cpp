@@ -0,0 +1,130 @@
+#include "scenario_grid.h"
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace hedgefund {
+namespace options {
+
+ScenarioGridSpec ScenarioGridSpec::uniform(int spot_points, double spot_range, int vol_points, double vol_range) {
+    auto shifts = [](int points, double range) {
+        points = std::min(std::max(1, points), MAX_POINTS);
+        std::vector<double> values(points, 0.0);
+        for (int i = 0; points > 1 && i < points; i++) {
+            values[i] = -range + 2.0 * range * i / (points - 1);
+        }
+        return values;
+    };
+
+    ScenarioGridSpec spec;
+    spec.spot_shifts = shifts(spot_points, spot_range);
+    spec.vol_shifts = shifts(vol_points, vol_range);
+    return spec;
+}
+
+PnLCube::PnLCube(size_t num_positions, size_t num_vols, size_t num_spots)
+    : num_positions_(num_positions), num_vols_(num_vols), num_spots_(num_spots),
+      data_(num_positions * num_vols * num_spots, 0.0) {}
+
+std::vector<double> PnLCube::total() const {
+    const size_t grid_size = num_vols_ * num_spots_;
+    std::vector<double> totals(grid_size, 0.0);
+    for (size_t p = 0; p < num_positions_; p++) {
+        const double* grid = position(p);
+        for (size_t i = 0; i < grid_size; i++) totals[i] += grid[i];
+    }
+    return totals;
+}
+
+ScenarioGridPricer::ScenarioGridPricer(double risk_free_rate, int num_threads)
+    : risk_free_rate_(risk_free_rate), num_threads_(num_threads) {}
+
+PnLCube ScenarioGridPricer::price(const std::vector<BookPosition>& book,
+                                  const std::unordered_map<std::string, double>& spots,
+                                  const ScenarioGridSpec& spec) const {
+    PnLCube cube(book.size(), spec.vol_shifts.size(), spec.spot_shifts.size());
+    if (book.empty() || spec.vol_shifts.empty() || spec.spot_shifts.empty()) return cube;
+
+    // Resolve term structures once per underlying rather than per position
+    std::unordered_map<std::string, std::shared_ptr<const TermStructure>> term_structures;
+    for (const auto& position : book) {
+        if (term_structures.count(position.underlying) == 0) {
+            term_structures[position.underlying] = TermStructureRegistry::instance().get(position.underlying);
+        }
+    }
+
+    size_t threads = num_threads_ > 0 ? num_threads_ : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, book.size());
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < book.size(); i = next.fetch_add(1)) {
+            const BookPosition& position = book[i];
+            auto spot = spots.find(position.underlying);
+            if (spot == spots.end() || spot->second <= 0.0) continue;
+            pricePosition(position, spot->second, term_structures.at(position.underlying).get(), spec,
+                          cube.position(i));
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t t = 1; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    return cube;
+}
+
+void ScenarioGridPricer::pricePosition(const BookPosition& position, double spot, const TermStructure* term_structure,
+                                       const ScenarioGridSpec& spec, double* grid) const {
+    OptionParams base;
+    base.spot_price = spot;
+    base.strike_price = position.strike_price;
+    base.time_to_expiry = position.time_to_expiry;
+    base.risk_free_rate = risk_free_rate_;
+    base.volatility = position.volatility;
+    base.is_call = position.is_call;
+    if (term_structure) base = term_structure->apply(base);
+    const double base_price = BlackScholes::calculatePrice(base);
+
+    // Scenario inputs at the rolled-forward expiry; cash dividends still to go
+    // ex after the horizon come off the shifted spot
+    OptionParams rolled = base;
+    rolled.time_to_expiry = std::max(0.0, position.time_to_expiry - spec.time_shift);
+    double dividend_pv = 0.0;
+    if (term_structure) {
+        ExpiryFactors factors = term_structure->factors(rolled.time_to_expiry, spec.time_shift);
+        rolled.risk_free_rate = factors.rate;
+        rolled.dividend_yield = factors.carry_yield;
+        dividend_pv = factors.dividend_pv;
+    }
+
+    const size_t num_spots = spec.spot_shifts.size();
+    const size_t num_vols = spec.vol_shifts.size();
+    thread_local std::vector<double> inputs;
+    inputs.resize(num_spots + num_vols);
+    double* scenario_spots = inputs.data();
+    double* scenario_vols = scenario_spots + num_spots;
+    for (size_t s = 0; s < num_spots; s++) {
+        scenario_spots[s] = std::max(1e-8, spot * (1.0 + spec.spot_shifts[s]) - dividend_pv);
+    }
+    for (size_t v = 0; v < num_vols; v++) {
+        scenario_vols[v] = std::max(1e-4, position.volatility + spec.vol_shifts[v]);
+    }
+
+    BlackScholes::calculatePriceGrid(rolled, scenario_spots, num_spots, scenario_vols, num_vols, grid);
+
+    const double scale = position.quantity * position.multiplier;
+    for (size_t i = 0; i < num_spots * num_vols; i++) {
+        grid[i] = scale * (grid[i] - base_price);
+    }
+}
+
+} // namespace options
+} // namespace hedgefund
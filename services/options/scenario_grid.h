@@ -0,0 +1,86 @@
+#pragma once
+
+#include "black_scholes.h"
+#include "term_structure.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace hedgefund {
+namespace options {
+
+struct BookPosition {
+    std::string underlying;
+    double strike_price;
+    double time_to_expiry;
+    double volatility;
+    bool is_call;
+    double quantity;            // Contracts, negative when short
+    double multiplier = 100.0;  // Shares per contract
+};
+
+struct ScenarioGridSpec {
+    std::vector<double> spot_shifts;  // Relative, e.g. -0.10 for spot down 10%
+    std::vector<double> vol_shifts;   // Absolute, e.g. 0.05 for vol up 5 points
+    double time_shift = 0.0;          // Years rolled forward in every scenario
+
+    // Most points either axis may have; the P&L cube grows with their product
+    static constexpr int MAX_POINTS = 201;
+
+    // Evenly spaced shifts over [-range, +range]; points clamp to [1, MAX_POINTS]
+    static ScenarioGridSpec uniform(int spot_points = 21, double spot_range = 0.10,
+                                    int vol_points = 11, double vol_range = 0.05);
+};
+
+// Dense P&L by position, vol shift and spot shift; spot varies fastest
+class PnLCube {
+public:
+    PnLCube(size_t num_positions = 0, size_t num_vols = 0, size_t num_spots = 0);
+
+    size_t numPositions() const { return num_positions_; }
+    size_t numVols() const { return num_vols_; }
+    size_t numSpots() const { return num_spots_; }
+
+    double& at(size_t position, size_t vol, size_t spot) {
+        return data_[(position * num_vols_ + vol) * num_spots_ + spot];
+    }
+    double at(size_t position, size_t vol, size_t spot) const {
+        return data_[(position * num_vols_ + vol) * num_spots_ + spot];
+    }
+
+    // One position's vol x spot grid
+    double* position(size_t index) { return data_.data() + index * num_vols_ * num_spots_; }
+    const double* position(size_t index) const { return data_.data() + index * num_vols_ * num_spots_; }
+
+    // Book P&L per scenario, summed over positions (vol x spot)
+    std::vector<double> total() const;
+
+private:
+    size_t num_positions_;
+    size_t num_vols_;
+    size_t num_spots_;
+    std::vector<double> data_;
+};
+
+// Reprices a whole options book across a spot x vol grid. Positions are
+// spread over worker threads; each position's grid is one vectorized
+// BlackScholes::calculatePriceGrid call. Positions whose underlying has no
+// spot get a zero grid.
+class ScenarioGridPricer {
+public:
+    explicit ScenarioGridPricer(double risk_free_rate = 0.05, int num_threads = 0);
+
+    // Term structures are looked up in TermStructureRegistry, falling back to the flat rate
+    PnLCube price(const std::vector<BookPosition>& book, const std::unordered_map<std::string, double>& spots,
+                  const ScenarioGridSpec& spec) const;
+
+private:
+    double risk_free_rate_;
+    int num_threads_;
+
+    void pricePosition(const BookPosition& position, double spot, const TermStructure* term_structure,
+                       const ScenarioGridSpec& spec, double* grid) const;
+};
+
+} // namespace options
+} // namespace hedgefund
@@ -0,0 +1,85 @@
+#include "taylor_repricer.h"
+#include <cmath>
+
+namespace hedgefund {
+namespace options {
+
+TaylorRepricer::TaylorRepricer(double max_error, double max_time_step, double max_carry_move)
+    : max_error_(max_error), max_time_step_(max_time_step), max_carry_move_(max_carry_move) {}
+
+TaylorAnchor TaylorRepricer::makeAnchor(const OptionParams& params) {
+    TaylorAnchor anchor;
+    anchor.params = params;
+    anchor.price = BlackScholes::calculatePrice(params);
+    
+    // Greeks come back per 1% vol/rate and per day; the expansion works in raw units
+    Greeks greeks = BlackScholes::calculateGreeks(params);
+    anchor.delta = greeks.delta;
+    anchor.gamma = greeks.gamma;
+    anchor.vega = greeks.vega * 100.0;
+    anchor.theta = greeks.theta * 365.0;
+    anchor.rho = greeks.rho * 100.0;
+    anchor.psi = -params.spot_price * params.time_to_expiry * greeks.delta;  // dV/dq = -S T delta
+    anchor.second_order = BlackScholes::calculateSecondOrderGreeks(params);
+    anchor.valid = true;
+    return anchor;
+}
+
+bool TaylorRepricer::reprice(const TaylorAnchor& anchor, const OptionParams& params, PricedContract& result) const {
+    const OptionParams& base = anchor.params;
+    if (!anchor.valid || base.time_to_expiry <= 0 || params.strike_price != base.strike_price ||
+        params.is_call != base.is_call) {
+        return false;
+    }
+    
+    double dr = params.risk_free_rate - base.risk_free_rate;
+    double dq = params.dividend_yield - base.dividend_yield;
+    if (std::fabs(dr) + std::fabs(dq) > max_carry_move_) return false;
+    
+    double dt = base.time_to_expiry - params.time_to_expiry;  // Calendar time elapsed
+    if (dt < 0.0 || dt > max_time_step_) return false;
+    
+    double ds = params.spot_price - base.spot_price;
+    double dv = params.volatility - base.volatility;
+    if (errorBound(anchor, ds, dv) > max_error_) return false;
+    
+    const SecondOrderGreeks& so = anchor.second_order;
+    result.price = anchor.price + anchor.delta * ds + 0.5 * anchor.gamma * ds * ds +
+                   anchor.vega * dv + 0.5 * so.volga * dv * dv + so.vanna * ds * dv +
+                   anchor.theta * dt + so.charm * ds * dt + so.veta * dv * dt +
+                   anchor.rho * dr + anchor.psi * dq;
+    
+    result.greeks.delta = anchor.delta + anchor.gamma * ds + so.vanna * dv + so.charm * dt;
+    result.greeks.gamma = anchor.gamma + so.speed * ds + so.zomma * dv;
+    result.greeks.vega = (anchor.vega + so.vanna * ds + so.volga * dv + so.veta * dt) / 100.0;
+    result.greeks.theta = anchor.theta / 365.0;
+    result.greeks.rho = anchor.rho / 100.0;
+    return true;
+}
+
+PricedContract TaylorRepricer::update(TaylorAnchor& anchor, const OptionParams& params) {
+    PricedContract result;
+    if (reprice(anchor, params, result)) {
+        taylor_updates_++;
+        return result;
+    }
+    
+    anchor = makeAnchor(params);
+    full_revaluations_++;
+    
+    result.price = anchor.price;
+    result.greeks = Greeks{anchor.delta, anchor.gamma, anchor.theta / 365.0, anchor.vega / 100.0, anchor.rho / 100.0};
+    return result;
+}
+
+double TaylorRepricer::errorBound(const TaylorAnchor& anchor, double spot_move, double vol_move) {
+    // Leading omitted terms: speed dS^3/6, zomma dS^2 dvol/2, ultima dvol^3/6
+    const SecondOrderGreeks& so = anchor.second_order;
+    double ds = std::fabs(spot_move);
+    double dv = std::fabs(vol_move);
+    return std::fabs(so.speed) * ds * ds * ds / 6.0 + std::fabs(so.zomma) * ds * ds * dv / 2.0 +
+           std::fabs(so.ultima) * dv * dv * dv / 6.0;
+}
+
+} // namespace options
+} // namespace hedgefund
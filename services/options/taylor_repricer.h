@@ -0,0 +1,58 @@
+#pragma once
+
+#include "black_scholes.h"
+#include <cstdint>
+
+namespace hedgefund {
+namespace options {
+
+// Full Black-Scholes result at one point, expanded around by TaylorRepricer
+struct TaylorAnchor {
+    OptionParams params;
+    double price;
+    double delta;
+    double gamma;
+    double vega;   // Per unit vol
+    double theta;  // Per year
+    double rho;    // Per unit rate
+    double psi;    // Per unit dividend yield (carry)
+    SecondOrderGreeks second_order;
+    bool valid = false;
+};
+
+// Reprices from the last full valuation with a second-order expansion in
+// spot, vol and time, with the spot-vol, spot-time and vol-time cross terms.
+// Rate and carry drift (e.g. rolling down a non-flat curve) enter at first
+// order through rho and psi. The third-order terms estimate the truncation
+// error; once that exceeds max_error, the anchor is older than max_time_step,
+// or rate plus carry have moved more than max_carry_move, the contract is
+// fully revalued and re-anchored.
+class TaylorRepricer {
+public:
+    TaylorRepricer(double max_error = 0.005, double max_time_step = 1.0 / 365.0, double max_carry_move = 0.0025);
+
+    // Full revaluation at params
+    static TaylorAnchor makeAnchor(const OptionParams& params);
+
+    // Expanded price/greeks at params; false (result untouched) when outside the bound
+    bool reprice(const TaylorAnchor& anchor, const OptionParams& params, PricedContract& result) const;
+
+    // reprice(), falling back to a full revaluation that replaces the anchor
+    PricedContract update(TaylorAnchor& anchor, const OptionParams& params);
+
+    // Estimated error of the expansion for a move from the anchor
+    static double errorBound(const TaylorAnchor& anchor, double spot_move, double vol_move);
+
+    uint64_t getTaylorUpdates() const { return taylor_updates_; }
+    uint64_t getFullRevaluations() const { return full_revaluations_; }
+
+private:
+    double max_error_;
+    double max_time_step_;
+    double max_carry_move_;
+    uint64_t taylor_updates_ = 0;
+    uint64_t full_revaluations_ = 0;
+};
+
+} // namespace options
+} // namespace hedgefund
@@ -0,0 +1,136 @@
+#include "term_structure.h"
+#include "volatility_surface.h"
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+namespace hedgefund {
+namespace options {
+
+YieldCurve::YieldCurve(double flat_rate) : times_{1.0}, integrated_{flat_rate} {}
+
+YieldCurve::YieldCurve(std::vector<double> times, std::vector<double> zero_rates) {
+    std::vector<size_t> order(std::min(times.size(), zero_rates.size()));
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return times[a] < times[b]; });
+
+    for (size_t i : order) {
+        if (times[i] <= 0.0 || (!times_.empty() && times[i] == times_.back())) continue;
+        times_.push_back(times[i]);
+        integrated_.push_back(zero_rates[i] * times[i]);
+    }
+    if (times_.empty()) {
+        times_.push_back(1.0);
+        integrated_.push_back(0.0);
+    }
+}
+
+double YieldCurve::integrated(double time) const {
+    if (time <= times_.front()) return integrated_.front() / times_.front() * time;
+    if (time >= times_.back()) return integrated_.back() / times_.back() * time;
+
+    size_t hi = std::upper_bound(times_.begin(), times_.end(), time) - times_.begin();
+    size_t lo = hi - 1;
+    double w = (time - times_[lo]) / (times_[hi] - times_[lo]);
+    return integrated_[lo] + w * (integrated_[hi] - integrated_[lo]);
+}
+
+double YieldCurve::zeroRate(double time) const {
+    if (time <= 0.0) return integrated_.front() / times_.front();
+    return integrated(time) / time;
+}
+
+double YieldCurve::discountFactor(double time) const {
+    return std::exp(-integrated(std::max(0.0, time)));
+}
+
+double YieldCurve::forwardRate(double start, double end) const {
+    if (end <= start) return zeroRate(start);
+    return (integrated(end) - integrated(start)) / (end - start);
+}
+
+namespace {
+
+const double SECONDS_PER_YEAR = 365.0 * 24.0 * 3600.0;
+
+} // namespace
+
+TermStructure::TermStructure(YieldCurve rates, double dividend_yield, std::vector<DatedDividend> dividends,
+                             YieldCurve borrow)
+    : rates_(std::move(rates)), dividend_yield_(dividend_yield),
+      dividends_(std::move(dividends)), borrow_(std::move(borrow)) {
+    std::sort(dividends_.begin(), dividends_.end(),
+              [](const DatedDividend& a, const DatedDividend& b) { return a.ex_date < b.ex_date; });
+    ex_times_.reserve(dividends_.size());
+    for (const auto& dividend : dividends_) ex_times_.push_back(expiryTime(dividend.ex_date));
+}
+
+ExpiryFactors TermStructure::factors(double time_to_expiry, double valuation_offset) const {
+    ExpiryFactors factors;
+    double t = std::max(0.0, time_to_expiry);
+
+    factors.discount_factor = rates_.discountFactor(t);
+    factors.rate = rates_.zeroRate(t);
+
+    // Borrow cost reduces the forward exactly like a continuous dividend
+    factors.carry_yield = dividend_yield_ + borrow_.zeroRate(t);
+    factors.carry_factor = std::exp(-factors.carry_yield * t);
+
+    // Ex-dates are absolute, so dividends age with the clock and drop out once paid
+    double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    factors.dividend_pv = 0.0;
+    for (size_t i = 0; i < dividends_.size(); i++) {
+        double time = (ex_times_[i] - now) / SECONDS_PER_YEAR - valuation_offset;
+        if (time > t) break;
+        if (time >= 0.0) factors.dividend_pv += dividends_[i].amount * rates_.discountFactor(time);
+    }
+    return factors;
+}
+
+std::vector<CashDividend> TermStructure::cashDividends(double time_to_expiry) const {
+    std::vector<CashDividend> pending;
+    double now = std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+    for (size_t i = 0; i < dividends_.size(); i++) {
+        double time = (ex_times_[i] - now) / SECONDS_PER_YEAR;
+        if (time > time_to_expiry) break;
+        if (time >= 0.0) pending.push_back({time, dividends_[i].amount});
+    }
+    return pending;
+}
+
+double TermStructure::forward(double spot_price, double time_to_expiry) const {
+    ExpiryFactors f = factors(time_to_expiry);
+    return (spot_price - f.dividend_pv) * f.carry_factor / f.discount_factor;
+}
+
+OptionParams TermStructure::apply(const OptionParams& params) const {
+    return apply(params, factors(params.time_to_expiry));
+}
+
+OptionParams TermStructure::apply(const OptionParams& params, const ExpiryFactors& f) {
+    OptionParams adjusted = params;
+    adjusted.spot_price = std::max(1e-8, params.spot_price - f.dividend_pv);
+    adjusted.risk_free_rate = f.rate;
+    adjusted.dividend_yield = f.carry_yield;
+    return adjusted;
+}
+
+TermStructureRegistry& TermStructureRegistry::instance() {
+    static TermStructureRegistry registry;
+    return registry;
+}
+
+void TermStructureRegistry::publish(const std::string& underlying_symbol,
+                                    std::shared_ptr<const TermStructure> term_structure) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    term_structures_[underlying_symbol] = std::move(term_structure);
+}
+
+std::shared_ptr<const TermStructure> TermStructureRegistry::get(const std::string& underlying_symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = term_structures_.find(underlying_symbol);
+    return it != term_structures_.end() ? it->second : nullptr;
+}
+
+} // namespace options
+} // namespace hedgefund
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "black_scholes.h"
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace hedgefund {
+namespace options {
+
+struct CashDividend {
+    double time;    // Years from now
+    double amount;  // Cash amount per share
+};
+
+// Announced dividend; TermStructure measures it from the clock on every query
+struct DatedDividend {
+    int32_t ex_date;  // YYYYMMDD, paid as of that day's close
+    double amount;    // Cash amount per share
+};
+
+// Continuously compounded zero curve. Interpolation is linear in r(t) * t,
+// i.e. piecewise-flat forwards; rates are extrapolated flat on both ends.
+class YieldCurve {
+public:
+    explicit YieldCurve(double flat_rate = 0.0);
+    YieldCurve(std::vector<double> times, std::vector<double> zero_rates);
+
+    double zeroRate(double time) const;
+    double discountFactor(double time) const;
+    double forwardRate(double start, double end) const;
+
+private:
+    std::vector<double> times_;
+    std::vector<double> integrated_;  // r(t) * t at each pillar
+    double integrated(double time) const;
+};
+
+// Rates, dividends and stock borrow for one underlying. Immutable once
+// built, so one instance is shared by every pricer on that underlying.
+class TermStructure {
+public:
+    explicit TermStructure(YieldCurve rates = YieldCurve(0.05), double dividend_yield = 0.0,
+                           std::vector<DatedDividend> dividends = {}, YieldCurve borrow = YieldCurve(0.0));
+
+    // Discounting and carry to one expiry, valued valuation_offset years from
+    // now; dividends going ex before the valuation date count as paid
+    ExpiryFactors factors(double time_to_expiry, double valuation_offset = 0.0) const;
+
+    // Dividends going ex before time_to_expiry, in years from now, for
+    // pricers that escrow them themselves (the lattice)
+    std::vector<CashDividend> cashDividends(double time_to_expiry) const;
+
+    // Forward price of the underlying for delivery at time_to_expiry
+    double forward(double spot_price, double time_to_expiry) const;
+
+    // Scalar pricer inputs for params' expiry: zero rate, carry as a dividend
+    // yield, and spot net of dividends paid before expiry
+    OptionParams apply(const OptionParams& params) const;
+
+    // The same from factors already computed for params' expiry
+    static OptionParams apply(const OptionParams& params, const ExpiryFactors& factors);
+
+    const YieldCurve& rates() const { return rates_; }
+    const YieldCurve& borrow() const { return borrow_; }
+    double dividendYield() const { return dividend_yield_; }
+    const std::vector<DatedDividend>& dividends() const { return dividends_; }
+
+private:
+    YieldCurve rates_;
+    double dividend_yield_;
+    std::vector<DatedDividend> dividends_;  // Sorted by ex-date
+    std::vector<double> ex_times_;          // Epoch seconds of each ex-date
+    YieldCurve borrow_;
+};
+
+// Process-wide term structures by underlying; pricers fall back to a flat
+// rate when none has been published
+class TermStructureRegistry {
+public:
+    static TermStructureRegistry& instance();
+
+    void publish(const std::string& underlying_symbol, std::shared_ptr<const TermStructure> term_structure);
+    std::shared_ptr<const TermStructure> get(const std::string& underlying_symbol) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const TermStructure>> term_structures_;
+};
+
+} // namespace options
+} // namespace hedgefund
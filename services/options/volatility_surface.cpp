@@ -0,0 +1,424 @@
+#include "volatility_surface.h"
+#include "black_scholes.h"
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace hedgefund {
+namespace options {
+
+namespace {
+
+struct SmilePoint {
+    double log_moneyness;
+    double total_variance;
+};
+
+const double MIN_TOTAL_VARIANCE = 1e-8;
+const double SECONDS_PER_YEAR = 365.0 * 24.0 * 3600.0;
+
+double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Solve a 3x3 system by Cramer's rule; false if singular
+bool solve3x3(const double a[3][3], const double b[3], double x[3]) {
+    auto det = [](const double m[3][3]) {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+             - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+             + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    };
+
+    double d = det(a);
+    if (std::abs(d) < 1e-14) return false;
+
+    for (int col = 0; col < 3; col++) {
+        double m[3][3];
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) m[r][c] = (c == col) ? b[r] : a[r][c];
+        }
+        x[col] = det(m) / d;
+    }
+    return true;
+}
+
+// Quasi-explicit SVI: for fixed (m, sigma) the slice is linear in
+// (a, d, c) with w = a + d*y + c*sqrt(y^2 + 1), y = (k - m) / sigma.
+// Returns the squared error, or a large value for an invalid fit.
+double fitLinearSVI(const std::vector<SmilePoint>& points, double m, double sigma, SVIParams& out) {
+    double ata[3][3] = {};
+    double atb[3] = {};
+    for (const auto& p : points) {
+        double y = (p.log_moneyness - m) / sigma;
+        double basis[3] = {1.0, y, std::sqrt(y * y + 1.0)};
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) ata[i][j] += basis[i] * basis[j];
+            atb[i] += basis[i] * p.total_variance;
+        }
+    }
+
+    double x[3];
+    if (!solve3x3(ata, atb, x)) return 1e300;
+
+    double a = x[0], d = x[1], c = x[2];
+    if (c < 0.0 || std::abs(d) > c) {
+        // b >= 0 and |rho| <= 1 are violated, so the constrained optimum lies on
+        // rho = +1 or rho = -1: fit w = a + c * (+-y + sqrt(y^2 + 1)) on each, c >= 0
+        double best_sse = 1e300;
+        for (double side : {1.0, -1.0}) {
+            double n = 0.0, sz = 0.0, szz = 0.0, sw = 0.0, szw = 0.0;
+            for (const auto& p : points) {
+                double y = (p.log_moneyness - m) / sigma;
+                double z = side * y + std::sqrt(y * y + 1.0);
+                n += 1.0; sz += z; szz += z * z; sw += p.total_variance; szw += z * p.total_variance;
+            }
+            double denom = n * szz - sz * sz;
+            double side_c = denom > 1e-14 ? std::max(0.0, (n * szw - sz * sw) / denom) : 0.0;
+            double side_a = (sw - side_c * sz) / n;
+
+            double sse = 0.0;
+            for (const auto& p : points) {
+                double y = (p.log_moneyness - m) / sigma;
+                double err = side_a + side_c * (side * y + std::sqrt(y * y + 1.0)) - p.total_variance;
+                sse += err * err;
+            }
+            if (sse < best_sse) {
+                best_sse = sse;
+                a = side_a;
+                c = side_c;
+                d = side * side_c;
+            }
+        }
+    }
+
+    out.a = a;
+    out.b = c / sigma;
+    out.rho = c > 0.0 ? d / c : 0.0;
+    out.m = m;
+    out.sigma = sigma;
+
+    // Reject slices with negative variance at their minimum
+    double min_variance = out.a + out.b * out.sigma * std::sqrt(1.0 - out.rho * out.rho);
+    if (min_variance < 0.0) return 1e300;
+
+    double sse = 0.0;
+    for (const auto& p : points) {
+        double err = out.totalVariance(p.log_moneyness) - p.total_variance;
+        sse += err * err;
+    }
+    return sse;
+}
+
+} // namespace
+
+double expiryTime(int32_t expiry_date) {
+    int year = expiry_date / 10000, month = (expiry_date / 100) % 100, day = expiry_date % 100;
+    if (year < 1970 || month < 1 || month > 12 || day < 1 || day > 31) return 0.0;
+
+    std::tm tm = {};
+    tm.tm_year = year - 1900;
+    tm.tm_mon = month - 1;
+    tm.tm_mday = day;
+    tm.tm_hour = 16;
+    tm.tm_isdst = -1;
+    return static_cast<double>(std::mktime(&tm));
+}
+
+double yearsToExpiry(int32_t expiry_date) {
+    double expiry = expiryTime(expiry_date);
+    return expiry > 0.0 ? (expiry - nowSeconds()) / SECONDS_PER_YEAR : 0.0;
+}
+
+double yearsToExpiry(const std::string& expiration_date) {
+    std::tm tm = {};
+    std::istringstream ss(expiration_date);
+    ss >> std::get_time(&tm, "%Y-%m-%d");
+    if (ss.fail()) return 0.0;
+    return yearsToExpiry((tm.tm_year + 1900) * 10000 + (tm.tm_mon + 1) * 100 + tm.tm_mday);
+}
+
+int32_t expiryDateAfter(double years) {
+    std::time_t when = static_cast<std::time_t>(nowSeconds() + years * SECONDS_PER_YEAR);
+    std::tm tm = {};
+    localtime_r(&when, &tm);
+    return (tm.tm_year + 1900) * 10000 + (tm.tm_mon + 1) * 100 + tm.tm_mday;
+}
+
+double SVIParams::totalVariance(double log_moneyness) const {
+    double x = log_moneyness - m;
+    return a + b * (rho * x + std::sqrt(x * x + sigma * sigma));
+}
+
+VolatilitySurfaceSnapshot::VolatilitySurfaceSnapshot(uint64_t version, double risk_free_rate,
+                                                     std::vector<double> expiry_times,
+                                                     std::vector<double> implied_variance)
+    : version_(version), risk_free_rate_(risk_free_rate),
+      expiry_times_(std::move(expiry_times)), implied_variance_(std::move(implied_variance)) {}
+
+double VolatilitySurfaceSnapshot::getVolatility(double strike_price, double time_to_expiry, double spot_price) const {
+    if (expiry_times_.empty() || strike_price <= 0.0 || spot_price <= 0.0) return 0.0;
+
+    double t = std::max(time_to_expiry, 1.0 / 365.0);
+    double forward = spot_price * std::exp(risk_free_rate_ * t);
+    double w = getTotalVariance(std::log(strike_price / forward), t);
+    return std::sqrt(w / t);
+}
+
+double VolatilitySurfaceSnapshot::getATMVolatility(double time_to_expiry) const {
+    if (expiry_times_.empty()) return 0.0;
+    double t = std::max(time_to_expiry, 1.0 / 365.0);
+    return std::sqrt(getTotalVariance(0.0, t) / t);
+}
+
+double VolatilitySurfaceSnapshot::getTotalVariance(double log_moneyness, double time_to_expiry) const {
+    const double now = nowSeconds();
+    auto first = std::upper_bound(expiry_times_.begin(), expiry_times_.end(), now);
+    if (first == expiry_times_.end()) return 0.0;  // Every slice has expired
+
+    const double target = now + time_to_expiry * SECONDS_PER_YEAR;
+    size_t live = first - expiry_times_.begin();
+    size_t above = std::upper_bound(first, expiry_times_.end(), target) - expiry_times_.begin();
+
+    // Constant implied vol beyond the first and last live expiries
+    if (above == live) return sliceVariance(live, log_moneyness) * time_to_expiry;
+    if (above == expiry_times_.size()) return sliceVariance(above - 1, log_moneyness) * time_to_expiry;
+
+    // Linear in total variance between the neighbouring slices, each at its current time to expiry
+    size_t below = above - 1;
+    double w_below = sliceVariance(below, log_moneyness) * (expiry_times_[below] - now) / SECONDS_PER_YEAR;
+    double w_above = sliceVariance(above, log_moneyness) * (expiry_times_[above] - now) / SECONDS_PER_YEAR;
+    double frac = (target - expiry_times_[below]) / (expiry_times_[above] - expiry_times_[below]);
+    return w_below + frac * (w_above - w_below);
+}
+
+double VolatilitySurfaceSnapshot::sliceVariance(size_t slice, double log_moneyness) const {
+    const double inv_dk = (GRID_POINTS - 1) / (GRID_MAX_K - GRID_MIN_K);
+    const double* row = implied_variance_.data() + slice * GRID_POINTS;
+
+    double pos = (std::max(GRID_MIN_K, std::min(GRID_MAX_K, log_moneyness)) - GRID_MIN_K) * inv_dk;
+    int i = std::min(static_cast<int>(pos), GRID_POINTS - 2);
+    double frac = pos - i;
+    return row[i] + frac * (row[i + 1] - row[i]);
+}
+
+void SharedVolatilitySurface::publish(std::shared_ptr<const VolatilitySurfaceSnapshot> snapshot) {
+    // Pointer first, then the sequence: a reader that sees the new sequence
+    // is guaranteed to load this snapshot or a later one
+    std::atomic_store_explicit(&current_, std::move(snapshot), std::memory_order_release);
+    sequence_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::shared_ptr<const VolatilitySurfaceSnapshot> SharedVolatilitySurface::load() const {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+}
+
+VolatilitySurfaceReader::VolatilitySurfaceReader(std::shared_ptr<const SharedVolatilitySurface> source)
+    : source_(std::move(source)) {}
+
+const VolatilitySurfaceSnapshot* VolatilitySurfaceReader::get() {
+    if (!source_) return nullptr;
+
+    uint64_t sequence = source_->sequence();
+    if (sequence != cached_sequence_) {
+        cached_ = source_->load();
+        cached_sequence_ = sequence;
+    }
+    return cached_.get();
+}
+
+VolatilitySurfaceRegistry& VolatilitySurfaceRegistry::instance() {
+    static VolatilitySurfaceRegistry registry;
+    return registry;
+}
+
+std::shared_ptr<SharedVolatilitySurface> VolatilitySurfaceRegistry::get(const std::string& underlying_symbol) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& surface = surfaces_[underlying_symbol];
+    if (!surface) surface = std::make_shared<SharedVolatilitySurface>();
+    return surface;
+}
+
+VolatilitySurface::VolatilitySurface(const std::string& underlying_symbol, double risk_free_rate)
+    : underlying_symbol_(underlying_symbol), risk_free_rate_(risk_free_rate),
+      snapshot_(std::make_shared<VolatilitySurfaceSnapshot>(0, risk_free_rate, std::vector<double>(),
+                                                            std::vector<double>())),
+      version_(0) {}
+
+bool VolatilitySurface::addQuote(const VolQuote& quote) {
+    double expiry_time = expiryTime(quote.expiry_date);
+    if (expiry_time <= nowSeconds() || quote.strike_price <= 0.0 || quote.underlying_price <= 0.0) {
+        return false;
+    }
+
+    Slice& slice = sliceFor(quote.expiry_date, expiry_time);
+    auto key = std::make_pair(quote.strike_price, quote.is_call);
+    auto it = slice.quotes.find(key);
+
+    if (it != slice.quotes.end() &&
+        it->second.price == quote.price &&
+        it->second.implied_vol == quote.implied_vol &&
+        it->second.underlying_price == quote.underlying_price) {
+        return false;
+    }
+
+    slice.quotes[key] = quote;
+    slice.dirty = true;
+    return true;
+}
+
+int VolatilitySurface::refit() {
+    const double now = nowSeconds();
+    size_t before = slices_.size();
+    slices_.erase(std::remove_if(slices_.begin(), slices_.end(),
+                                 [now](const Slice& s) { return s.expiry_time <= now; }),
+                  slices_.end());
+
+    int refitted = 0;
+    for (auto& slice : slices_) {
+        if (!slice.dirty) continue;
+        fitSlice(slice, now);
+        slice.dirty = false;
+        refitted++;
+    }
+
+    if (refitted > 0 || slices_.size() != before) rebuildSnapshot();
+    return refitted;
+}
+
+size_t VolatilitySurface::numDirtySlices() const {
+    return std::count_if(slices_.begin(), slices_.end(), [](const Slice& s) { return s.dirty; });
+}
+
+double VolatilitySurface::getVolatility(double strike_price, double time_to_expiry, double spot_price) const {
+    return snapshot_->getVolatility(strike_price, time_to_expiry, spot_price);
+}
+
+double VolatilitySurface::getATMVolatility(double time_to_expiry) const {
+    return snapshot_->getATMVolatility(time_to_expiry);
+}
+
+double VolatilitySurface::getTotalVariance(double log_moneyness, double time_to_expiry) const {
+    return snapshot_->getTotalVariance(log_moneyness, time_to_expiry);
+}
+
+void VolatilitySurface::rebuildSnapshot() {
+    std::vector<double> expiry_times;
+    std::vector<double> implied_variance;
+    for (const auto& slice : slices_) {
+        if (!slice.fitted) continue;
+        expiry_times.push_back(slice.expiry_time);
+        implied_variance.insert(implied_variance.end(), slice.implied_variance.begin(), slice.implied_variance.end());
+    }
+
+    snapshot_ = std::make_shared<VolatilitySurfaceSnapshot>(++version_, risk_free_rate_,
+                                                            std::move(expiry_times), std::move(implied_variance));
+}
+
+VolatilitySurface::Slice& VolatilitySurface::sliceFor(int32_t expiry_date, double expiry_time) {
+    auto it = std::lower_bound(slices_.begin(), slices_.end(), expiry_date,
+        [](const Slice& s, int32_t date) { return s.expiry_date < date; });
+    if (it != slices_.end() && it->expiry_date == expiry_date) return *it;
+
+    Slice slice;
+    slice.expiry_date = expiry_date;
+    slice.expiry_time = expiry_time;
+    return *slices_.insert(it, slice);
+}
+
+void VolatilitySurface::fitSlice(Slice& slice, double now) {
+    const double t = std::max((slice.expiry_time - now) / SECONDS_PER_YEAR, 1.0 / (365.0 * 24.0));
+    std::vector<SmilePoint> points;
+    points.reserve(slice.quotes.size());
+
+    for (const auto& [key, quote] : slice.quotes) {
+        double forward = quote.underlying_price * std::exp(risk_free_rate_ * t);
+        bool out_of_the_money = quote.is_call ? quote.strike_price >= forward : quote.strike_price <= forward;
+
+        // Use the out-of-the-money side where both are quoted
+        if (!out_of_the_money && slice.quotes.count(std::make_pair(key.first, !key.second))) continue;
+
+        double iv = quote.implied_vol;
+        if (iv <= 0.0) {
+            OptionParams params;
+            params.spot_price = quote.underlying_price;
+            params.strike_price = quote.strike_price;
+            params.time_to_expiry = t;
+            params.risk_free_rate = risk_free_rate_;
+            params.volatility = 0.0;
+            params.is_call = quote.is_call;
+            iv = BlackScholes::impliedVolatility(quote.price, params);
+        }
+
+        // Discard solver failures pinned at the bracket edges
+        if (iv <= 0.011 || iv >= 4.99) continue;
+        points.push_back({std::log(quote.strike_price / forward), iv * iv * t});
+    }
+
+    slice.fitted = !points.empty();
+    if (!slice.fitted) return;
+
+    if (points.size() < 3) {
+        // Too few strikes for a smile: flat slice at the mean variance
+        double mean = 0.0;
+        for (const auto& p : points) mean += p.total_variance;
+        slice.svi = SVIParams{mean / points.size(), 0.0, 0.0, 0.0, 0.1};
+    } else {
+        auto [min_it, max_it] = std::minmax_element(points.begin(), points.end(),
+            [](const SmilePoint& a, const SmilePoint& b) { return a.log_moneyness < b.log_moneyness; });
+        double k_min = min_it->log_moneyness;
+        double k_max = max_it->log_moneyness;
+
+        // Coarse grid over (m, sigma), then pattern search around the best point
+        SVIParams best{};
+        double best_sse = 1e300;
+        const double sigmas[] = {0.02, 0.05, 0.1, 0.2, 0.4, 0.8};
+        for (int i = 0; i <= 8; i++) {
+            double m = k_min + (k_max - k_min) * i / 8.0;
+            for (double sigma : sigmas) {
+                SVIParams candidate;
+                double sse = fitLinearSVI(points, m, sigma, candidate);
+                if (sse < best_sse) { best_sse = sse; best = candidate; }
+            }
+        }
+
+        double step_m = std::max(0.01, (k_max - k_min) / 8.0);
+        double step_sigma = 2.0;
+        for (int iter = 0; iter < 40 && (step_m > 1e-4 || step_sigma > 1.001); iter++) {
+            bool improved = false;
+            const double trial_m[] = {best.m - step_m, best.m + step_m, best.m, best.m};
+            const double trial_sigma[] = {best.sigma, best.sigma, best.sigma * step_sigma, best.sigma / step_sigma};
+            for (int j = 0; j < 4; j++) {
+                if (trial_sigma[j] < 1e-3) continue;
+                SVIParams candidate;
+                double sse = fitLinearSVI(points, trial_m[j], trial_sigma[j], candidate);
+                if (sse < best_sse) { best_sse = sse; best = candidate; improved = true; }
+            }
+            if (!improved) {
+                step_m *= 0.5;
+                step_sigma = std::sqrt(step_sigma);
+            }
+        }
+
+        if (best_sse >= 1e300) {
+            double mean = 0.0;
+            for (const auto& p : points) mean += p.total_variance;
+            best = SVIParams{mean / points.size(), 0.0, 0.0, 0.0, 0.1};
+        }
+        slice.svi = best;
+    }
+
+    // Sample the fitted slice onto the shared grid
+    using Grid = VolatilitySurfaceSnapshot;
+    slice.implied_variance.resize(Grid::GRID_POINTS);
+    const double dk = (Grid::GRID_MAX_K - Grid::GRID_MIN_K) / (Grid::GRID_POINTS - 1);
+    for (int i = 0; i < Grid::GRID_POINTS; i++) {
+        double w = std::max(MIN_TOTAL_VARIANCE, slice.svi.totalVariance(Grid::GRID_MIN_K + i * dk));
+        slice.implied_variance[i] = w / t;
+    }
+}
+
+} // namespace options
+} // namespace hedgefund
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+
+namespace hedgefund {
+namespace options {
+
+struct VolQuote {
+    double strike_price;
+    int32_t expiry_date;      // YYYYMMDD
+    double underlying_price;  // Spot when the quote was observed
+    double price;             // Option premium, used when implied_vol is not supplied
+    double implied_vol;       // Quoted IV, or 0 to solve it from price
+    bool is_call;
+};
+
+// Expiry dates are YYYYMMDD calendar dates expiring at the 16:00 local close.
+// Seconds since epoch at expiry; 0 if the date is invalid
+double expiryTime(int32_t expiry_date);
+
+// Year fraction from now until an expiry date, negative once it has passed;
+// 0 if the date cannot be parsed
+double yearsToExpiry(int32_t expiry_date);
+double yearsToExpiry(const std::string& expiration_date);  // YYYY-MM-DD
+
+// Calendar date the given number of years from now
+int32_t expiryDateAfter(double years);
+
+// Raw SVI total variance: w(k) = a + b * (rho * (k - m) + sqrt((k - m)^2 + sigma^2))
+struct SVIParams {
+    double a;
+    double b;
+    double rho;
+    double m;
+    double sigma;
+
+    double totalVariance(double log_moneyness) const;
+};
+
+// Immutable, fitted surface: one row of implied variance per expiry on a
+// fixed log-forward-moneyness grid. Expiries are absolute times, so time to
+// expiry is measured when the surface is queried and expired rows are
+// skipped. Safe to share between threads.
+class VolatilitySurfaceSnapshot {
+public:
+    static constexpr double GRID_MIN_K = -2.0;
+    static constexpr double GRID_MAX_K = 2.0;
+    static constexpr int GRID_POINTS = 161;
+
+    VolatilitySurfaceSnapshot(uint64_t version, double risk_free_rate,
+                              std::vector<double> expiry_times, std::vector<double> implied_variance);
+
+    // Volatility at (strike, expiry) given spot; 0 if the surface is empty
+    double getVolatility(double strike_price, double time_to_expiry, double spot_price) const;
+    double getTotalVariance(double log_moneyness, double time_to_expiry) const;
+    double getATMVolatility(double time_to_expiry) const;
+
+    uint64_t version() const { return version_; }
+    bool empty() const { return expiry_times_.empty(); }
+
+private:
+    uint64_t version_;
+    double risk_free_rate_;
+    std::vector<double> expiry_times_;      // Seconds since epoch, ascending
+    std::vector<double> implied_variance_;  // expiry_times_.size() rows of GRID_POINTS
+
+    double sliceVariance(size_t slice, double log_moneyness) const;
+};
+
+// Publication point for one underlying's surface. The refitting thread
+// swaps in a new snapshot; readers never see a partially built surface.
+class SharedVolatilitySurface {
+public:
+    void publish(std::shared_ptr<const VolatilitySurfaceSnapshot> snapshot);
+    std::shared_ptr<const VolatilitySurfaceSnapshot> load() const;
+
+    // Number of publishes so far; readers compare it to skip reloading
+    uint64_t sequence() const { return sequence_.load(std::memory_order_acquire); }
+
+private:
+    std::shared_ptr<const VolatilitySurfaceSnapshot> current_;  // Only via std::atomic_load/atomic_store
+    std::atomic<uint64_t> sequence_{0};
+};
+
+// Thread-confined reader holding its own reference to the latest snapshot.
+// get() is one atomic load while the sequence is unchanged; the reference is
+// only re-acquired after a publish, and the old snapshot stays alive until
+// every reader has moved on.
+class VolatilitySurfaceReader {
+public:
+    VolatilitySurfaceReader() = default;
+    explicit VolatilitySurfaceReader(std::shared_ptr<const SharedVolatilitySurface> source);
+
+    // Latest snapshot, or nullptr if nothing has been published yet
+    const VolatilitySurfaceSnapshot* get();
+
+private:
+    std::shared_ptr<const SharedVolatilitySurface> source_;
+    std::shared_ptr<const VolatilitySurfaceSnapshot> cached_;
+    uint64_t cached_sequence_ = 0;
+};
+
+// Process-wide shared surfaces by underlying
+class VolatilitySurfaceRegistry {
+public:
+    static VolatilitySurfaceRegistry& instance();
+
+    std::shared_ptr<SharedVolatilitySurface> get(const std::string& underlying_symbol);
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<SharedVolatilitySurface>> surfaces_;
+};
+
+// Implied volatility surface for one underlying. Quotes are grouped into
+// slices by expiry date, each fitted to SVI in log-forward-moneyness and
+// sampled onto a fixed grid; queries interpolate total variance between
+// neighbouring slices. Only slices whose quotes changed are refitted, and
+// slices are dropped once they expire. Not thread-safe: share the fitted
+// result through snapshot() and SharedVolatilitySurface.
+class VolatilitySurface {
+public:
+    VolatilitySurface(const std::string& underlying_symbol = "", double risk_free_rate = 0.05);
+
+    // Returns true if the quote changed its slice (and marked it for refit)
+    bool addQuote(const VolQuote& quote);
+
+    // Drop expired slices, refit dirty ones at the current time to expiry and
+    // rebuild the snapshot; returns the number of slices refitted
+    int refit();
+
+    // Surface as of the last refit
+    std::shared_ptr<const VolatilitySurfaceSnapshot> snapshot() const { return snapshot_; }
+
+    double getVolatility(double strike_price, double time_to_expiry, double spot_price) const;
+    double getTotalVariance(double log_moneyness, double time_to_expiry) const;
+    double getATMVolatility(double time_to_expiry) const;
+
+    const std::string& getUnderlying() const { return underlying_symbol_; }
+    bool empty() const { return snapshot_->empty(); }
+    size_t numSlices() const { return slices_.size(); }
+    size_t numDirtySlices() const;
+
+private:
+    struct Slice {
+        int32_t expiry_date = 0;
+        double expiry_time = 0.0;  // Seconds since epoch
+        std::map<std::pair<double, bool>, VolQuote> quotes;  // (strike, is_call) -> latest quote
+        SVIParams svi = {};
+        std::vector<double> implied_variance;  // GRID_POINTS samples of the fitted slice, w / T
+        bool fitted = false;
+        bool dirty = false;
+    };
+
+    std::string underlying_symbol_;
+    double risk_free_rate_;
+    std::vector<Slice> slices_;  // Sorted by expiry_date
+    std::shared_ptr<const VolatilitySurfaceSnapshot> snapshot_;
+    uint64_t version_;
+
+    Slice& sliceFor(int32_t expiry_date, double expiry_time);
+    void fitSlice(Slice& slice, double now);
+    void rebuildSnapshot();
+};
+
+} // namespace options
+} // namespace hedgefund
@@ -1,6 +1,7 @@
 #include "orderbook.h"
 #include "common/database.h"
 #include "common/messaging.h"
+#include "common/order_messages.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -33,6 +34,11 @@ public:
             handleNewOrder(msg);
         });
         
+        // Batched orders from the algorithmic engine, acknowledged in one message
+        mq_.subscribe("orders.batch", [this](const Message& msg) {
+            handleOrderBatch(msg);
+        });
+        
         mq_.subscribe("orders.cancel", [this](const Message& msg) {
             handleCancelOrder(msg);
         });
@@ -85,6 +91,36 @@ private:
         orderbook_.addOrder(order);
     }
     
+    void handleOrderBatch(const Message& msg) {
+        // Malformed records are skipped and rejected by id; the rest of the batch stands
+        std::vector<OrderMessage> orders;
+        std::vector<std::string> malformed_ids;
+        if (!decodeOrderBatch(msg.payload, orders, &malformed_ids)) {
+            std::cerr << "Malformed order batch: " << msg.payload.substr(0, 100) << std::endl;
+        }
+        if (orders.empty() && malformed_ids.empty()) return;
+        
+        std::vector<OrderAck> acks;
+        acks.reserve(orders.size() + malformed_ids.size());
+        for (const auto& order_id : malformed_ids) {
+            acks.push_back(OrderAck{order_id, false});
+        }
+        for (const auto& order : orders) {
+            // This book only trades AAPL; anything else is rejected
+            bool accepted = order.symbol == "AAPL" && order.price > 0.0 && order.quantity > 0.0;
+            if (accepted) {
+                orderbook_.addOrder(std::make_shared<Order>(
+                    order.order_id, order.symbol, OrderType::LIMIT,
+                    order.buy ? OrderSide::BUY : OrderSide::SELL,
+                    order.price, order.quantity, "ALGO"
+                ));
+            }
+            acks.push_back(OrderAck{order.order_id, accepted});
+        }
+        
+        mq_.publish("orders.ack", encodeOrderAcks(acks));
+    }
+    
     void handleCancelOrder(const Message& msg) {
         std::cout << "Received cancel order: " << msg.payload << std::endl;
         orderbook_.cancelOrder(msg.payload);
@@ -95,11 +131,8 @@ private:
         db_.insertTrade("AAPL", trade.price, trade.quantity, "MATCHED");
         
         // Publish trade event
-        std::ostringstream trade_msg;
-        trade_msg << "TRADE," << trade.price << "," << trade.quantity 
-                  << "," << trade.buy_order_id << "," << trade.sell_order_id;
-        
-        mq_.publish("trades.executed", trade_msg.str());
+        mq_.publish("trades.executed", encodeTrade(TradeMessage{trade.price, trade.quantity,
+                                                                trade.buy_order_id, trade.sell_order_id}));
         
         std::cout << "Processed trade: " << trade.quantity << "@" << trade.price << std::endl;
     }
@@ -138,6 +138,7 @@ private:
             // Stock position
             Position stock_pos;
             stock_pos.symbol = symbol;
+            stock_pos.symbol_id = SymbolRegistry::instance().intern(stock_pos.symbol);
             stock_pos.quantity = 100 + (gen() % 500);
             stock_pos.market_value = value_dist(gen);
             stock_pos.unrealized_pnl = (gen() % 10000) - 5000;
@@ -147,6 +148,7 @@ private:
             // Options position
             Position option_pos;
             option_pos.symbol = symbol + "_CALL_150";
+            option_pos.symbol_id = SymbolRegistry::instance().intern(option_pos.symbol);
             option_pos.quantity = 10 + (gen() % 20);
             option_pos.market_value = value_dist(gen) * 0.1; // Smaller options positions
             option_pos.unrealized_pnl = (gen() % 5000) - 2500;
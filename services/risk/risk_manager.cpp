@@ -1,9 +1,12 @@
 #include "risk_manager.h"
+#include "common/fast_math.h"
 #include <iostream>
 #include <algorithm>
 #include <numeric>
 #include <cmath>
 #include <random>
+#include <limits>
+#include <unordered_map>
 
 namespace hedgefund {
 namespace risk {
@@ -127,7 +130,7 @@ double RiskManager::calculateParametricVaR(const std::vector<Position>& position
     double daily_volatility = portfolio_volatility / std::sqrt(252); // Convert to daily
     
     // Z-score for confidence level
-    double z_score = confidence == 0.95 ? 1.645 : (confidence == 0.99 ? 2.326 : 1.645);
+    double z_score = common::math::inverseNormCdf(confidence);
     
     double var = z_score * daily_volatility * portfolio_value;
     return var / portfolio_value; // Return as percentage
@@ -136,31 +139,58 @@ double RiskManager::calculateParametricVaR(const std::vector<Position>& position
 double RiskManager::calculateMonteCarloVaR(const std::vector<Position>& positions, int simulations, double confidence) {
     if (positions.empty()) return 0.0;
     
-    std::vector<double> simulated_pnl;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<> normal_dist(0.0, 1.0);
-    
     double portfolio_value = 0.0;
     for (const auto& pos : positions) {
         portfolio_value += pos.market_value;
     }
+    if (portfolio_value == 0.0) return 0.0;
+    
+    // Positions in the same symbol are one asset: summing their weights keeps
+    // the correlation matrix positive definite (duplicate rows at rho = 1
+    // would make it singular)
+    std::vector<const Position*> representatives;
+    std::vector<double> weights;
+    std::unordered_map<std::string, size_t> asset_index;
+    for (const auto& pos : positions) {
+        auto inserted = asset_index.emplace(pos.symbol, representatives.size());
+        if (inserted.second) {
+            representatives.push_back(&pos);
+            weights.push_back(0.0);
+        }
+        weights[inserted.first->second] += pos.market_value / portfolio_value;
+    }
+    
+    // Joint one-day returns: vols from history where we have it, pairwise
+    // correlations from the estimated matrix, 0.3 otherwise
+    const size_t n = representatives.size();
+    std::vector<common::AssetDynamics> assets(n);
+    std::vector<std::vector<double>> correlation(n, std::vector<double>(n, 1.0));
     
-    for (int i = 0; i < simulations; ++i) {
-        double total_pnl = 0.0;
+    std::vector<common::SymbolId> ids(n);
+    for (size_t i = 0; i < n; ++i) {
+        ids[i] = symbolId(*representatives[i]);
         
-        for (const auto& position : positions) {
-            // Generate random return for each position
-            double volatility = 0.20 / std::sqrt(252); // Daily volatility
-            double random_return = normal_dist(gen) * volatility;
-            double position_pnl = position.market_value * random_return;
-            total_pnl += position_pnl;
+        double volatility = 0.20;
+        const auto* history = historical_returns_.find(ids[i]);
+        if (history && history->size() > 1) {
+            const auto& returns = *history;
+            double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+            double sum_sq = 0.0;
+            for (double r : returns) sum_sq += (r - mean) * (r - mean);
+            volatility = std::sqrt(sum_sq / (returns.size() - 1) * 252.0);
         }
+        assets[i] = {1.0, 0.0, volatility};
         
-        simulated_pnl.push_back(total_pnl);
+        for (size_t j = 0; j < i; ++j) {
+            correlation[i][j] = correlation[j][i] = pairCorrelation(ids[i], ids[j], 0.3);
+        }
     }
     
-    return calculateHistoricalVaR(simulated_pnl, confidence) / portfolio_value;
+    path_generator_.setCorrelation(correlation);
+    std::vector<double> simulated_returns =
+        path_generator_.simulatePortfolioReturns(assets, weights, 1.0 / 252.0, simulations);
+    
+    return calculateHistoricalVaR(simulated_returns, confidence);
 }
 
 double RiskManager::calculateExpectedShortfall(const std::vector<double>& returns, double confidence) {
@@ -209,9 +239,8 @@ StressTestResult RiskManager::runCustomStressTest(const std::vector<Position>& p
         double position_pnl = 0.0;
         
         // Apply price shock if exists for this symbol
-        auto shock_it = scenario.price_shocks.find(position.symbol);
-        if (shock_it != scenario.price_shocks.end()) {
-            position_pnl = position.market_value * shock_it->second;
+        if (const double* shock = scenario.price_shocks.find(symbolId(position))) {
+            position_pnl = position.market_value * *shock;
         } else {
             // Apply general market shock (simplified)
             position_pnl = position.market_value * -0.05; // -5% default shock
@@ -357,12 +386,54 @@ void RiskManager::loadHistoricalData() {
         for (int i = 0; i < 252; ++i) { // 1 year of daily returns
             returns.push_back(return_dist(gen));
         }
-        historical_returns_[symbol] = returns;
+        historical_returns_[common::SymbolRegistry::instance().intern(symbol)] = returns;
     }
     
+    updateCorrelationMatrix();
+    
     std::cout << "Loaded historical data for " << symbols.size() << " symbols" << std::endl;
 }
 
+void RiskManager::updateCorrelationMatrix() {
+    correlation_size_ = historical_returns_.bound();
+    correlation_matrix_.assign(static_cast<size_t>(correlation_size_) * correlation_size_,
+                               std::numeric_limits<double>::quiet_NaN());
+    
+    // Pairwise Pearson correlation over the overlapping (most recent) history
+    historical_returns_.forEach([&](common::SymbolId id_a, const std::vector<double>& returns_a) {
+        historical_returns_.forEach([&](common::SymbolId id_b, const std::vector<double>& returns_b) {
+            size_t n = std::min(returns_a.size(), returns_b.size());
+            if (n < 2) return;
+            
+            const double* a = returns_a.data() + (returns_a.size() - n);
+            const double* b = returns_b.data() + (returns_b.size() - n);
+            double mean_a = std::accumulate(a, a + n, 0.0) / n;
+            double mean_b = std::accumulate(b, b + n, 0.0) / n;
+            
+            double cov = 0.0, var_a = 0.0, var_b = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                cov += (a[i] - mean_a) * (b[i] - mean_b);
+                var_a += (a[i] - mean_a) * (a[i] - mean_a);
+                var_b += (b[i] - mean_b) * (b[i] - mean_b);
+            }
+            if (var_a > 0.0 && var_b > 0.0) {
+                correlation_matrix_[static_cast<size_t>(id_a) * correlation_size_ + id_b] = cov / std::sqrt(var_a * var_b);
+            }
+        });
+    });
+}
+
+double RiskManager::pairCorrelation(common::SymbolId a, common::SymbolId b, double fallback) const {
+    if (a >= correlation_size_ || b >= correlation_size_) return fallback;
+    double rho = correlation_matrix_[static_cast<size_t>(a) * correlation_size_ + b];
+    return std::isnan(rho) ? fallback : rho;
+}
+
+common::SymbolId RiskManager::symbolId(const Position& position) {
+    return position.symbol_id != common::INVALID_SYMBOL ? position.symbol_id
+                                                        : common::SymbolRegistry::instance().find(position.symbol);
+}
+
 std::vector<StressTestScenario> RiskManager::getStandardStressScenarios() {
     std::vector<StressTestScenario> scenarios;
     
@@ -376,16 +447,17 @@ std::vector<StressTestScenario> RiskManager::getStandardStressScenarios() {
 
 StressTestScenario RiskManager::createMarketCrashScenario() {
     StressTestScenario scenario;
+    auto& registry = common::SymbolRegistry::instance();
     scenario.name = "Market Crash 2008 Style";
     scenario.description = "Severe market downturn similar to 2008 financial crisis";
     
     // Apply severe negative shocks to all major symbols
-    scenario.price_shocks["AAPL"] = -0.30;   // -30%
-    scenario.price_shocks["GOOGL"] = -0.35;  // -35%
-    scenario.price_shocks["TSLA"] = -0.45;   // -45%
-    scenario.price_shocks["MSFT"] = -0.25;   // -25%
-    scenario.price_shocks["AMZN"] = -0.40;   // -40%
-    scenario.price_shocks["SPY"] = -0.30;    // -30%
+    scenario.price_shocks[registry.intern("AAPL")] = -0.30;   // -30%
+    scenario.price_shocks[registry.intern("GOOGL")] = -0.35;  // -35%
+    scenario.price_shocks[registry.intern("TSLA")] = -0.45;   // -45%
+    scenario.price_shocks[registry.intern("MSFT")] = -0.25;   // -25%
+    scenario.price_shocks[registry.intern("AMZN")] = -0.40;   // -40%
+    scenario.price_shocks[registry.intern("SPY")] = -0.30;    // -30%
     
     scenario.interest_rate_shock = -0.02;    // -200 bps
     scenario.volatility_shock = 0.15;        // +15% volatility
@@ -396,14 +468,15 @@ StressTestScenario RiskManager::createMarketCrashScenario() {
 
 StressTestScenario RiskManager::createInterestRateShockScenario() {
     StressTestScenario scenario;
+    auto& registry = common::SymbolRegistry::instance();
     scenario.name = "Interest Rate Shock";
     scenario.description = "Sudden 300 basis point increase in interest rates";
     
     // Moderate price shocks, focus on rate-sensitive sectors
-    scenario.price_shocks["AAPL"] = -0.10;
-    scenario.price_shocks["GOOGL"] = -0.08;
-    scenario.price_shocks["TSLA"] = -0.15;
-    scenario.price_shocks["MSFT"] = -0.12;
+    scenario.price_shocks[registry.intern("AAPL")] = -0.10;
+    scenario.price_shocks[registry.intern("GOOGL")] = -0.08;
+    scenario.price_shocks[registry.intern("TSLA")] = -0.15;
+    scenario.price_shocks[registry.intern("MSFT")] = -0.12;
     
     scenario.interest_rate_shock = 0.03;     // +300 bps
     scenario.volatility_shock = 0.05;        // +5% volatility
@@ -414,13 +487,14 @@ StressTestScenario RiskManager::createInterestRateShockScenario() {
 
 StressTestScenario RiskManager::createVolatilityShockScenario() {
     StressTestScenario scenario;
+    auto& registry = common::SymbolRegistry::instance();
     scenario.name = "Volatility Spike";
     scenario.description = "Sudden spike in market volatility (VIX to 50+)";
     
     // Moderate price movements but high volatility
-    scenario.price_shocks["AAPL"] = -0.05;
-    scenario.price_shocks["GOOGL"] = -0.08;
-    scenario.price_shocks["TSLA"] = -0.12;
+    scenario.price_shocks[registry.intern("AAPL")] = -0.05;
+    scenario.price_shocks[registry.intern("GOOGL")] = -0.08;
+    scenario.price_shocks[registry.intern("TSLA")] = -0.12;
     
     scenario.interest_rate_shock = 0.0;
     scenario.volatility_shock = 0.25;        // +25% volatility shock
@@ -431,15 +505,16 @@ StressTestScenario RiskManager::createVolatilityShockScenario() {
 
 StressTestScenario RiskManager::createSectorRotationScenario() {
     StressTestScenario scenario;
+    auto& registry = common::SymbolRegistry::instance();
     scenario.name = "Tech Sector Rotation";
     scenario.description = "Rotation out of technology stocks into value";
     
     // Tech stocks down, others neutral
-    scenario.price_shocks["AAPL"] = -0.20;
-    scenario.price_shocks["GOOGL"] = -0.25;
-    scenario.price_shocks["MSFT"] = -0.18;
-    scenario.price_shocks["TSLA"] = -0.30;
-    scenario.price_shocks["AMZN"] = -0.22;
+    scenario.price_shocks[registry.intern("AAPL")] = -0.20;
+    scenario.price_shocks[registry.intern("GOOGL")] = -0.25;
+    scenario.price_shocks[registry.intern("MSFT")] = -0.18;
+    scenario.price_shocks[registry.intern("TSLA")] = -0.30;
+    scenario.price_shocks[registry.intern("AMZN")] = -0.22;
     
     scenario.interest_rate_shock = 0.01;
     scenario.volatility_shock = 0.08;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "common/correlated_paths.h"
+#include "common/symbol_registry.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -11,6 +13,7 @@ namespace risk {
 
 struct Position {
     std::string symbol;
+    common::SymbolId symbol_id = common::INVALID_SYMBOL;  // Looked up from symbol when unset
     double quantity;
     double market_value;
     double unrealized_pnl;
@@ -55,7 +58,7 @@ struct RiskLimit {
 struct StressTestScenario {
     std::string name;
     std::string description;
-    std::unordered_map<std::string, double> price_shocks; // symbol -> shock percentage
+    common::SymbolTable<double> price_shocks; // symbol id -> shock percentage
     double interest_rate_shock;
     double volatility_shock;
     double correlation_shock;
@@ -129,13 +132,19 @@ private:
     bool real_time_monitoring_;
     
     // Historical data for calculations
-    std::unordered_map<std::string, std::vector<double>> historical_returns_;
-    std::unordered_map<std::string, std::vector<double>> historical_prices_;
+    common::SymbolTable<std::vector<double>> historical_returns_;
+    common::SymbolTable<std::vector<double>> historical_prices_;
     
-    // Correlation matrix
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> correlation_matrix_;
+    // Correlation matrix, row-major by symbol id; NaN where unknown
+    std::vector<double> correlation_matrix_;
+    common::SymbolId correlation_size_ = 0;
+    
+    // Joint return simulation for Monte Carlo VaR; keeps the last Cholesky factor
+    common::CorrelatedPathGenerator path_generator_;
     
     // Helper methods
+    static common::SymbolId symbolId(const Position& position);
+    double pairCorrelation(common::SymbolId a, common::SymbolId b, double fallback) const;
     void loadHistoricalData();
     void updateCorrelationMatrix();
     std::vector<double> generateRandomReturns(const std::vector<Position>& positions);
@@ -0,0 +1,175 @@
+#include "common/correlated_paths.h"
+#include "common/fast_math.h"
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace hedgefund {
+namespace common {
+
+bool CholeskyFactor::factorize(const std::vector<std::vector<double>>& correlation) {
+    for (const auto& row : correlation) {
+        if (row.size() != correlation.size()) return false;
+    }
+
+    // Shrinking towards the identity keeps unit diagonals and always ends positive definite
+    for (double shrinkage : {0.0, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0}) {
+        if (tryFactorize(correlation, shrinkage)) return true;
+    }
+    return false;
+}
+
+bool CholeskyFactor::tryFactorize(const std::vector<std::vector<double>>& correlation, double shrinkage) {
+    const int n = static_cast<int>(correlation.size());
+    num_assets_ = n;
+    shrinkage_ = shrinkage;
+    lower_.assign(static_cast<size_t>(n) * n, 0.0);
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            double target = i == j ? 1.0 : (1.0 - shrinkage) * correlation[i][j];
+            double sum = target;
+            for (int k = 0; k < j; k++) {
+                sum -= lower_[static_cast<size_t>(i) * n + k] * lower_[static_cast<size_t>(j) * n + k];
+            }
+            if (i == j) {
+                if (sum <= 1e-12) return false;
+                lower_[static_cast<size_t>(i) * n + i] = std::sqrt(sum);
+            } else {
+                lower_[static_cast<size_t>(i) * n + j] = sum / lower_[static_cast<size_t>(j) * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+int MultiAssetPathBlock::blockSizeFor(int num_assets, int num_steps) {
+    const size_t target_prices = (256 * 1024) / sizeof(double);
+    size_t paths = target_prices / (static_cast<size_t>(num_steps + 1) * std::max(1, num_assets));
+    paths = std::max<size_t>(64, std::min<size_t>(4096, paths));
+    return static_cast<int>(paths & ~size_t(7)); // Multiple of 8 for clean vector loops
+}
+
+void MultiAssetPathBlock::resize(int num_assets, int num_paths, int num_steps) {
+    num_assets_ = num_assets;
+    num_paths_ = num_paths;
+    num_steps_ = num_steps;
+    data_.resize(static_cast<size_t>(num_steps + 1) * num_assets * num_paths);
+    normals_.resize(static_cast<size_t>(num_assets) * num_paths);
+    increments_.resize(num_paths);
+}
+
+CorrelatedPathGenerator::CorrelatedPathGenerator(unsigned int seed) : seed_(seed) {}
+
+bool CorrelatedPathGenerator::setCorrelation(const std::vector<std::vector<double>>& correlation) {
+    if (correlation == correlation_ && factor_.numAssets() == static_cast<int>(correlation.size())) {
+        return false;
+    }
+    if (!factor_.factorize(correlation)) return false;
+    correlation_ = correlation;
+    return true;
+}
+
+void CorrelatedPathGenerator::generateBlock(MultiAssetPathBlock& block, const std::vector<AssetDynamics>& assets,
+                                            double time_horizon, int num_steps, int num_paths,
+                                            uint64_t block_index) const {
+    const int num_assets = static_cast<int>(assets.size());
+    num_steps = std::max(1, num_steps);
+    block.resize(num_assets, num_paths, num_steps);
+
+    // Without a matching factor the assets are simulated independently
+    const bool correlated = factor_.numAssets() == num_assets;
+
+    std::seed_seq seq{seed_, static_cast<unsigned int>(block_index), static_cast<unsigned int>(block_index >> 32)};
+    std::mt19937 rng(seq);
+    std::normal_distribution<double> dist(0.0, 1.0);
+
+    const double dt = time_horizon / num_steps;
+    const double sqrt_dt = std::sqrt(dt);
+
+    for (int a = 0; a < num_assets; a++) {
+        std::fill(block.row(0, a), block.row(0, a) + num_paths, assets[a].spot_price);
+    }
+
+    double* increments = block.increments_.data();
+    for (int step = 1; step <= num_steps; step++) {
+        for (auto& z : block.normals_) z = dist(rng);
+
+        for (int i = 0; i < num_assets; i++) {
+            // Correlate with row i of the factor, one unit-stride sweep per term
+            const double* z_i = block.normals_.data() + static_cast<size_t>(i) * num_paths;
+            double l_ii = correlated ? factor_.at(i, i) : 1.0;
+            for (int p = 0; p < num_paths; p++) increments[p] = l_ii * z_i[p];
+            for (int j = 0; correlated && j < i; j++) {
+                const double* z_j = block.normals_.data() + static_cast<size_t>(j) * num_paths;
+                double l_ij = factor_.at(i, j);
+                for (int p = 0; p < num_paths; p++) increments[p] += l_ij * z_j[p];
+            }
+
+            const double vol = assets[i].volatility;
+            const double drift_dt = (assets[i].drift - 0.5 * vol * vol) * dt;
+            const double vol_sqrt_dt = vol * sqrt_dt;
+            for (int p = 0; p < num_paths; p++) increments[p] = drift_dt + vol_sqrt_dt * increments[p];
+            common::math::expBatch(increments, increments, num_paths);
+
+            const double* prev = block.row(step - 1, i);
+            double* next = block.row(step, i);
+            for (int p = 0; p < num_paths; p++) next[p] = prev[p] * increments[p];
+        }
+    }
+}
+
+void CorrelatedPathGenerator::simulate(const std::vector<AssetDynamics>& assets, double time_horizon, int num_steps,
+                                       int num_paths, const BlockVisitor& visitor, int num_threads) const {
+    if (assets.empty() || num_paths <= 0) return;
+
+    const int block_size = MultiAssetPathBlock::blockSizeFor(static_cast<int>(assets.size()), num_steps);
+    const size_t num_blocks = (static_cast<size_t>(num_paths) + block_size - 1) / block_size;
+
+    size_t threads = num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, num_blocks);
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        MultiAssetPathBlock block;
+        for (size_t b = next.fetch_add(1); b < num_blocks; b = next.fetch_add(1)) {
+            int first = static_cast<int>(b * block_size);
+            int count = std::min(block_size, num_paths - first);
+            generateBlock(block, assets, time_horizon, num_steps, count, b);
+            block.first_path_ = first;
+            visitor(block);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t t = 1; t < threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+std::vector<double> CorrelatedPathGenerator::simulatePortfolioReturns(const std::vector<AssetDynamics>& assets,
+                                                                      const std::vector<double>& weights,
+                                                                      double time_horizon, int num_scenarios,
+                                                                      int num_threads) const {
+    std::vector<double> returns(std::max(0, num_scenarios), 0.0);
+    simulate(assets, time_horizon, 1, num_scenarios, [&](const MultiAssetPathBlock& block) {
+        double* out = returns.data() + block.firstPath();
+        for (int a = 0; a < block.numAssets() && a < static_cast<int>(weights.size()); a++) {
+            const double* terminal = block.row(1, a);
+            double scale = weights[a] / assets[a].spot_price;
+            for (int p = 0; p < block.numPaths(); p++) {
+                out[p] += scale * terminal[p] - weights[a];
+            }
+        }
+    }, num_threads);
+    return returns;
+}
+
+} // namespace common
+} // namespace hedgefund
@@ -1,4 +1,5 @@
 #include "common/messaging.h"
+#include "common/tick_codec.h"
 #include <iostream>
 #include <chrono>
 
@@ -28,6 +29,11 @@ bool MessageQueue::publish(const std::string& topic, const std::string& payload)
     auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     
+    if (isBinaryTick(payload)) {
+        std::cout << "Publishing to " << topic << ": <binary ticks, " << payload.size() << " bytes>" << std::endl;
+        return true;
+    }
+    
     std::cout << "Publishing to " << topic << ": " << payload.substr(0, 100) 
               << (payload.length() > 100 ? "..." : "") << std::endl;
     
@@ -0,0 +1,107 @@
+#include "common/order_messages.h"
+#include <cstdlib>
+#include <sstream>
+
+namespace hedgefund {
+namespace common {
+
+namespace {
+
+std::vector<std::string> split(const std::string& text, char delimiter) {
+    std::vector<std::string> fields;
+    std::stringstream ss(text);
+    std::string field;
+    while (std::getline(ss, field, delimiter)) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end == text.c_str() + text.size();
+}
+
+} // namespace
+
+std::string encodeOrderBatch(const std::vector<OrderMessage>& orders) {
+    std::ostringstream out;
+    out.precision(10);
+    out << "ORDER_BATCH";
+    for (const auto& order : orders) {
+        out << ';' << order.order_id << ',' << order.symbol << ',' << (order.buy ? "BUY" : "SELL")
+            << ',' << order.price << ',' << order.quantity;
+    }
+    return out.str();
+}
+
+std::string encodeOrderAcks(const std::vector<OrderAck>& acks) {
+    std::string out = "ORDER_ACK";
+    for (const auto& ack : acks) {
+        out += ';';
+        out += ack.order_id;
+        out += ack.accepted ? ",ACCEPTED" : ",REJECTED";
+    }
+    return out;
+}
+
+std::string encodeTrade(const TradeMessage& trade) {
+    std::ostringstream out;
+    out.precision(10);
+    out << "TRADE," << trade.price << "," << trade.quantity
+        << "," << trade.buy_order_id << "," << trade.sell_order_id;
+    return out.str();
+}
+
+bool decodeOrderBatch(const std::string& payload, std::vector<OrderMessage>& orders,
+                      std::vector<std::string>* malformed_ids) {
+    auto records = split(payload, ';');
+    if (records.empty() || records[0] != "ORDER_BATCH") return false;
+    
+    bool well_formed = true;
+    for (size_t i = 1; i < records.size(); i++) {
+        auto fields = split(records[i], ',');
+        OrderMessage order;
+        bool valid = fields.size() == 5 && !fields[0].empty() && !fields[1].empty() &&
+                     (fields[2] == "BUY" || fields[2] == "SELL") && parseDouble(fields[3], order.price) &&
+                     parseDouble(fields[4], order.quantity);
+        if (!valid) {
+            well_formed = false;
+            if (malformed_ids && !fields.empty() && !fields[0].empty()) malformed_ids->push_back(fields[0]);
+            continue;
+        }
+        
+        order.order_id = fields[0];
+        order.symbol = fields[1];
+        order.buy = fields[2] == "BUY";
+        orders.push_back(std::move(order));
+    }
+    return well_formed;
+}
+
+bool decodeOrderAcks(const std::string& payload, std::vector<OrderAck>& acks) {
+    auto records = split(payload, ';');
+    if (records.empty() || records[0] != "ORDER_ACK") return false;
+    
+    for (size_t i = 1; i < records.size(); i++) {
+        auto fields = split(records[i], ',');
+        if (fields.size() != 2 || fields[0].empty()) return false;
+        if (fields[1] != "ACCEPTED" && fields[1] != "REJECTED") return false;
+        acks.push_back(OrderAck{fields[0], fields[1] == "ACCEPTED"});
+    }
+    return true;
+}
+
+bool decodeTrade(const std::string& payload, TradeMessage& trade) {
+    auto fields = split(payload, ',');
+    if (fields.size() != 5 || fields[0] != "TRADE") return false;
+    if (!parseDouble(fields[1], trade.price) || !parseDouble(fields[2], trade.quantity)) return false;
+    trade.buy_order_id = fields[3];
+    trade.sell_order_id = fields[4];
+    return true;
+}
+
+} // namespace common
+} // namespace hedgefund
@@ -0,0 +1,62 @@
+#include "common/symbol_registry.h"
+
+namespace hedgefund {
+namespace common {
+
+SymbolRegistry& SymbolRegistry::instance() {
+    static SymbolRegistry registry;
+    return registry;
+}
+
+SymbolRegistry::SymbolRegistry() {
+    for (auto& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SymbolRegistry::~SymbolRegistry() {
+    for (auto& chunk : chunks_) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+SymbolId SymbolRegistry::intern(const std::string& symbol) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(symbol);
+        if (it != ids_.end()) return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(symbol);
+    if (it != ids_.end()) return it->second;
+
+    size_t id = size_.load(std::memory_order_relaxed);
+    if (id >= CHUNK_SIZE * MAX_CHUNKS) return INVALID_SYMBOL;
+
+    std::string* chunk = chunks_[id / CHUNK_SIZE].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new std::string[CHUNK_SIZE];
+        chunks_[id / CHUNK_SIZE].store(chunk, std::memory_order_release);
+    }
+    chunk[id % CHUNK_SIZE] = symbol;
+
+    ids_.emplace(symbol, static_cast<SymbolId>(id));
+    size_.store(id + 1, std::memory_order_release);
+    return static_cast<SymbolId>(id);
+}
+
+SymbolId SymbolRegistry::find(const std::string& symbol) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(symbol);
+    return it != ids_.end() ? it->second : INVALID_SYMBOL;
+}
+
+const std::string& SymbolRegistry::name(SymbolId id) const {
+    static const std::string unknown;
+    if (id >= size()) return unknown;
+    return chunks_[id / CHUNK_SIZE].load(std::memory_order_acquire)[id % CHUNK_SIZE];
+}
+
+} // namespace common
+} // namespace hedgefund
@@ -0,0 +1,101 @@
+#include "common/tick_codec.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace hedgefund {
+namespace common {
+
+namespace {
+
+// Appends a zeroed record with its header filled in; returns its offset
+size_t beginRecord(std::string& out, TickKind kind, size_t length, const std::string& symbol, int64_t timestamp_ns) {
+    size_t start = out.size();
+    out.resize(start + length, '\0');
+    char* record = &out[start];
+    
+    record[0] = static_cast<char>(tick::MAGIC);
+    record[1] = static_cast<char>(tick::VERSION);
+    record[2] = static_cast<char>(kind);
+    uint32_t record_length = static_cast<uint32_t>(length);
+    std::memcpy(record + 4, &record_length, sizeof(record_length));
+    std::memcpy(record + 8, &timestamp_ns, sizeof(timestamp_ns));
+    std::memcpy(record + tick::SYMBOL_OFFSET, symbol.data(), std::min(symbol.size(), tick::SYMBOL_SIZE));
+    return start;
+}
+
+template <typename T>
+void store(std::string& out, size_t record, size_t offset, T value) {
+    std::memcpy(&out[record + offset], &value, sizeof(T));
+}
+
+size_t minimumLength(uint8_t kind) {
+    switch (static_cast<TickKind>(kind)) {
+        case TickKind::QUOTE: return tick::QUOTE_SIZE;
+        case TickKind::OPTION_QUOTE: return tick::OPTION_QUOTE_SIZE;
+    }
+    return 0;
+}
+
+} // namespace
+
+void appendQuote(std::string& out, const std::string& symbol, const QuoteFields& fields, int64_t timestamp_ns) {
+    size_t record = beginRecord(out, TickKind::QUOTE, tick::QUOTE_SIZE, symbol, timestamp_ns);
+    store(out, record, tick::PRICE_OFFSET, fields.price);
+    store(out, record, tick::VOLUME_OFFSET, fields.volume);
+    store(out, record, tick::BID_OFFSET, fields.bid);
+    store(out, record, tick::ASK_OFFSET, fields.ask);
+    store(out, record, tick::HIGH_OFFSET, fields.high);
+    store(out, record, tick::LOW_OFFSET, fields.low);
+    store(out, record, tick::CHANGE_PERCENT_OFFSET, fields.change_percent);
+}
+
+void appendOptionQuote(std::string& out, const std::string& underlying, const OptionQuoteFields& fields,
+                       int64_t timestamp_ns) {
+    size_t record = beginRecord(out, TickKind::OPTION_QUOTE, tick::OPTION_QUOTE_SIZE, underlying, timestamp_ns);
+    store(out, record, tick::STRIKE_OFFSET, fields.strike_price);
+    store(out, record, tick::OPTION_PRICE_OFFSET, fields.price);
+    store(out, record, tick::IMPLIED_VOL_OFFSET, fields.implied_vol);
+    store(out, record, tick::DELTA_OFFSET, fields.delta);
+    store(out, record, tick::EXPIRY_OFFSET, fields.expiry);
+    store(out, record, tick::IS_CALL_OFFSET, static_cast<uint8_t>(fields.is_call ? 1 : 0));
+}
+
+int32_t packExpiry(const std::string& expiration_date) {
+    int year = 0, month = 0, day = 0;
+    if (std::sscanf(expiration_date.c_str(), "%4d-%2d-%2d", &year, &month, &day) != 3) return 0;
+    if (month < 1 || month > 12 || day < 1 || day > 31) return 0;
+    return year * 10000 + month * 100 + day;
+}
+
+std::string formatExpiry(int32_t expiry) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", expiry / 10000, (expiry / 100) % 100, expiry % 100);
+    return buffer;
+}
+
+bool TickReader::next() {
+    if (offset_ >= size_ || malformed_) return false;
+    
+    const char* record = data_ + offset_;
+    size_t remaining = size_ - offset_;
+    uint32_t length = 0;
+    if (remaining < tick::HEADER_SIZE) {
+        malformed_ = true;
+        return false;
+    }
+    std::memcpy(&length, record + 4, sizeof(length));
+    
+    // Records may be longer than their kind needs, so fields can be appended; unknown kinds are skipped by callers
+    if (static_cast<uint8_t>(record[0]) != tick::MAGIC || static_cast<uint8_t>(record[1]) != tick::VERSION ||
+        length > remaining || length < minimumLength(static_cast<uint8_t>(record[2])) || length < tick::HEADER_SIZE) {
+        malformed_ = true;
+        return false;
+    }
+    
+    record_ = record;
+    offset_ += length;
+    return true;
+}
+
+} // namespace common
+} // namespace hedgefund
@@ -0,0 +1,77 @@
+#include "test_util.h"
+#include "chain_pricer.h"
+#include <string>
+
+using namespace hedgefund::options;
+
+static ChainDelta sampleDelta() {
+    ChainDelta delta;
+    delta.underlying = "AAPL";
+    delta.spot_price = 187.25;
+    delta.timestamp = 1760000000123;
+    for (uint32_t i = 0; i < 3; i++) {
+        ChainUpdate update;
+        update.contract_id = 10 + i;
+        update.price = 1.5f + i;
+        update.delta = 0.25f * i;
+        update.gamma = 0.01f;
+        update.theta = -0.02f;
+        update.vega = 0.1f;
+        delta.updates.push_back(update);
+    }
+    return delta;
+}
+
+static void testRoundTrip() {
+    ChainDelta sent = sampleDelta();
+    ChainDelta received;
+    CHECK(decodeChainDelta(encodeChainDelta(sent), received));
+    CHECK(received.underlying == sent.underlying);
+    CHECK(received.spot_price == sent.spot_price);
+    CHECK(received.timestamp == sent.timestamp);
+    CHECK(received.updates.size() == sent.updates.size());
+    for (size_t i = 0; i < sent.updates.size() && i < received.updates.size(); i++) {
+        CHECK(received.updates[i].contract_id == sent.updates[i].contract_id);
+        CHECK(received.updates[i].price == sent.updates[i].price);
+        CHECK(received.updates[i].delta == sent.updates[i].delta);
+        CHECK(received.updates[i].vega == sent.updates[i].vega);
+    }
+}
+
+static void testEmptyDelta() {
+    ChainDelta sent;
+    sent.underlying = "";
+    sent.spot_price = 0.0;
+    sent.timestamp = 0;
+    ChainDelta received = sampleDelta();
+    CHECK(decodeChainDelta(encodeChainDelta(sent), received));
+    CHECK(received.underlying.empty());
+    CHECK(received.updates.empty());
+}
+
+static void testRejectsDamagedPayloads() {
+    std::string payload = encodeChainDelta(sampleDelta());
+    ChainDelta received;
+
+    CHECK(!decodeChainDelta("", received));
+    CHECK(!decodeChainDelta("CHAIN_UPDATE,AAPL", received));
+    for (size_t length : {size_t(3), size_t(5), size_t(10), payload.size() - 1}) {
+        CHECK(!decodeChainDelta(payload.substr(0, length), received));
+    }
+    CHECK(!decodeChainDelta(payload + "x", received));  // Count no longer matches the records
+
+    std::string bad_magic = payload;
+    bad_magic[0] = 'X';
+    CHECK(!decodeChainDelta(bad_magic, received));
+
+    std::string long_symbol = payload;
+    long_symbol[4] = static_cast<char>(0xff);  // Symbol length past the end
+    CHECK(!decodeChainDelta(long_symbol, received));
+}
+
+int main() {
+    testRoundTrip();
+    testEmptyDelta();
+    testRejectsDamagedPayloads();
+    return TEST_RESULT("chain_delta");
+}
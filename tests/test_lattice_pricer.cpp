@@ -0,0 +1,123 @@
+#include "test_util.h"
+#include "lattice_pricer.h"
+#include "black_scholes.h"
+#include <cmath>
+
+using namespace hedgefund::options;
+
+static LatticeParams latticeParams(double strike, bool is_call, bool is_american, LatticeType type, int steps) {
+    LatticeParams params;
+    params.spot_price = 100.0;
+    params.strike_price = strike;
+    params.time_to_expiry = 0.75;
+    params.risk_free_rate = 0.05;
+    params.volatility = 0.25;
+    params.is_call = is_call;
+    params.is_american = is_american;
+    params.lattice_type = type;
+    params.num_steps = steps;
+    return params;
+}
+
+static double blackScholes(const LatticeParams& lattice) {
+    OptionParams params;
+    params.spot_price = lattice.spot_price;
+    params.strike_price = lattice.strike_price;
+    params.time_to_expiry = lattice.time_to_expiry;
+    params.risk_free_rate = lattice.risk_free_rate;
+    params.volatility = lattice.volatility;
+    params.is_call = lattice.is_call;
+    params.dividend_yield = lattice.carry_yield;
+    return BlackScholes::calculatePrice(params);
+}
+
+static void testEuropeanConvergesToBlackScholes() {
+    LatticePricer pricer;
+    for (double strike : {80.0, 100.0, 120.0}) {
+        for (bool is_call : {true, false}) {
+            LatticeParams lr = latticeParams(strike, is_call, false, LatticeType::LEISEN_REIMER, 201);
+            LatticeParams crr = latticeParams(strike, is_call, false, LatticeType::CRR, 1000);
+            LatticeParams tri = latticeParams(strike, is_call, false, LatticeType::TRINOMIAL, 500);
+            double exact = blackScholes(lr);
+            CHECK_NEAR(pricer.price(lr).price, exact, 1e-3);
+            CHECK_NEAR(pricer.price(crr).price, exact, 2e-2);
+            CHECK_NEAR(pricer.price(tri).price, exact, 2e-2);
+        }
+    }
+}
+
+static void testLeisenReimerErrorShrinks() {
+    LatticePricer pricer;
+    LatticeParams coarse = latticeParams(105.0, false, false, LatticeType::LEISEN_REIMER, 51);
+    LatticeParams fine = latticeParams(105.0, false, false, LatticeType::LEISEN_REIMER, 401);
+    double exact = blackScholes(coarse);
+    CHECK(std::fabs(pricer.price(fine).price - exact) < std::fabs(pricer.price(coarse).price - exact));
+}
+
+static void testEarlyExercise() {
+    LatticePricer pricer;
+    // Without dividends an American call is worth the European one; a put is worth more
+    LatticeParams american_call = latticeParams(100.0, true, true, LatticeType::LEISEN_REIMER, 201);
+    LatticeParams european_call = latticeParams(100.0, true, false, LatticeType::LEISEN_REIMER, 201);
+    CHECK_NEAR(pricer.price(american_call).price, pricer.price(european_call).price, 1e-6);
+
+    LatticeParams american_put = latticeParams(110.0, false, true, LatticeType::LEISEN_REIMER, 201);
+    LatticeParams european_put = latticeParams(110.0, false, false, LatticeType::LEISEN_REIMER, 201);
+    double premium = pricer.price(american_put).price - pricer.price(european_put).price;
+    CHECK(premium > 0.05);
+    CHECK(pricer.price(american_put).price >= 110.0 - 100.0);
+}
+
+static void testGreeksMatchBlackScholes() {
+    LatticePricer pricer;
+    LatticeParams params = latticeParams(100.0, true, false, LatticeType::LEISEN_REIMER, 201);
+    OptionParams bs;
+    bs.spot_price = params.spot_price;
+    bs.strike_price = params.strike_price;
+    bs.time_to_expiry = params.time_to_expiry;
+    bs.risk_free_rate = params.risk_free_rate;
+    bs.volatility = params.volatility;
+    bs.is_call = params.is_call;
+    Greeks exact = BlackScholes::calculateGreeks(bs);
+    Greeks lattice = pricer.price(params).greeks;
+    CHECK_NEAR(lattice.delta, exact.delta, 2e-3);
+    CHECK_NEAR(lattice.gamma, exact.gamma, 1e-3);
+}
+
+static void testContinuousCarry() {
+    LatticePricer pricer;
+    for (LatticeType type : {LatticeType::LEISEN_REIMER, LatticeType::TRINOMIAL}) {
+        for (bool is_call : {true, false}) {
+            LatticeParams params = latticeParams(100.0, is_call, false, type, 501);
+            params.carry_yield = 0.04;
+            CHECK_NEAR(pricer.price(params).price, blackScholes(params), 1e-2);
+        }
+    }
+
+    // A yield above the rate makes early exercise of a deep call worthwhile
+    LatticeParams american = latticeParams(80.0, true, true, LatticeType::LEISEN_REIMER, 201);
+    american.carry_yield = 0.08;
+    LatticeParams european = american;
+    european.is_american = false;
+    CHECK(pricer.price(american).price > pricer.price(european).price + 0.05);
+}
+
+static void testCashDividendMatchesEscrowedEuropean() {
+    // Europeans only see the escrowed spot, so the dividend is just a spot shift
+    LatticePricer pricer;
+    LatticeParams params = latticeParams(100.0, false, false, LatticeType::LEISEN_REIMER, 201);
+    params.dividends = {{0.25, 2.0}};
+    LatticeParams escrowed = latticeParams(100.0, false, false, LatticeType::LEISEN_REIMER, 201);
+    escrowed.spot_price -= 2.0 * std::exp(-params.risk_free_rate * 0.25);
+    CHECK_NEAR(pricer.price(params).price, blackScholes(escrowed), 1e-3);
+}
+
+int main() {
+    testEuropeanConvergesToBlackScholes();
+    testLeisenReimerErrorShrinks();
+    testEarlyExercise();
+    testGreeksMatchBlackScholes();
+    testContinuousCarry();
+    testCashDividendMatchesEscrowedEuropean();
+    return TEST_RESULT("lattice_pricer");
+}
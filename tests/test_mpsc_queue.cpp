@@ -0,0 +1,74 @@
+#include "test_util.h"
+#include "mpsc_queue.h"
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using hedgefund::algo::MpscQueue;
+
+static void testFifo() {
+    MpscQueue<int> queue;
+    int value = -1;
+    CHECK(!queue.pop(value));
+    for (int i = 0; i < 100; i++) queue.push(i);
+    for (int i = 0; i < 100; i++) {
+        CHECK(queue.pop(value));
+        CHECK(value == i);
+    }
+    CHECK(!queue.pop(value));
+}
+
+static void testMoveOnlyAndLeftovers() {
+    auto tracked = std::make_shared<int>(7);
+    {
+        MpscQueue<std::shared_ptr<int>> queue;
+        queue.push(tracked);
+        queue.push(tracked);
+        std::shared_ptr<int> out;
+        CHECK(queue.pop(out));
+        CHECK(out && *out == 7);
+        out.reset();
+        CHECK(tracked.use_count() == 2);
+    }
+    // The destructor drains whatever was never popped
+    CHECK(tracked.use_count() == 1);
+}
+
+static void testProducersKeepTheirOrder() {
+    constexpr int PRODUCERS = 4;
+    constexpr uint64_t PER_PRODUCER = 100000;
+    MpscQueue<uint64_t> queue;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([&queue, p]() {
+            for (uint64_t i = 0; i < PER_PRODUCER; i++) queue.push((static_cast<uint64_t>(p) << 32) | i);
+        });
+    }
+
+    std::vector<uint64_t> next(PRODUCERS, 0);
+    uint64_t received = 0;
+    bool ordered = true;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        uint64_t value;
+        if (!queue.pop(value)) continue;
+        size_t producer = value >> 32;
+        ordered = ordered && producer < PRODUCERS && (value & 0xffffffffu) == next[producer];
+        if (producer < PRODUCERS) next[producer]++;
+        received++;
+    }
+    for (auto& producer : producers) producer.join();
+
+    CHECK(ordered);
+    for (int p = 0; p < PRODUCERS; p++) CHECK(next[p] == PER_PRODUCER);
+    uint64_t value;
+    CHECK(!queue.pop(value));
+}
+
+int main() {
+    testFifo();
+    testMoveOnlyAndLeftovers();
+    testProducersKeepTheirOrder();
+    return TEST_RESULT("mpsc_queue");
+}
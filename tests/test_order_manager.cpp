@@ -0,0 +1,114 @@
+#include "test_util.h"
+#include "order_manager.h"
+#include "order_gateway.h"
+#include "common/order_messages.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace hedgefund::algo;
+using namespace hedgefund::common;
+
+namespace {
+
+// Records what the manager sends without reporting anything back
+struct RecordingGateway : OrderGateway {
+    std::vector<std::string>* sent;
+    std::vector<std::string>* cancelled;
+
+    RecordingGateway(std::vector<std::string>* sent, std::vector<std::string>* cancelled)
+        : sent(sent), cancelled(cancelled) {}
+
+    void sendBatch(const std::vector<OrderMessage>& orders) override {
+        for (const auto& order : orders) sent->push_back(order.order_id);
+    }
+    void sendCancel(const std::string& order_id, const std::string&) override { cancelled->push_back(order_id); }
+};
+
+TradingSignal signal(const std::string& symbol) {
+    TradingSignal signal;
+    signal.strategy_id = "test";
+    signal.symbol = symbol;
+    signal.signal_type = SignalType::BUY;
+    signal.price = 10.0;
+    signal.quantity = 1.0;
+    signal.confidence = 1.0;
+    signal.timestamp = std::chrono::system_clock::now();
+    return signal;
+}
+
+ExecutionReport report(ExecutionReport::Type type, const std::string& order_id) {
+    ExecutionReport execution;
+    execution.type = type;
+    execution.order_id = order_id;
+    execution.received = std::chrono::system_clock::now();
+    return execution;
+}
+
+} // namespace
+
+static void testUnackedOrdersExpire() {
+    std::vector<std::string> sent, cancelled;
+    OrderManager manager;
+    manager.setGateway(std::make_unique<RecordingGateway>(&sent, &cancelled));
+    manager.setAckTimeout(std::chrono::milliseconds(100));
+
+    ContractKey key = ContractKey::underlying(SymbolRegistry::instance().intern("EXPIRE"));
+    std::string acked = manager.submit(signal("EXPIRE"), key, 10.0)->id;
+    std::string lost = manager.submit(signal("EXPIRE"), key, 5.0)->id;
+    CHECK(manager.flush() == 2);
+    auto sent_at = std::chrono::system_clock::now();
+
+    double filled = 0.0;
+    CHECK(manager.apply(report(ExecutionReport::Type::ACK, acked), filled) != nullptr);
+
+    // Nothing is overdue before the timeout
+    CHECK(manager.expireUnacknowledged(sent_at).empty());
+    CHECK(manager.openOrders() == 2);
+
+    const auto& expired = manager.expireUnacknowledged(sent_at + std::chrono::seconds(1));
+    CHECK(expired.size() == 1);
+    if (expired.size() == 1) {
+        CHECK(expired[0]->id == lost);
+        CHECK(expired[0]->state == OrderState::EXPIRED);
+    }
+    CHECK(cancelled.size() == 1 && cancelled[0] == lost);
+    CHECK(manager.openOrders() == 1);
+
+    // A late fill for the expired order is ignored; each order expires once
+    CHECK(manager.apply(report(ExecutionReport::Type::FILL, lost), filled) == nullptr);
+    CHECK(manager.expireUnacknowledged(sent_at + std::chrono::seconds(2)).empty());
+    CHECK(manager.find(acked)->state == OrderState::ACKNOWLEDGED);
+
+    manager.flush();
+    CHECK(manager.find(lost) == nullptr);
+}
+
+static void testBatchSkipsMalformedRecords() {
+    std::vector<OrderMessage> orders;
+    std::vector<std::string> malformed;
+    std::string payload = "ORDER_BATCH;A1,AAPL,BUY,150,100;A2,AAPL,HOLD,150,100;A3,AAPL,SELL,abc,5;"
+                          "A4,AAPL,SELL,151,50;,AAPL,BUY,1,1;A5,AAPL";
+    CHECK(!decodeOrderBatch(payload, orders, &malformed));
+
+    // Good records on either side of a bad one are all kept
+    CHECK(orders.size() == 2);
+    if (orders.size() == 2) {
+        CHECK(orders[0].order_id == "A1" && orders[0].buy);
+        CHECK(orders[1].order_id == "A4" && !orders[1].buy && orders[1].quantity == 50.0);
+    }
+    // Bad records are reported by id, except the one without an id
+    CHECK((malformed == std::vector<std::string>{"A2", "A3", "A5"}));
+
+    orders.clear();
+    malformed.clear();
+    CHECK(decodeOrderBatch(encodeOrderBatch({{"B1", "MSFT", false, 300.5, 10}}), orders, &malformed));
+    CHECK(orders.size() == 1 && malformed.empty());
+    CHECK(!decodeOrderBatch("ORDERS;B1,MSFT,SELL,1,1", orders));
+}
+
+int main() {
+    testUnackedOrdersExpire();
+    testBatchSkipsMalformedRecords();
+    return TEST_RESULT("order_manager");
+}
@@ -0,0 +1,115 @@
+#include "test_util.h"
+#include "position_book.h"
+#include <chrono>
+#include <cmath>
+
+using namespace hedgefund::algo;
+using hedgefund::common::SymbolRegistry;
+
+static void testLongToShortFlip() {
+    PositionBook book;
+    auto now = std::chrono::system_clock::now();
+    ContractKey key = ContractKey::underlying(SymbolRegistry::instance().intern("FLIP"));
+
+    CHECK(book.applyFill(key, "FLIP", 100, 10.0, now) == 0.0);
+    // Sell 150: closes 100 for +200 and opens 50 short at the fill price
+    CHECK_NEAR(book.applyFill(key, "FLIP", -150, 12.0, now), 200.0, 1e-9);
+    const Position* position = book.find(key);
+    CHECK(position != nullptr);
+    if (position) {
+        CHECK(position->quantity == -50.0);
+        CHECK(position->average_price == 12.0);
+    }
+    CHECK_NEAR(book.realizedPnl(), 200.0, 1e-9);
+
+    book.markPrice(key.symbol_id, 11.0);
+    CHECK_NEAR(book.unrealizedPnl(), 50.0, 1e-9);
+    CHECK_NEAR(book.grossExposure(), 550.0, 1e-9);
+
+    // Buy 80: covers the 50 short for +50 and flips long 30 at 11
+    CHECK_NEAR(book.applyFill(key, "FLIP", 80, 11.0, now), 50.0, 1e-9);
+    position = book.find(key);
+    CHECK(position != nullptr);
+    if (position) {
+        CHECK(position->quantity == 30.0);
+        CHECK(position->average_price == 11.0);
+    }
+    CHECK_NEAR(book.realizedPnl(), 250.0, 1e-9);
+    CHECK_NEAR(book.unrealizedPnl(), 0.0, 1e-9);
+}
+
+static void testExactCloseRemovesPosition() {
+    PositionBook book;
+    auto now = std::chrono::system_clock::now();
+    ContractKey key = ContractKey::underlying(SymbolRegistry::instance().intern("FLAT"));
+
+    book.applyFill(key, "FLAT", -20, 50.0, now);
+    CHECK_NEAR(book.applyFill(key, "FLAT", 20, 45.0, now), 100.0, 1e-9);
+    CHECK(book.find(key) == nullptr);
+    CHECK(book.size() == 0);
+    CHECK_NEAR(book.grossExposure(), 0.0, 1e-9);
+    CHECK_NEAR(book.unrealizedPnl(), 0.0, 1e-9);
+
+    // Marks for a symbol with no positions are ignored
+    book.markPrice(key.symbol_id, 40.0);
+    CHECK(book.size() == 0);
+}
+
+static void testOptionsFlipIndependently() {
+    PositionBook book;
+    auto now = std::chrono::system_clock::now();
+    auto id = SymbolRegistry::instance().intern("OPT");
+    ContractKey call = ContractKey::option(id, "2026-12-18", 100.0, true);
+    ContractKey put = ContractKey::option(id, "2026-12-18", 100.0, false);
+    CHECK(call.expiry == 20261218);
+
+    book.applyFill(call, "OPT", 5, 2.0, now, "2026-12-18");
+    book.applyFill(put, "OPT", -3, 1.5, now, "2026-12-18");
+    CHECK_NEAR(book.applyFill(call, "OPT", -8, 2.5, now, "2026-12-18"), 2.5, 1e-9);
+
+    const Position* call_position = book.find(call);
+    const Position* put_position = book.find(put);
+    CHECK(call_position && call_position->quantity == -3.0 && call_position->average_price == 2.5);
+    CHECK(put_position && put_position->quantity == -3.0 && put_position->average_price == 1.5);
+
+    // Underlying marks leave option positions alone
+    book.markPrice(id, 120.0);
+    CHECK(call_position && call_position->current_price == 2.5);
+}
+
+static void testTotalsDoNotDrift() {
+    PositionBook book;
+    auto now = std::chrono::system_clock::now();
+    ContractKey big = ContractKey::underlying(SymbolRegistry::instance().intern("DRIFT_BIG"));
+    ContractKey small = ContractKey::underlying(SymbolRegistry::instance().intern("DRIFT_SMALL"));
+    book.applyFill(big, "DRIFT_BIG", 1e6, 1000.0, now);
+    book.applyFill(small, "DRIFT_SMALL", 3, 0.1, now);
+
+    // Marks far apart in magnitude lose low bits on every add and subtract
+    for (int i = 0; i < 20000; i++) {
+        book.markPrice(big.symbol_id, 1000.0 + (i % 7) * 0.3);
+        book.markPrice(small.symbol_id, 0.1 + (i % 11) * 1e-3);
+    }
+    double unrealized = 0.0, exposure = 0.0;
+    for (const auto& position : book.positions()) {
+        unrealized += position.unrealized_pnl;
+        exposure += std::abs(position.current_price * position.quantity);
+    }
+    CHECK_NEAR(book.unrealizedPnl(), unrealized, 1e-6);
+    CHECK_NEAR(book.grossExposure(), exposure, 1e-6);
+
+    // A flat book reads exactly zero
+    book.close(big, 1001.0);
+    book.close(small, 0.2);
+    CHECK(book.size() == 0);
+    CHECK(book.unrealizedPnl() == 0.0);
+    CHECK(book.grossExposure() == 0.0);
+}
+
+int main() {
+    testLongToShortFlip();
+    testExactCloseRemovesPosition();
+    testOptionsFlipIndependently();
+    testTotalsDoNotDrift();
+    return TEST_RESULT("position_book");
+}
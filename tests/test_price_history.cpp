@@ -0,0 +1,48 @@
+#include "test_util.h"
+#include "price_history.h"
+#include <chrono>
+#include <memory>
+
+using hedgefund::algo::PriceSeries;
+
+static void testIntactUntilOverwritten() {
+    auto series = std::make_unique<PriceSeries>();
+    auto now = std::chrono::system_clock::now();
+    CHECK(!series->intact(0));
+
+    for (uint64_t i = 1; i <= PriceSeries::CAPACITY; i++) {
+        CHECK(series->append(100.0 + i, now) == i);
+    }
+    // A full ring still holds the first entry
+    CHECK(series->intact(1));
+    CHECK(series->price(1) == 101.0);
+
+    // The next append reuses entry 1's slot
+    series->append(500.0, now);
+    CHECK(!series->intact(1));
+    CHECK(series->intact(2));
+    CHECK(series->price(2) == 102.0);
+    CHECK(series->price(PriceSeries::CAPACITY + 1) == 500.0);
+}
+
+static void testReadThenValidate() {
+    auto series = std::make_unique<PriceSeries>();
+    auto now = std::chrono::system_clock::now();
+    for (int i = 0; i < 10; i++) series->append(i, now);
+
+    // A reader that took entries [5, 10] and was lapped while reading must reject them
+    uint64_t oldest = 5;
+    double sum = 0.0;
+    for (uint64_t s = oldest; s <= 10; s++) sum += series->price(s);
+    CHECK(series->intact(oldest));
+    CHECK(sum == 4 + 5 + 6 + 7 + 8 + 9);
+
+    for (size_t i = 0; i < PriceSeries::CAPACITY; i++) series->append(-1.0, now);
+    CHECK(!series->intact(oldest));
+}
+
+int main() {
+    testIntactUntilOverwritten();
+    testReadThenValidate();
+    return TEST_RESULT("price_history");
+}
@@ -0,0 +1,90 @@
+#include "test_util.h"
+#include "taylor_repricer.h"
+
+using namespace hedgefund::options;
+
+static OptionParams baseParams(double strike, bool is_call) {
+    OptionParams params;
+    params.spot_price = 100.0;
+    params.strike_price = strike;
+    params.time_to_expiry = 0.25;
+    params.risk_free_rate = 0.05;
+    params.volatility = 0.30;
+    params.is_call = is_call;
+    return params;
+}
+
+static void testAcceptedMovesStayWithinTheBound() {
+    const double max_error = 0.005;
+    TaylorRepricer repricer(max_error);
+    int accepted = 0;
+    double worst_excess = 0.0;
+    for (double strike : {90.0, 100.0, 110.0}) {
+        for (bool is_call : {true, false}) {
+            TaylorAnchor anchor = TaylorRepricer::makeAnchor(baseParams(strike, is_call));
+            for (double ds = -3.0; ds <= 3.0; ds += 0.5) {
+                for (double dv = -0.02; dv <= 0.02; dv += 0.005) {
+                    OptionParams moved = anchor.params;
+                    moved.spot_price += ds;
+                    moved.volatility += dv;
+                    moved.time_to_expiry -= 0.5 / 365.0;
+
+                    PricedContract result;
+                    if (!repricer.reprice(anchor, moved, result)) continue;
+                    accepted++;
+                    // The bound estimates the leading omitted terms, so allow it some headroom
+                    double error = std::fabs(result.price - BlackScholes::calculatePrice(moved));
+                    worst_excess = std::max(worst_excess, error - 2.0 * max_error);
+                }
+            }
+        }
+    }
+    CHECK(accepted > 100);
+    CHECK(worst_excess <= 0.0);
+}
+
+static void testErrorBoundGrowsWithTheMove() {
+    TaylorAnchor anchor = TaylorRepricer::makeAnchor(baseParams(100.0, true));
+    CHECK(TaylorRepricer::errorBound(anchor, 0.0, 0.0) == 0.0);
+    double small = TaylorRepricer::errorBound(anchor, 1.0, 0.01);
+    double large = TaylorRepricer::errorBound(anchor, 5.0, 0.05);
+    CHECK(small > 0.0);
+    CHECK(large > small);
+}
+
+static void testFallsBackOutsideTheBound() {
+    TaylorRepricer repricer(0.005, 1.0 / 365.0);
+    TaylorAnchor anchor = TaylorRepricer::makeAnchor(baseParams(100.0, true));
+    PricedContract result;
+
+    OptionParams far = anchor.params;
+    far.spot_price = 120.0;
+    CHECK(!repricer.reprice(anchor, far, result));
+
+    OptionParams stale = anchor.params;
+    stale.time_to_expiry -= 5.0 / 365.0;
+    CHECK(!repricer.reprice(anchor, stale, result));
+
+    OptionParams other_strike = anchor.params;
+    other_strike.strike_price = 105.0;
+    CHECK(!repricer.reprice(anchor, other_strike, result));
+
+    // update() re-anchors at the new point and prices it exactly
+    PricedContract full = repricer.update(anchor, far);
+    CHECK(repricer.getFullRevaluations() == 1);
+    CHECK_NEAR(full.price, BlackScholes::calculatePrice(far), 1e-12);
+    CHECK(anchor.params.spot_price == 120.0);
+
+    OptionParams nearby = far;
+    nearby.spot_price += 0.1;
+    PricedContract expanded = repricer.update(anchor, nearby);
+    CHECK(repricer.getTaylorUpdates() == 1);
+    CHECK_NEAR(expanded.price, BlackScholes::calculatePrice(nearby), 1e-4);
+}
+
+int main() {
+    testAcceptedMovesStayWithinTheBound();
+    testErrorBoundGrowsWithTheMove();
+    testFallsBackOutsideTheBound();
+    return TEST_RESULT("taylor_repricer");
+}
@@ -0,0 +1,103 @@
+#include "test_util.h"
+#include "common/tick_codec.h"
+#include <string>
+
+using namespace hedgefund::common;
+
+static std::string quote(const std::string& symbol, double price) {
+    std::string out;
+    QuoteFields fields;
+    fields.price = price;
+    fields.volume = 1000.0;
+    appendQuote(out, symbol, fields, 42);
+    return out;
+}
+
+static void testRoundTrip() {
+    std::string payload = quote("AAPL", 150.25);
+    OptionQuoteFields option;
+    option.strike_price = 155.0;
+    option.expiry = 20261218;
+    option.is_call = false;
+    appendOptionQuote(payload, "AAPL", option);
+
+    CHECK(isBinaryTick(payload));
+    TickReader reader(payload);
+    CHECK(reader.next());
+    CHECK(reader.kind() == TickKind::QUOTE);
+    CHECK(std::string(reader.symbol(), reader.symbolLength()) == "AAPL");
+    CHECK(reader.price() == 150.25);
+    CHECK(reader.timestamp() == 42);
+    CHECK(reader.next());
+    CHECK(reader.kind() == TickKind::OPTION_QUOTE);
+    CHECK(reader.expiry() == 20261218);
+    CHECK(!reader.isCall());
+    CHECK(!reader.next());
+    CHECK(!reader.malformed());
+}
+
+static void testEmptyPayload() {
+    TickReader reader(std::string{});
+    CHECK(!reader.next());
+    CHECK(!reader.malformed());
+    CHECK(!isBinaryTick(""));
+    CHECK(!isBinaryTick("MARKET_DATA,AAPL,150"));
+}
+
+static void expectMalformedAfter(const std::string& payload, int good_records) {
+    TickReader reader(payload);
+    for (int i = 0; i < good_records; i++) CHECK(reader.next());
+    CHECK(!reader.next());
+    CHECK(reader.malformed());
+    CHECK(!reader.next());  // Stays stopped
+}
+
+static void testMalformedInput() {
+    std::string good = quote("MSFT", 300.0);
+
+    expectMalformedAfter(good.substr(0, tick::HEADER_SIZE - 1), 0);  // Truncated header
+    expectMalformedAfter(good.substr(0, good.size() - 1), 0);        // Length past the end
+
+    std::string bad_version = good;
+    bad_version[1] = static_cast<char>(tick::VERSION + 1);
+    expectMalformedAfter(bad_version, 0);
+
+    std::string too_short = good;
+    uint32_t length = tick::HEADER_SIZE + 8;  // Shorter than a quote record
+    std::memcpy(&too_short[4], &length, sizeof(length));
+    expectMalformedAfter(too_short, 0);
+
+    std::string zero_length = good;
+    length = 0;
+    std::memcpy(&zero_length[4], &length, sizeof(length));
+    expectMalformedAfter(zero_length, 0);
+
+    // A good record followed by garbage yields the good one first
+    expectMalformedAfter(good + "garbage", 1);
+    std::string bad_magic = good + good;
+    bad_magic[good.size()] = 'X';
+    expectMalformedAfter(bad_magic, 1);
+}
+
+static void testLongSymbolTruncated() {
+    std::string payload = quote("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 1.0);
+    TickReader reader(payload);
+    CHECK(reader.next());
+    CHECK(reader.symbolLength() == tick::SYMBOL_SIZE);
+}
+
+static void testExpiryHelpers() {
+    CHECK(packExpiry("2026-12-18") == 20261218);
+    CHECK(packExpiry("2026-13-01") == 0);
+    CHECK(packExpiry("garbage") == 0);
+    CHECK(formatExpiry(20260105) == "2026-01-05");
+}
+
+int main() {
+    testRoundTrip();
+    testEmptyPayload();
+    testMalformedInput();
+    testLongSymbolTruncated();
+    testExpiryHelpers();
+    return TEST_RESULT("tick_codec");
+}
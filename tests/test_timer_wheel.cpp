@@ -0,0 +1,96 @@
+#include "test_util.h"
+#include "timer_wheel.h"
+#include <functional>
+#include <vector>
+
+using hedgefund::algo::TimerWheel;
+using namespace std::chrono;
+
+static void testFiresAfterFullRounds() {
+    auto start = TimerWheel::Clock::time_point{} + hours(1);
+    TimerWheel wheel(milliseconds(10), 8, start);  // One revolution is 80ms
+
+    std::vector<uint64_t> fired;
+    auto collect = [&fired](uint64_t payload) { fired.push_back(payload); };
+    wheel.schedule(start + milliseconds(30), 1);   // Same slot as 110ms and 190ms
+    wheel.schedule(start + milliseconds(110), 2);
+    wheel.schedule(start + milliseconds(190), 3);
+    CHECK(wheel.size() == 3);
+
+    wheel.advance(start + milliseconds(29), collect);
+    CHECK(fired.empty());
+    wheel.advance(start + milliseconds(30), collect);
+    CHECK(fired.size() == 1 && fired[0] == 1);
+
+    // One revolution later the second timer is due, not the third
+    wheel.advance(start + milliseconds(109), collect);
+    CHECK(fired.size() == 1);
+    wheel.advance(start + milliseconds(110), collect);
+    CHECK(fired.size() == 2 && fired[1] == 2);
+    wheel.advance(start + milliseconds(190), collect);
+    CHECK(fired.size() == 3 && fired[2] == 3);
+    CHECK(wheel.empty());
+}
+
+static void testPastDeadlineFiresOnNextAdvance() {
+    auto start = TimerWheel::Clock::time_point{} + hours(1);
+    TimerWheel wheel(milliseconds(10), 8, start);
+    int fired = 0;
+    wheel.advance(start + milliseconds(500), [&fired](uint64_t) { fired++; });
+    wheel.schedule(start, 9);
+    wheel.advance(start + milliseconds(510), [&fired](uint64_t payload) { fired += payload == 9; });
+    CHECK(fired == 1);
+}
+
+static void testCancel() {
+    auto start = TimerWheel::Clock::time_point{} + hours(1);
+    TimerWheel wheel(milliseconds(10), 8, start);
+
+    int fired = 0;
+    auto count = [&fired](uint64_t) { fired++; };
+    TimerWheel::TimerId cancelled = wheel.schedule(start + milliseconds(20), 1);
+    TimerWheel::TimerId kept = wheel.schedule(start + milliseconds(20), 2);
+    CHECK(wheel.cancel(cancelled));
+    CHECK(!wheel.cancel(cancelled));
+    CHECK(!wheel.cancel(TimerWheel::INVALID_TIMER));
+    CHECK(wheel.size() == 1);
+
+    wheel.advance(start + milliseconds(20), count);
+    CHECK(fired == 1);
+    CHECK(!wheel.cancel(kept));  // Already fired
+
+    // Ids of released entries stay dead after the entry is reused
+    TimerWheel::TimerId reused = wheel.schedule(start + milliseconds(40), 3);
+    CHECK(reused != cancelled && reused != kept);
+    CHECK(!wheel.cancel(cancelled));
+    CHECK(!wheel.cancel(kept));
+    CHECK(wheel.cancel(reused));
+    wheel.advance(start + milliseconds(100), count);
+    CHECK(fired == 1);
+    CHECK(wheel.empty());
+}
+
+static void testFireMayReschedule() {
+    auto start = TimerWheel::Clock::time_point{} + hours(1);
+    TimerWheel wheel(milliseconds(10), 8, start);
+
+    int fired = 0;
+    std::function<void(uint64_t)> fire;
+    fire = [&](uint64_t) {
+        fired++;
+        wheel.schedule(start, 1);  // Already due, but must wait for the next advance
+    };
+    wheel.schedule(start + milliseconds(10), 1);
+    wheel.advance(start + milliseconds(10), fire);
+    CHECK(fired == 1);
+    wheel.advance(start + milliseconds(20), fire);
+    CHECK(fired == 2);
+}
+
+int main() {
+    testFiresAfterFullRounds();
+    testPastDeadlineFiresOnNextAdvance();
+    testCancel();
+    testFireMayReschedule();
+    return TEST_RESULT("timer_wheel");
+}
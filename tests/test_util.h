@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+// Minimal assertions: failures are reported and counted, and TEST_RESULT()
+// turns the count into the process exit code
+namespace test {
+inline int& failures() {
+    static int count = 0;
+    return count;
+}
+} // namespace test
+
+#define CHECK(condition)                                                                     \
+    do {                                                                                     \
+        if (!(condition)) {                                                                  \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+            test::failures()++;                                                              \
+        }                                                                                    \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) CHECK(std::fabs((actual) - (expected)) <= (tolerance))
+
+#define TEST_RESULT(name)                                                          \
+    (test::failures() == 0 ? (std::cout << name << ": passed\n", 0)               \
+                           : (std::cerr << name << ": " << test::failures() << " failed\n", 1))
@@ -0,0 +1,93 @@
+#include "test_util.h"
+#include "work_stealing_pool.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using hedgefund::algo::InlineTask;
+using hedgefund::algo::WorkStealingPool;
+
+static bool waitFor(const std::atomic<int>& counter, int expected) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (counter.load() != expected) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+static void testInlineTaskOwnsItsCapture() {
+    auto tracked = std::make_shared<int>(0);
+    {
+        InlineTask task([tracked]() { (*tracked)++; });
+        CHECK(tracked.use_count() == 2);
+
+        InlineTask moved(std::move(task));
+        CHECK(!task);
+        CHECK(moved);
+        CHECK(tracked.use_count() == 2);
+        moved();
+        CHECK(*tracked == 1);
+
+        InlineTask assigned;
+        assigned = std::move(moved);
+        assigned();
+        CHECK(*tracked == 2);
+    }
+    CHECK(tracked.use_count() == 1);
+}
+
+static void testRunsEveryTask() {
+    std::atomic<int> done{0};
+    WorkStealingPool pool(4);
+    for (int i = 0; i < 100000; i++) {
+        pool.submit([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+    }
+    CHECK(waitFor(done, 100000));
+}
+
+static void testWakesIdleWorkers() {
+    // Workers go to sleep between bursts; each burst must still run
+    std::atomic<int> done{0};
+    WorkStealingPool pool(2);
+    for (int burst = 1; burst <= 20; burst++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        pool.submit([&done]() { done.fetch_add(1); });
+        CHECK(waitFor(done, burst));
+    }
+}
+
+static void testNestedSubmits() {
+    std::atomic<int> done{0};
+    WorkStealingPool pool(4);
+    for (int i = 0; i < 100; i++) {
+        pool.submit([&pool, &done]() {
+            for (int j = 0; j < 100; j++) pool.submit([&done]() { done.fetch_add(1); });
+        });
+    }
+    CHECK(waitFor(done, 10000));
+}
+
+static void testShutdownDrainsQueue() {
+    std::atomic<int> done{0};
+    {
+        WorkStealingPool pool(2);
+        for (int i = 0; i < 1000; i++) {
+            pool.submit([&done]() {
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+                done.fetch_add(1);
+            });
+        }
+    }
+    CHECK(done.load() == 1000);
+}
+
+int main() {
+    testInlineTaskOwnsItsCapture();
+    testRunsEveryTask();
+    testWakesIdleWorkers();
+    testNestedSubmits();
+    testShutdownDrainsQueue();
+    return TEST_RESULT("work_stealing_pool");
+}
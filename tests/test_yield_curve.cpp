@@ -0,0 +1,57 @@
+#include "test_util.h"
+#include "term_structure.h"
+#include <cmath>
+
+using namespace hedgefund::options;
+
+static void testFlatCurve() {
+    YieldCurve curve(0.04);
+    CHECK_NEAR(curve.zeroRate(0.1), 0.04, 1e-12);
+    CHECK_NEAR(curve.zeroRate(10.0), 0.04, 1e-12);
+    CHECK_NEAR(curve.discountFactor(2.0), std::exp(-0.08), 1e-12);
+    CHECK_NEAR(curve.forwardRate(1.0, 3.0), 0.04, 1e-12);
+}
+
+static void testInterpolatesLinearlyInRateTimesTime() {
+    // Pillars given out of order; the curve sorts them
+    YieldCurve curve({2.0, 0.5, 1.0}, {0.05, 0.03, 0.04});
+
+    CHECK_NEAR(curve.zeroRate(0.5), 0.03, 1e-12);
+    CHECK_NEAR(curve.zeroRate(1.0), 0.04, 1e-12);
+    CHECK_NEAR(curve.zeroRate(2.0), 0.05, 1e-12);
+
+    // Halfway between 1y and 2y: r*t = (0.04 + 0.10) / 2
+    CHECK_NEAR(curve.zeroRate(1.5) * 1.5, 0.07, 1e-12);
+    CHECK_NEAR(curve.discountFactor(1.5), std::exp(-0.07), 1e-12);
+
+    // Forwards are flat between pillars
+    CHECK_NEAR(curve.forwardRate(1.0, 2.0), 0.06, 1e-12);
+    CHECK_NEAR(curve.forwardRate(1.2, 1.7), 0.06, 1e-12);
+    CHECK_NEAR(curve.forwardRate(0.5, 1.0), 0.05, 1e-12);
+}
+
+static void testExtrapolatesFlat() {
+    YieldCurve curve({1.0, 5.0}, {0.02, 0.04});
+    CHECK_NEAR(curve.zeroRate(0.25), 0.02, 1e-12);
+    CHECK_NEAR(curve.zeroRate(0.0), 0.02, 1e-12);
+    CHECK_NEAR(curve.zeroRate(30.0), 0.04, 1e-12);
+    CHECK_NEAR(curve.discountFactor(0.0), 1.0, 1e-12);
+    CHECK_NEAR(curve.discountFactor(-1.0), 1.0, 1e-12);
+}
+
+static void testIgnoresBadPillars() {
+    YieldCurve curve({-1.0, 0.0, 1.0, 1.0}, {0.5, 0.5, 0.03, 0.09});
+    CHECK_NEAR(curve.zeroRate(1.0), 0.03, 1e-12);
+    CHECK_NEAR(curve.zeroRate(3.0), 0.03, 1e-12);
+
+    YieldCurve empty(std::vector<double>{}, std::vector<double>{});
+    CHECK_NEAR(empty.zeroRate(1.0), 0.0, 1e-12);
+}
+
+int main() {
+    testFlatCurve();
+    testInterpolatesLinearlyInRateTimesTime();
+    testExtrapolatesFlat();
+    testIgnoresBadPillars();
+    return TEST_RESULT("yield_curve");
+}